@@ -32,6 +32,9 @@ namespace Compiler {
         // 获取状态ID
         size_t getId() const;
 
+        // 设置状态ID（重新编号状态时使用）
+        void setId(size_t newId);
+
         // 是否为终结状态
         bool isFinalState() const;
 
@@ -62,12 +65,23 @@ namespace Compiler {
         // 状态优先级
     };
 
+    class DFA;
+
+    // 词法模式（起始条件）：初始模式之外的每个模式各有一个 DFA，令牌动作决定模式切换和是否丢弃令牌
+    struct LexerModes {
+        std::string initialName = "initial";                                   // 初始模式（导出的 DFA 本身）的名称
+        std::vector<std::pair<std::string, std::shared_ptr<DFA>>> others;      // 其余模式的名称与最小化后的 DFA
+        std::map<std::string, std::string> nextModes;                          // 词法单元名称 -> 匹配后进入的模式
+        std::set<std::string> skippedTokens;                                   // 匹配后丢弃的词法单元
+    };
+
     // DFA类
     class DFA {
     private:
         std::vector<std::shared_ptr<DFAState>> states;         // 所有状态
         std::shared_ptr<DFAState> startState;                  // 初始状态
         std::vector<std::shared_ptr<DFAState>> finalStates;    // 终结状态集合
+        bool cacheAlignedRows = false;                         // 导出时把转移表的行填充到缓存行边界（见 transitionRowStride）
 
         // 辅助函数：查找或创建等价状态
         std::shared_ptr<DFAState> findOrCreateState(const std::set<std::shared_ptr<NFAState>>& nfaStates);
@@ -75,13 +89,6 @@ namespace Compiler {
         // 辅助函数：划分等价类
         std::vector<std::set<std::shared_ptr<DFAState>>> partitionStates() const;
 
-        // 辅助函数：检查两个状态是否等价
-        bool areEquivalent(std::shared_ptr<DFAState> state1, std::shared_ptr<DFAState> state2,
-            const std::vector<std::set<std::shared_ptr<DFAState>>>& partition) const;
-
-        // 辅助函数：根据划分找到状态所在的子集编号
-        int findPartitionIndex(std::shared_ptr<DFAState> state,
-            const std::vector<std::set<std::shared_ptr<DFAState>>>& partition) const;
     public:
         DFA();
         ~DFA() = default;
@@ -107,12 +114,37 @@ namespace Compiler {
         // 最小化DFA
         void minimize();
 
-        // 生成DFA表
-        void generateTable(std::map<int, std::map<char, int>>& transitionTable,
-            std::map<int, std::string>& acceptStates) const;
+        // 规范状态顺序：从初始状态开始广度优先遍历，每个状态的转移按输入字节从小到大访问。
+        // 只取决于 DFA 的结构而与状态ID无关，剖析文件用它标识状态（运行时由表计算出相同的顺序）
+        std::vector<std::shared_ptr<DFAState>> canonicalOrder() const;
+
+        // 按剖析文件（见 include/DFAProfile.hpp）中的状态访问次数重新编号：访问最多的状态排在最前，
+        // 使热点行在转移表中连续；之后导出的转移表各行填充到缓存行边界：
+        // 不超过一个缓存行的行不跨越缓存行，更长的行从缓存行开头开始。剖析文件与本 DFA 不符时返回 false
+        bool reorderByProfile(const std::string& profileFile);
+
+        // 生成稠密DFA表: transitionTable[状态ID][输入字节] -> 目标状态ID (无转移为-1)
+        // acceptStates[状态ID] -> token名称 (非接受状态为空串)
+        void generateTable(std::vector<std::vector<int>>& transitionTable,
+            std::vector<std::string>& acceptStates) const;
+
+        // 计算输入字节等价类: 在所有状态下转移都相同的字节归为一类
+        // byteClass[输入字节] -> 等价类ID，返回等价类数量 (不被任何规则使用的字节固定为0类)
+        int computeByteClasses(const std::vector<std::vector<int>>& transitionTable,
+            std::vector<int>& byteClass) const;
 
         // 导出DFA表到头文件
-        bool exportToHeaderFile(const std::string& filePath) const;
+        // tokenNames 为按优先级从高到低排列的词法单元规则名称，用于生成词法单元种类枚举
+        // subNamespace 非空时表放在 Compiler::<subNamespace> 中，使多套规则生成的表可以同时包含
+        // 本 DFA 为初始模式，其表使用不带模式名的名称；modes 中其余模式的表以 DFA_<模式名>_ 为前缀，
+        // 另外输出模式枚举、每个模式的表描述以及按词法单元种类索引的动作表
+        bool exportToHeaderFile(const std::string& filePath, const std::vector<std::string>& tokenNames,
+            const std::string& subNamespace = "", const LexerModes& modes = LexerModes()) const;
+
+        // 导出直接编码（不查转移表）的最长匹配函数 matchDirectCoded
+        // 每个状态是一个标签，转移是对字节等价类的 switch；生成的头文件包含 tableHeaderName 以使用其中的等价类表
+        bool exportDirectCodedFile(const std::string& filePath, const std::string& tableHeaderName,
+            const std::string& subNamespace = "") const;
     };
 
 } // namespace Compiler
@@ -0,0 +1,56 @@
+#ifndef KEYWORD_HASH_HPP
+#define KEYWORD_HASH_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 关键字完美哈希表生成器
+    // 从关键字说明文件读取关键字列表，搜索一个无冲突的乘法哈希，
+    // 并导出带有"长度 + 首尾字符" switch 快速拒绝路径的查找函数
+    class KeywordHash {
+    private:
+        std::vector<std::string> keywords;      // 关键字（按说明文件中的顺序，即关键字ID的顺序）
+        std::vector<int> keyPositions;          // 参与哈希的字符下标（超出长度时取最后一个字符）
+        std::uint32_t multiplier;               // 哈希乘数
+        int tableBits;                          // 哈希表大小为 2^tableBits
+        std::vector<int> slots;                 // 哈希槽 -> 关键字下标（空槽为-1）
+
+        // 关键字在 KeywordId 中的枚举名（KW_ 加大写的关键字）
+        static std::string enumName(const std::string& keyword);
+
+        // 计算关键字在给定参与位置下的哈希键
+        std::uint32_t hashKey(const std::string& keyword) const;
+
+        // 计算哈希槽
+        std::uint32_t slotOf(const std::string& keyword) const;
+
+        // 选择能区分所有关键字的最少字符位置
+        bool choosePositions();
+
+        // 搜索无冲突的乘数
+        bool searchMultiplier();
+
+    public:
+        // KeywordId 以 std::uint8_t 输出，0 留给 NONE
+        static constexpr std::size_t MAX_KEYWORD_COUNT = 255;
+
+        KeywordHash();
+        ~KeywordHash() = default;
+
+        // 从文件加载关键字，每行一个，'#' 开头为注释
+        bool loadFromFile(const std::string& filePath);
+
+        // 构建完美哈希
+        bool build();
+
+        // 导出关键字表到头文件
+        bool exportToHeaderFile(const std::string& filePath) const;
+    };
+
+} // namespace Compiler
+
+#endif // KEYWORD_HASH_HPP
@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <bitset>
 #include "NFA.hpp"
 
 namespace Compiler {
@@ -24,6 +25,10 @@ namespace Compiler {
         std::map<std::string, std::string> regexrules;  // tokenName -> regex pattern
         std::map<std::string, std::shared_ptr<NFA>> nfa_map;  // 每个token对应的NFA
         std::map<std::string, int> tokenPriorities;  // token优先级映射
+        std::vector<std::string> modes;  // 词法模式（起始条件），按声明顺序排列，modes[0] 为初始模式
+        std::map<std::string, std::string> tokenModes;  // token -> 所属的词法模式
+        std::map<std::string, std::string> tokenNextModes;  // token -> 匹配后进入的模式（BEGIN 动作）
+        std::set<std::string> skippedTokens;  // 匹配后丢弃的token（skip 动作）
         // std::unordered_map<std::string, std::string> macros;
 
         // 辅助函数：解析正则表达式，将其转换为内部表示
@@ -35,6 +40,12 @@ namespace Compiler {
         // 判断字符是否为操作符
         bool isOperator(char c, char c_pre) const;
 
+        // 解析规则的动作列：skip 与 BEGIN(mode)
+        bool parseActions(const std::string& tokenName, const std::vector<std::string>& actions);
+
+        // 解析 regex[i]（'['）开始的字符类 [...] 或 [^...]，i 移到对应的 ']'
+        bool parseCharClass(const std::string& regex, size_t& i, std::bitset<256>& bytes) const;
+
         // 辅助函数：将中缀表达式转换为后缀表达式
         std::string infixToPostfix(const std::string& regex);
 
@@ -43,12 +54,16 @@ namespace Compiler {
 
         // 实现MYT算法的各个函数
         std::shared_ptr<NFA> createBasicNFA(char c);
+        std::shared_ptr<NFA> createCharSetNFA(const std::bitset<256>& bytes);
         std::shared_ptr<NFA> createConcatenation(std::shared_ptr<NFA> first, std::shared_ptr<NFA> second);
         std::shared_ptr<NFA> createUnion(std::shared_ptr<NFA> first, std::shared_ptr<NFA> second);
         std::shared_ptr<NFA> createKleeneClosure(std::shared_ptr<NFA> nfa);
         std::shared_ptr<NFA> createPositiveClosure(std::shared_ptr<NFA> nfa);
         // std::shared_ptr<NFA> createOptional(std::shared_ptr<NFA> nfa);
     public:
+        // 没有 %mode 声明的规则所属的初始模式
+        static constexpr const char* INITIAL_MODE = "initial";
+
         RegexEngine() = default;
         ~RegexEngine() = default;
 
@@ -58,8 +73,20 @@ namespace Compiler {
         // 获取已加载的规则列表
         const std::map<std::string, std::string>& getRules() const;
 
-        // 将所有规则合并成一个大的NFA
-        std::shared_ptr<NFA> buildCombinedNFA();
+        // 获取词法单元规则名称（不含优先级为0的宏定义），按优先级从高到低排列，同优先级按名称排列
+        std::vector<std::string> getTokenNames() const;
+
+        // 词法模式名称，按声明顺序排列，第一个为初始模式
+        const std::vector<std::string>& getModes() const;
+
+        // 词法单元匹配后进入的模式（没有 BEGIN 动作时不出现）
+        const std::map<std::string, std::string>& getNextModes() const;
+
+        // 匹配后丢弃、不返回给词法分析器调用者的词法单元
+        const std::set<std::string>& getSkippedTokens() const;
+
+        // 将 mode 模式中的所有规则合并成一个大的NFA
+        std::shared_ptr<NFA> buildCombinedNFA(const std::string& mode = INITIAL_MODE);
     };
 
 } // namespace Compiler
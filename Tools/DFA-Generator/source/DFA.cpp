@@ -5,9 +5,42 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cctype>
+#include <optional>
+#include <tuple>
 
 namespace Compiler {
 
+    // 将字节转换为可读形式，用于生成表的注释
+    static std::string describeByte(int byte) {
+        if (byte > ' ' && byte < 127 && byte != '\\') {
+            return std::string("'") + static_cast<char>(byte) + "'";
+        }
+        std::ostringstream oss;
+        oss << "0x" << std::hex << (byte < 16 ? "0" : "") << byte;
+        return oss.str();
+    }
+
+    // 将一组有序字节压缩为区间列表描述，如 '0'-'9' '_'
+    static std::string describeByteSet(const std::vector<int>& bytes) {
+        std::string result;
+        for (size_t i = 0; i < bytes.size();) {
+            size_t j = i;
+            while (j + 1 < bytes.size() && bytes[j + 1] == bytes[j] + 1) {
+                j++;
+            }
+            if (!result.empty()) {
+                result += " ";
+            }
+            result += describeByte(bytes[i]);
+            if (j > i) {
+                result += "-" + describeByte(bytes[j]);
+            }
+            i = j + 1;
+        }
+        return result;
+    }
+
     // DFAState实现
     DFAState::DFAState(size_t id, const std::set<std::shared_ptr<NFAState>>& nfaStates)
         : id(id), finalState(false), nfaStates(nfaStates), priority(0) {
@@ -28,6 +61,10 @@ namespace Compiler {
         return id;
     }
 
+    void DFAState::setId(size_t newId) {
+        id = newId;
+    }
+
     bool DFAState::isFinalState() const {
         return finalState;
     }
@@ -100,97 +137,205 @@ namespace Compiler {
         return finalStates;
     }
 
-    // 根据划分找到状态所在的子集编号
-    int DFA::findPartitionIndex(std::shared_ptr<DFAState> state,
-        const std::vector<std::set<std::shared_ptr<DFAState>>>& partition) const {
-        for (size_t i = 0; i < partition.size(); ++i) {
-            if (partition[i].find(state) != partition[i].end()) {
-                return static_cast<int>(i);
+    // 划分等价类（Hopcroft 算法，O(n·|Σ|·log n)）
+    // 缺失的转移视为转向一个隐含的死状态，死状态单独成组，因此“没有转移”与“转向某个非终结状态”不等价。
+    // 初始划分：非终结状态一组，终结状态按tokenName分组；之后用 (子集, 符号) 分割器的工作表细化：
+    // 取出一个分割器，沿逆转移找出经该符号进入子集的状态，把只有部分状态被找到的子集一分为二。
+    // 子集用连续区间表示在一个状态数组中，分割只需把被找到的状态交换到区间前部
+    std::vector<std::set<std::shared_ptr<DFAState>>> DFA::partitionStates() const {
+        const int stateCount = static_cast<int>(states.size());
+        const int sink = stateCount;                // 隐含的死状态
+        const int total = stateCount + 1;
+
+        std::map<std::shared_ptr<DFAState>, int> indexOf;
+        for (int i = 0; i < stateCount; ++i) {
+            indexOf[states[i]] = i;
+        }
+
+        // 所有输入符号
+        std::set<char> inputSymbols;
+        for (const std::shared_ptr<DFAState> &state : states) {
+            for (const std::pair<const char, std::shared_ptr<DFAState>> &trans : state->getTransitions()) {
+                inputSymbols.insert(trans.first);
             }
         }
-        return -1;  // 未找到
-    }
+        const std::vector<char> symbols(inputSymbols.begin(), inputSymbols.end());
+        const int symbolCount = static_cast<int>(symbols.size());
+        std::vector<int> symbolIndex(256, -1);
+        for (int a = 0; a < symbolCount; ++a) {
+            symbolIndex[static_cast<unsigned char>(symbols[a])] = a;
+        }
 
-    // 划分等价类
-    std::vector<std::set<std::shared_ptr<DFAState>>> DFA::partitionStates() const {
-        // 初始划分：非终结状态一组，终结状态按tokenName分组
-        std::set<std::shared_ptr<DFAState>> nonFinalSet;
-        std::map<std::string, std::set<std::shared_ptr<DFAState>>> finalSetsByToken;
+        // 逆转移：inverse[a * total + t] 为经符号 a 转向 t 的所有状态（压缩存储，offsets 为各列表的起点）
+        std::vector<int> inverseCount(static_cast<size_t>(symbolCount) * total + 1, 0);
+        std::vector<int> target(static_cast<size_t>(symbolCount) * total, sink);
+        for (int s = 0; s < stateCount; ++s) {
+            for (const std::pair<const char, std::shared_ptr<DFAState>> &trans : states[s]->getTransitions()) {
+                target[static_cast<size_t>(symbolIndex[static_cast<unsigned char>(trans.first)]) * total + s] = indexOf.at(trans.second);
+            }
+        }
+        for (int a = 0; a < symbolCount; ++a) {
+            for (int s = 0; s < total; ++s) {
+                ++inverseCount[static_cast<size_t>(a) * total + target[static_cast<size_t>(a) * total + s] + 1];
+            }
+        }
+        std::vector<int> inverseOffsets(inverseCount.size());
+        for (size_t i = 1; i < inverseCount.size(); ++i) {
+            inverseOffsets[i] = inverseOffsets[i - 1] + inverseCount[i];
+        }
+        std::vector<int> inverse(inverseOffsets.back());
+        std::vector<int> fill(inverseOffsets.begin(), inverseOffsets.end() - 1);
+        for (int a = 0; a < symbolCount; ++a) {
+            for (int s = 0; s < total; ++s) {
+                inverse[fill[static_cast<size_t>(a) * total + target[static_cast<size_t>(a) * total + s]]++] = s;
+            }
+        }
 
-        for (const std::shared_ptr<DFAState> &state : states) {
-            if (state->isFinalState()) {
-                // 终结状态按tokenName分组
-                std::string token = state->getTokenName();
-                finalSetsByToken[token].insert(state);
+        // 初始划分：非终结状态一组，终结状态按tokenName分组，死状态单独一组
+        std::vector<int> initialBlock(total);
+        std::map<std::string, int> blockOfToken;
+        int blockCount = 0;
+        int nonFinalBlock = -1;
+        for (int s = 0; s < stateCount; ++s) {
+            if (states[s]->isFinalState()) {
+                std::map<std::string, int>::iterator it = blockOfToken.find(states[s]->getTokenName());
+                if (it == blockOfToken.end()) {
+                    it = blockOfToken.emplace(states[s]->getTokenName(), blockCount++).first;
+                }
+                initialBlock[s] = it->second;
             }
             else {
-                nonFinalSet.insert(state);
+                if (nonFinalBlock < 0) {
+                    nonFinalBlock = blockCount++;
+                }
+                initialBlock[s] = nonFinalBlock;
             }
         }
+        initialBlock[sink] = blockCount++;
 
-        std::vector<std::set<std::shared_ptr<DFAState>>> partition;
-        // 先加入非终结状态组
-        if (!nonFinalSet.empty()) {
-            partition.push_back(nonFinalSet);
+        // 子集 b 为 elements[blockBegin[b], blockEnd[b])，position 为状态在 elements 中的下标
+        std::vector<int> elements(total), position(total), blockOf(total);
+        std::vector<int> blockBegin(blockCount, 0), blockEnd(blockCount, 0);
+        for (int s = 0; s < total; ++s) {
+            ++blockEnd[initialBlock[s]];
         }
-        // 再加入各个终结状态组（按tokenName分开）
-        for (const std::pair<const std::string, std::set<std::shared_ptr<DFAState>>> &entry : finalSetsByToken) {
-            if (!entry.second.empty()) {
-                partition.push_back(entry.second);
+        for (int b = 1; b < blockCount; ++b) {
+            blockBegin[b] = blockEnd[b - 1];
+            blockEnd[b] += blockBegin[b];
+        }
+        {
+            std::vector<int> next(blockBegin);
+            for (int s = 0; s < total; ++s) {
+                int b = initialBlock[s];
+                elements[next[b]] = s;
+                position[s] = next[b]++;
+                blockOf[s] = b;
             }
         }
 
-        // 所有输入符号
-        std::set<char> inputSymbols;
-        for (const auto &state : states) {
-            for (const auto &trans : state->getTransitions()) {
-                inputSymbols.insert(trans.first);
+        // 工作表：初始放入除最大子集外的所有 (子集, 符号)
+        std::vector<std::pair<int, int>> worklist;
+        int largest = 0;
+        for (int b = 1; b < blockCount; ++b) {
+            if (blockEnd[b] - blockBegin[b] > blockEnd[largest] - blockBegin[largest]) {
+                largest = b;
+            }
+        }
+        for (int b = 0; b < blockCount; ++b) {
+            if (b == largest) {
+                continue;
+            }
+            for (int a = 0; a < symbolCount; ++a) {
+                worklist.emplace_back(b, a);
             }
         }
 
-        // 迭代划分
-        bool changed = true;
-        while (changed) {
-            changed = false;
-            std::vector<std::set<std::shared_ptr<DFAState>>> newPartition;
-
-            // 对每个划分进行细化
-            for (const auto &part : partition) {
-                std::map<std::vector<int>, std::set<std::shared_ptr<DFAState>>> subsets;
-
-                // 对划分中的每个状态计算签名
-                for (const std::shared_ptr<DFAState> &state : part) {
-                    std::vector<int> signature;
-
-                    // 对每个输入符号，记录转移到哪个子集
-                    for (char symbol : inputSymbols) {
-                        auto it = state->getTransitions().find(symbol);
-                        if (it != state->getTransitions().end()) {
-                            // 找到转移，记录目标状态所在的划分编号
-                            std::shared_ptr<DFAState> targetState = it->second;
-                            int targetIndex = findPartitionIndex(targetState, partition);
-                            signature.push_back(targetIndex);
-                        }
-                        else {
-                            // 没有转移，使用-1表示
-                            signature.push_back(-1);
-                        }
-                    }
-                    // 根据签名将状态分组
-                    subsets[signature].insert(state);
+        std::vector<int> markedEnd(blockBegin);     // 子集中被找到的状态位于 [blockBegin, markedEnd)
+        std::vector<int> predecessors;
+        std::vector<int> touchedBlocks;
+        while (!worklist.empty()) {
+            auto [splitter, a] = worklist.back();
+            worklist.pop_back();
+
+            // 先收集前驱再标记，分割器本身也可能在本轮被分割
+            predecessors.clear();
+            for (int i = blockBegin[splitter]; i < blockEnd[splitter]; ++i) {
+                size_t key = static_cast<size_t>(a) * total + elements[i];
+                predecessors.insert(predecessors.end(), inverse.begin() + inverseOffsets[key], inverse.begin() + inverseOffsets[key + 1]);
+            }
+
+            // 把被找到的状态交换到所在子集的前部
+            touchedBlocks.clear();
+            for (int s : predecessors) {
+                int b = blockOf[s];
+                if (position[s] < markedEnd[b]) {
+                    continue;   // 已标记
+                }
+                if (markedEnd[b] == blockBegin[b]) {
+                    touchedBlocks.push_back(b);
+                }
+                int other = elements[markedEnd[b]];
+                std::swap(elements[position[s]], elements[markedEnd[b]]);
+                position[other] = position[s];
+                position[s] = markedEnd[b]++;
+            }
+
+            // 只有部分状态被标记的子集一分为二，较小的一半成为新子集
+            for (int b : touchedBlocks) {
+                int middle = markedEnd[b];
+                markedEnd[b] = blockBegin[b];
+                if (middle == blockEnd[b]) {
+                    continue;   // 全部被标记，无需分割
+                }
+
+                int newBlock = blockCount++;
+                if (middle - blockBegin[b] <= blockEnd[b] - middle) {
+                    blockBegin.push_back(blockBegin[b]);
+                    blockEnd.push_back(middle);
+                    blockBegin[b] = middle;
+                }
+                else {
+                    blockBegin.push_back(middle);
+                    blockEnd.push_back(blockEnd[b]);
+                    blockEnd[b] = middle;
                 }
-                if (subsets.size() > 1) {
-                    changed = true; // 划分被细化
+                markedEnd[b] = blockBegin[b];
+                markedEnd.push_back(blockBegin[newBlock]);
+                for (int i = blockBegin[newBlock]; i < blockEnd[newBlock]; ++i) {
+                    blockOf[elements[i]] = newBlock;
                 }
 
-                // 所有子集加入新的划分
-                for (const auto &entry : subsets) {
-                    newPartition.push_back(entry.second);
+                // 原子集已在工作表中的符号，新子集也要加入；否则只需加入较小的一半。
+                // 新子集总是较小的一半，两种情况都只需加入 (新子集, 符号)，无需记录分割器是否已在表中
+                for (int c = 0; c < symbolCount; ++c) {
+                    worklist.emplace_back(newBlock, c);
                 }
             }
-            partition = newPartition; // 更新划分
         }
 
+        // 按子集中最小的状态下标排列，使结果与 states 的顺序一致、可重复
+        std::vector<int> firstState(blockCount, stateCount);
+        for (int s = 0; s < stateCount; ++s) {
+            firstState[blockOf[s]] = std::min(firstState[blockOf[s]], s);
+        }
+        std::vector<int> order;
+        for (int b = 0; b < blockCount; ++b) {
+            if (firstState[b] < stateCount) {
+                order.push_back(b);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](int x, int y) { return firstState[x] < firstState[y]; });
+
+        std::vector<std::set<std::shared_ptr<DFAState>>> partition;
+        for (int b : order) {
+            std::set<std::shared_ptr<DFAState>> group;
+            for (int i = blockBegin[b]; i < blockEnd[b]; ++i) {
+                if (elements[i] != sink) {
+                    group.insert(states[elements[i]]);
+                }
+            }
+            partition.push_back(group);
+        }
         return partition;
     }
 
@@ -202,18 +347,6 @@ namespace Compiler {
     //     return nullptr; // 暂时返回空指针，后续需要实现
     // }
 
-    // 检查两个状态是否等价
-    bool DFA::areEquivalent(std::shared_ptr<DFAState> state1,
-        std::shared_ptr<DFAState> state2,
-        const std::vector<std::set<std::shared_ptr<DFAState>>>&partition) const {
-
-        // 首先检查是否在同一个划分中
-        int index1 = findPartitionIndex(state1, partition);
-        int index2 = findPartitionIndex(state2, partition);
-
-        return index1 != -1 && index1 == index2;
-    }
-
     // 最小化DFA
     void DFA::minimize() {
         if (states.empty()) {
@@ -311,26 +444,136 @@ namespace Compiler {
         std::cout << "DFA minimization completed!" << std::endl;
     }
 
-    void DFA::generateTable(std::map<int, std::map<char, int>>&transitionTable,
-        std::map<int, std::string>&acceptStates) const {
-        // 生成DFA表
-        transitionTable.clear();
-        acceptStates.clear();
+    std::vector<std::shared_ptr<DFAState>> DFA::canonicalOrder() const {
+        std::vector<std::shared_ptr<DFAState>> order;
+        if (!startState) {
+            return order;
+        }
+
+        std::vector<std::vector<int>> transitionTable;
+        std::vector<std::string> acceptStates;
+        generateTable(transitionTable, acceptStates);
+
+        std::vector<bool> visited(states.size(), false);
+        std::queue<int> pending;
+        pending.push(static_cast<int>(startState->getId()));
+        visited[startState->getId()] = true;
+        while (!pending.empty()) {
+            int stateId = pending.front();
+            pending.pop();
+            order.push_back(states[stateId]);
+            for (int symbol = 0; symbol < 256; ++symbol) {
+                int target = transitionTable[stateId][symbol];
+                if (target >= 0 && !visited[target]) {
+                    visited[target] = true;
+                    pending.push(target);
+                }
+            }
+        }
+
+        // 从初始状态不可达的状态（子集构造不会产生）按ID追加在末尾
+        for (const std::shared_ptr<DFAState>& state : states) {
+            if (!visited[state->getId()]) {
+                order.push_back(state);
+            }
+        }
+        return order;
+    }
+
+    bool DFA::reorderByProfile(const std::string& profileFile) {
+        std::ifstream inFile(profileFile);
+        if (!inFile.is_open()) {
+            std::cerr << "Error: Cannot open profile file " << profileFile << std::endl;
+            return false;
+        }
+
+        // 剖析文件按规范编号记录状态；转移计数供分析热点使用，重新编号只需要状态的访问次数
+        std::vector<std::shared_ptr<DFAState>> canonical = canonicalOrder();
+        std::vector<unsigned long long> visits(canonical.size(), 0);
+        bool sizeChecked = false;
+        std::string line;
+        while (std::getline(inFile, line)) {
+            std::istringstream iss(line);
+            std::string keyword;
+            if (!(iss >> keyword) || keyword[0] == '#') {
+                continue;
+            }
+            if (keyword == "dfa") {
+                size_t stateCount = 0;
+                iss >> stateCount;
+                if (stateCount != canonical.size()) {
+                    std::cerr << "Error: Profile " << profileFile << " was recorded on a DFA with " << stateCount
+                        << " states, but the rules produce " << canonical.size() << std::endl;
+                    return false;
+                }
+                sizeChecked = true;
+            }
+            else if (keyword == "state") {
+                size_t canonicalId = 0;
+                unsigned long long count = 0;
+                if (!(iss >> canonicalId >> count) || canonicalId >= canonical.size()) {
+                    std::cerr << "Error: Invalid profile line: " << line << std::endl;
+                    return false;
+                }
+                visits[canonicalId] = count;
+            }
+            else if (keyword != "transition") {
+                std::cerr << "Error: Invalid profile line: " << line << std::endl;
+                return false;
+            }
+        }
+        if (!sizeChecked) {
+            std::cerr << "Error: Profile " << profileFile << " has no dfa line" << std::endl;
+            return false;
+        }
+
+        // 按访问次数从多到少排列，次数相同（包括从未访问）的状态保持规范顺序
+        std::vector<size_t> order(canonical.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&visits](size_t a, size_t b) {
+            return visits[a] > visits[b];
+        });
+
+        unsigned long long totalVisits = 0;
+        for (unsigned long long count : visits) {
+            totalVisits += count;
+        }
+        size_t hotStates = 0;
+        unsigned long long covered = 0;
+        while (hotStates < order.size() && covered * 100 < totalVisits * 99) {
+            covered += visits[order[hotStates++]];
+        }
+
+        states.clear();
+        for (size_t newId = 0; newId < order.size(); ++newId) {
+            canonical[order[newId]]->setId(newId);
+            states.push_back(canonical[order[newId]]);
+        }
+        cacheAlignedRows = true;
+
+        std::cout << "Profile-guided state order: " << hotStates << " of " << states.size()
+            << " states cover 99% of " << totalVisits << " visits" << std::endl;
+        return true;
+    }
+
+    void DFA::generateTable(std::vector<std::vector<int>>&transitionTable,
+        std::vector<std::string>&acceptStates) const {
+        // 生成稠密DFA表，每个状态一行，每行256列对应所有输入字节
+        transitionTable.assign(states.size(), std::vector<int>(256, -1));
+        acceptStates.assign(states.size(), std::string());
 
         // 遍历所有状态
         for (const std::shared_ptr<DFAState> &state : states) {
             int stateId = static_cast<int>(state->getId());
 
             // 添加转移
-            std::map<char, int> stateTransitions;
             const std::map<char, std::shared_ptr<DFAState>> &transitions = state->getTransitions();
             for (const std::pair<const char, std::shared_ptr<DFAState>> &transition : transitions) {
-                char symbol = transition.first;
-                std::shared_ptr<DFAState> target = transition.second;
-                int targetId = static_cast<int>(target->getId());
-                stateTransitions[symbol] = targetId;
+                unsigned char symbol = static_cast<unsigned char>(transition.first);
+                transitionTable[stateId][symbol] = static_cast<int>(transition.second->getId());
             }
-            transitionTable[stateId] = stateTransitions;
 
             // 如果是终结状态，记录其接受的tokenName
             if (state->isFinalState()) {
@@ -339,7 +582,564 @@ namespace Compiler {
         }
     }
 
-    bool DFA::exportToHeaderFile(const std::string & filePath) const {
+    int DFA::computeByteClasses(const std::vector<std::vector<int>>&transitionTable,
+        std::vector<int>&byteClass) const {
+        byteClass.assign(256, 0);
+
+        // 每个字节的签名为其在所有状态下的目标状态列
+        std::map<std::vector<int>, int> signatureToClass;
+        std::vector<int> deadSignature(transitionTable.size(), -1);
+        int classCount = 0;
+
+        // 不被任何规则使用的字节(所有状态下都无转移)固定为0类
+        for (int symbol = 0; symbol < 256; ++symbol) {
+            bool used = false;
+            for (const std::vector<int> &row : transitionTable) {
+                if (row[symbol] != -1) {
+                    used = true;
+                    break;
+                }
+            }
+            if (!used) {
+                signatureToClass[deadSignature] = 0;
+                classCount = 1;
+                break;
+            }
+        }
+
+        for (int symbol = 0; symbol < 256; ++symbol) {
+            std::vector<int> signature;
+            signature.reserve(transitionTable.size());
+            for (const std::vector<int> &row : transitionTable) {
+                signature.push_back(row[symbol]);
+            }
+
+            auto it = signatureToClass.find(signature);
+            if (it == signatureToClass.end()) {
+                it = signatureToClass.emplace(signature, classCount++).first;
+            }
+            byteClass[symbol] = it->second;
+        }
+
+        return classCount;
+    }
+
+    // 由规则或模式名称生成常量名的大写部分，例如 "<comparison_double>" -> "COMPARISON_DOUBLE"
+    static std::string constantName(const std::string& name) {
+        std::string result;
+        for (char c : name) {
+            if (c == '<' || c == '>') {
+                continue;
+            }
+            result += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+        }
+        return result;
+    }
+
+    // 由词法单元名称生成枚举常量名，例如 "<comparison_double>" -> "DFA_TOKEN_COMPARISON_DOUBLE"
+    static std::string tokenKindName(const std::string& tokenName) {
+        return "DFA_TOKEN_" + constantName(tokenName);
+    }
+
+    // 写入接受状态表 <prefix>ACCEPT_KIND，返回接受状态数
+    static size_t writeAcceptKindTable(std::ostream& outFile, const std::string& prefix,
+        const std::vector<std::string>& acceptStates) {
+        size_t acceptCount = 0;
+        outFile << "// DFA accept states table: [state ID] -> token kind (DFA_TOKEN_NONE if not accepting)\n";
+        outFile << "constexpr DFATokenKind " << prefix << "ACCEPT_KIND[" << prefix << "STATE_COUNT] = {\n";
+        for (size_t stateId = 0; stateId < acceptStates.size(); ++stateId) {
+            if (acceptStates[stateId].empty()) {
+                outFile << "    DFA_TOKEN_NONE";
+            }
+            else {
+                outFile << "    " << tokenKindName(acceptStates[stateId]);
+                acceptCount++;
+            }
+            if (stateId + 1 != acceptStates.size()) {
+                outFile << ",";
+            }
+            outFile << " // state " << stateId << "\n";
+        }
+        outFile << "};\n\n";
+        return acceptCount;
+    }
+
+    // pshufb 一次查 16 个字节，shuffle DFA 最多支持 16 个状态
+    static constexpr size_t SHUFFLE_STATE_LIMIT = 16;
+
+    // 头文件保护宏：指定子命名空间时带上其名称，如 DFA_TABLES_PATHOLOGICAL_HPP
+    static std::string headerGuard(const std::string& base, const std::string& subNamespace) {
+        std::string guard = base;
+        if (!subNamespace.empty()) {
+            guard += '_';
+            for (char c : subNamespace) {
+                guard += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+            }
+        }
+        return guard + "_HPP";
+    }
+
+    // 生成代码所在的命名空间：Compiler 或 Compiler::<subNamespace>
+    static std::string headerNamespace(const std::string& subNamespace) {
+        return subNamespace.empty() ? "Compiler" : "Compiler::" + subNamespace;
+    }
+
+    // 写入字节到等价类的映射表 <prefix>CHAR_CLASS，注释中列出每个等价类包含的字节
+    static void writeCharClassTable(std::ostream& outFile, const std::string& prefix,
+        const std::vector<int>& byteClass, int classCount) {
+        outFile << "// Input byte -> equivalence class ID (bytes of one class behave identically in every state)\n";
+        for (int classId = 0; classId < classCount; ++classId) {
+            std::vector<int> members;
+            for (int symbol = 0; symbol < 256; ++symbol) {
+                if (byteClass[symbol] == classId) {
+                    members.push_back(symbol);
+                }
+            }
+            outFile << "//   class " << classId << ": " << describeByteSet(members) << "\n";
+        }
+        outFile << "constexpr std::uint8_t " << prefix << "CHAR_CLASS[256] = {\n";
+        for (int row = 0; row < 16; ++row) {
+            outFile << "    ";
+            for (int col = 0; col < 16; ++col) {
+                outFile << byteClass[row * 16 + col];
+                if (row * 16 + col != 255) {
+                    outFile << ",";
+                    if (col != 15) {
+                        outFile << " ";
+                    }
+                }
+            }
+            outFile << "\n";
+        }
+        outFile << "};\n\n";
+    }
+
+    // 缓存行大小，转移表按它对齐
+    static constexpr int CACHE_LINE_BYTES = 64;
+
+    // 转移表一行的元素个数：一般等于等价类数；要求对齐时把不超过一个缓存行的行填充到 2 的幂字节，
+    // 更长的行填充到缓存行的整数倍。表本身按缓存行对齐，因此短行不跨越缓存行，长行从缓存行开头开始、
+    // 占用的缓存行数最少
+    static int transitionRowStride(int classCount, int stateIdBytes, bool cacheAligned) {
+        int rowBytes = classCount * stateIdBytes;
+        if (!cacheAligned) {
+            return classCount;
+        }
+        if (rowBytes > CACHE_LINE_BYTES) {
+            int paddedBytes = (rowBytes + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+            return paddedBytes / stateIdBytes;
+        }
+        int paddedBytes = stateIdBytes;
+        while (paddedBytes < rowBytes) {
+            paddedBytes *= 2;
+        }
+        return paddedBytes / stateIdBytes;
+    }
+
+    // 写入按等价类压缩的转移表 <prefix>TRANSITION_TABLE，每行 rowStride 个元素，超出等价类数的部分填充死状态
+    static void writeTransitionTable(std::ostream& outFile, const std::string& prefix,
+        const std::vector<std::vector<int>>& transitionTable, const std::vector<int>& byteClass, int classCount,
+        int rowStride) {
+        outFile << "// DFA transition table: [current state ID][byte class] -> target state ID\n";
+        outFile << "alignas(" << CACHE_LINE_BYTES << ") constexpr DFAStateId " << prefix << "TRANSITION_TABLE["
+            << prefix << "STATE_COUNT][" << prefix << "ROW_STRIDE] = {\n";
+
+        for (size_t stateId = 0; stateId < transitionTable.size(); ++stateId) {
+            // 每个等价类取一个代表字节查表
+            outFile << "    { ";
+            for (int classId = 0; classId < classCount; ++classId) {
+                int representative = static_cast<int>(std::find(byteClass.begin(), byteClass.end(), classId) - byteClass.begin());
+                outFile << transitionTable[stateId][representative];
+                if (classId + 1 != rowStride) {
+                    outFile << ", ";
+                }
+            }
+            for (int padding = classCount; padding < rowStride; ++padding) {
+                outFile << "-1" << (padding + 1 != rowStride ? ", " : "");
+            }
+            outFile << " }";
+            if (stateId + 1 != transitionTable.size()) {
+                outFile << ",";
+            }
+            outFile << " // state " << stateId << "\n";
+        }
+        outFile << "};\n\n";
+    }
+
+    // 加速表一项最多记录的出口字节数（与运行时 scanToAnyByte 的上限一致）
+    static constexpr size_t ACCEL_BYTE_LIMIT = 3;
+
+    // 写入加速表 <prefix>ACCEL：状态在除少数"出口"字节之外的所有字节上都转移回自身时，
+    // 记录 { 出口字节数, 出口字节... }，运行时可向量化地直接跳到下一个出口字节；其余状态为 { 0 }
+    static size_t writeAccelerationTable(std::ostream& outFile, const std::string& prefix,
+        const std::vector<std::vector<int>>& transitionTable) {
+        size_t acceleratedCount = 0;
+        outFile << "// DFA acceleration table: [state ID] -> { escape byte count, escape bytes... } for states that loop back\n";
+        outFile << "// to themselves on every other byte (the run up to the next escape byte can be skipped at once); { 0 } otherwise\n";
+        outFile << "constexpr std::uint8_t " << prefix << "ACCEL[" << prefix << "STATE_COUNT][4] = {\n";
+        for (size_t stateId = 0; stateId < transitionTable.size(); ++stateId) {
+            std::vector<int> escapes;
+            for (int symbol = 0; symbol < 256; ++symbol) {
+                if (transitionTable[stateId][symbol] != static_cast<int>(stateId)) {
+                    escapes.push_back(symbol);
+                }
+            }
+            bool accelerated = !escapes.empty() && escapes.size() <= ACCEL_BYTE_LIMIT;
+            outFile << "    { ";
+            if (accelerated) {
+                outFile << escapes.size();
+                for (int escape : escapes) {
+                    outFile << ", " << escape;
+                }
+                acceleratedCount++;
+            }
+            else {
+                outFile << "0";
+            }
+            outFile << " }" << (stateId + 1 == transitionTable.size() ? "" : ",") << " // state " << stateId;
+            if (accelerated) {
+                outFile << ": escapes " << describeByteSet(escapes);
+            }
+            outFile << "\n";
+        }
+        outFile << "};\n\n";
+        return acceleratedCount;
+    }
+
+    // 终结符候选的搜索范围：穷举的输入串数与输入长度上限
+    static constexpr size_t TERMINATOR_SEARCH_BUDGET = size_t(1) << 20;
+    static constexpr size_t TERMINATOR_SEARCH_MAX_LENGTH = 24;
+
+    // 等价性判定中抽象配置数的上限，超过时放弃推导，模式照常查表分析
+    static constexpr size_t TERMINATOR_CONFIG_LIMIT = size_t(1) << 16;
+
+    // 模式的终结符：在该模式中分析等价于丢弃输入直到 text 第一次出现（含 text），然后进入 nextMode
+    struct ModeTerminator {
+        std::string text;
+        std::string nextMode;
+        size_t configCount = 0;     // 判定等价时遍历的抽象配置数
+    };
+
+    // 在模式中分析一段输入的结果
+    enum class ModeRunOutcome {
+        EXIT,   // 遇到离开模式的令牌
+        END,    // 输入全部由丢弃的令牌组成，到结尾仍在模式中
+        STUCK   // 匹配失败或得到不丢弃的令牌
+    };
+
+    // 在模式的稠密表上模拟词法分析 input（字节序列，其结尾即输入结尾）：逐个做带回退的最长匹配，
+    // 离开模式时 exitEnd 为该令牌的结尾
+    static ModeRunOutcome simulateMode(const std::vector<std::vector<int>>& transitionTable,
+        const std::vector<std::string>& acceptStates, int start, const LexerModes& modes,
+        const std::vector<int>& input, size_t& exitEnd) {
+        size_t pos = 0;
+        while (pos < input.size()) {
+            int state = start;
+            int lastAccept = -1;
+            size_t lastEnd = pos;
+            for (size_t i = pos; i < input.size(); ++i) {
+                state = transitionTable[state][input[i]];
+                if (state < 0) {
+                    break;
+                }
+                if (!acceptStates[state].empty()) {
+                    lastAccept = state;
+                    lastEnd = i + 1;
+                }
+            }
+            if (lastAccept < 0 || modes.skippedTokens.count(acceptStates[lastAccept]) == 0) {
+                return ModeRunOutcome::STUCK;
+            }
+            if (modes.nextModes.count(acceptStates[lastAccept]) != 0) {
+                exitEnd = lastEnd;
+                return ModeRunOutcome::EXIT;
+            }
+            pos = lastEnd;
+        }
+        return ModeRunOutcome::END;
+    }
+
+    // 判定"在模式中做带回退的最长匹配"与"查找终结符 T"是否对所有输入给出相同结果。
+    // 最长匹配的状态是无限的（回退时要重新分析上次接受之后读过的字节），这里把它抽象为有限的配置：
+    // 当前 DFA 状态、当前令牌最近一次接受的种类、该接受位置上 T 的 KMP 状态，以及一个影子配置——
+    // 假设令牌在最近一次接受处结束、从那里重新开始分析已读字节得到的配置。令牌死亡时回退等价于改用影子配置，
+    // 因此读入一个字节只需同时推进配置与影子配置。T 的 KMP 状态多出两个值："刚好第一次出现"与"出现过"；
+    // 离开模式的位置上 KMP 状态恰为前者时才与查找 T 一致。配置按结构驻留，从初始配置出发遍历
+    // （配置, 当前 KMP 状态）的所有可达组合并检查每一个的结果，遍历结束即证明等价；配置数超过上限时放弃
+    class ModeTerminatorChecker {
+    private:
+        // 令牌最近一次接受的种类
+        enum Accepted { ACCEPTED_NONE, ACCEPTED_SKIP, ACCEPTED_EXIT };
+
+        // 一个抽象配置；shadow 只在 ACCEPTED_SKIP 时有效，kmpAtAccept 只在 ACCEPTED_EXIT 时有效
+        struct Config {
+            int state;
+            Accepted accepted;
+            int kmpAtAccept;
+            int shadow;
+            bool empty;     // 令牌还没有读入任何字节
+
+            std::tuple<int, int, int, int, bool> key() const {
+                return { state, accepted, kmpAtAccept, shadow, empty };
+            }
+        };
+
+        // 两个吸收配置：已按 T 正确离开模式，或结果与查找 T 不同（匹配失败、在别处离开模式）
+        static constexpr int EXITED = 0;
+        static constexpr int FAILED = 1;
+
+        // 输入结束时的结果
+        enum class Outcome { EXITED, FAILED, END };
+
+        const std::vector<std::vector<int>>& transitionTable_;
+        const std::vector<std::string>& acceptStates_;
+        const LexerModes& modes_;
+        const std::vector<int>& representatives_;
+        std::vector<int> terminator_;       // T 的等价类序列
+        std::vector<int> failure_;          // KMP 失配函数
+        int found_;                         // KMP 状态：T 刚好第一次出现
+        int seen_;                          // KMP 状态：T 已经出现过
+
+        std::vector<Config> configs_;
+        std::map<std::tuple<int, int, int, int, bool>, int> ids_;
+        std::map<std::tuple<int, int, int>, int> feedMemo_;
+        int fresh_;                         // 令牌开头的配置
+        bool overflow_ = false;
+
+        int intern(const Config& config) {
+            auto [it, inserted] = ids_.emplace(config.key(), static_cast<int>(configs_.size()));
+            if (inserted) {
+                configs_.push_back(config);
+                overflow_ = overflow_ || configs_.size() > TERMINATOR_CONFIG_LIMIT;
+            }
+            return it->second;
+        }
+
+        int kmpNext(int kmp, int classId) const {
+            if (kmp >= found_) {
+                return seen_;
+            }
+            while (kmp > 0 && terminator_[kmp] != classId) {
+                kmp = failure_[kmp - 1];
+            }
+            return terminator_[kmp] == classId ? kmp + 1 : 0;
+        }
+
+        // 配置 id 读入等价类为 classId 的字节，kmp 为读入之后的 KMP 状态
+        int feed(int id, int classId, int kmp) {
+            if (id == EXITED || id == FAILED || overflow_) {
+                return id;
+            }
+            auto memo = feedMemo_.find({ id, classId, kmp });
+            if (memo != feedMemo_.end()) {
+                return memo->second;
+            }
+
+            Config config = configs_[id];
+            int next = transitionTable_[config.state][representatives_[classId]];
+            int result;
+            if (next >= 0 && !acceptStates_[next].empty()) {
+                // 令牌在此接受，回退点前移：影子配置从这里重新开始
+                Accepted accepted = modes_.nextModes.count(acceptStates_[next]) != 0 ? ACCEPTED_EXIT : ACCEPTED_SKIP;
+                result = intern(Config{ next, accepted, accepted == ACCEPTED_EXIT ? kmp : 0,
+                    accepted == ACCEPTED_SKIP ? fresh_ : -1, false });
+            }
+            else if (next >= 0) {
+                int shadow = config.accepted == ACCEPTED_SKIP ? feed(config.shadow, classId, kmp) : -1;
+                result = intern(Config{ next, config.accepted, config.kmpAtAccept, shadow, false });
+            }
+            else if (config.accepted == ACCEPTED_NONE) {
+                result = FAILED;
+            }
+            else if (config.accepted == ACCEPTED_EXIT) {
+                result = config.kmpAtAccept == found_ ? EXITED : FAILED;
+            }
+            else {
+                // 令牌在最近一次接受处结束，回退后的分析就是影子配置再读入本字节
+                result = feed(config.shadow, classId, kmp);
+            }
+            feedMemo_.emplace(std::make_tuple(id, classId, kmp), result);
+            return result;
+        }
+
+        Outcome finish(int id) const {
+            if (id == EXITED || id == FAILED) {
+                return id == EXITED ? Outcome::EXITED : Outcome::FAILED;
+            }
+            const Config& config = configs_[id];
+            switch (config.accepted) {
+            case ACCEPTED_NONE:
+                return config.empty ? Outcome::END : Outcome::FAILED;
+            case ACCEPTED_EXIT:
+                return config.kmpAtAccept == found_ ? Outcome::EXITED : Outcome::FAILED;
+            default:
+                return finish(config.shadow);
+            }
+        }
+
+    public:
+        ModeTerminatorChecker(const std::vector<std::vector<int>>& transitionTable, const std::vector<std::string>& acceptStates,
+            int start, const LexerModes& modes, const std::vector<int>& representatives, const std::vector<int>& terminator)
+            : transitionTable_(transitionTable), acceptStates_(acceptStates), modes_(modes), representatives_(representatives),
+              terminator_(terminator), failure_(terminator.size(), 0),
+              found_(static_cast<int>(terminator.size())), seen_(static_cast<int>(terminator.size()) + 1) {
+            for (size_t i = 1, length = 0; i < terminator_.size(); ++i) {
+                while (length > 0 && terminator_[i] != terminator_[length]) {
+                    length = failure_[length - 1];
+                }
+                if (terminator_[i] == terminator_[length]) {
+                    length++;
+                }
+                failure_[i] = static_cast<int>(length);
+            }
+            configs_.resize(2);     // EXITED 与 FAILED
+            fresh_ = intern(Config{ start, ACCEPTED_NONE, 0, -1, true });
+        }
+
+        // 遍历所有可达的（配置, KMP 状态）组合，全部与查找 T 一致时返回 true
+        bool equivalent() {
+            int classCount = static_cast<int>(representatives_.size());
+            std::set<std::pair<int, int>> visited{ { fresh_, 0 } };
+            std::queue<std::pair<int, int>> pending;
+            pending.push({ fresh_, 0 });
+            while (!pending.empty()) {
+                auto [id, kmp] = pending.front();
+                pending.pop();
+
+                // 输入在此结束：要么已按 T 离开模式，要么 T 没有出现且仍在模式中
+                Outcome outcome = finish(id);
+                if (outcome == Outcome::FAILED || (outcome == Outcome::END && kmp >= found_)) {
+                    return false;
+                }
+                if (id == EXITED) {
+                    continue;
+                }
+
+                for (int classId = 0; classId < classCount; ++classId) {
+                    int nextKmp = kmpNext(kmp, classId);
+                    int next = feed(id, classId, nextKmp);
+                    if (overflow_ || next == FAILED) {
+                        return false;
+                    }
+                    if (visited.insert({ next, nextKmp }).second) {
+                        pending.push({ next, nextKmp });
+                    }
+                }
+            }
+            return true;
+        }
+
+        size_t configCount() const { return configs_.size() - 2; }
+    };
+
+    // 推导模式的终结符（如注释模式的 "*/"）。要求：模式中的令牌都被丢弃，离开模式的令牌都进入同一个模式，
+    // 且存在一个字节串 T，使得模式中的分析恰好在 T 第一次出现之后离开模式、T 不出现时一直停留到输入结尾。
+    // T 取模拟分析恰好在结尾离开模式的最短输入，其每个字节必须独占一个等价类；之后由 ModeTerminatorChecker
+    // 对所有输入精确判定等价。满足时运行时可以直接查找 T 代替查表
+    static bool deriveModeTerminator(const std::vector<std::vector<int>>& transitionTable,
+        const std::vector<std::string>& acceptStates, int start, const std::string& modeName, const LexerModes& modes,
+        const std::vector<int>& byteClass, int classCount, ModeTerminator& terminator) {
+        std::set<std::string> targets;
+        for (const std::string& tokenName : acceptStates) {
+            if (tokenName.empty()) {
+                continue;
+            }
+            if (modes.skippedTokens.count(tokenName) == 0) {
+                return false;
+            }
+            auto next = modes.nextModes.find(tokenName);
+            if (next != modes.nextModes.end()) {
+                targets.insert(next->second);
+            }
+        }
+        if (targets.size() != 1 || *targets.begin() == modeName || classCount <= 0) {
+            return false;
+        }
+
+        std::vector<int> representatives(classCount, -1);
+        std::vector<int> classSizes(classCount, 0);
+        for (int symbol = 0; symbol < 256; ++symbol) {
+            if (representatives[byteClass[symbol]] < 0) {
+                representatives[byteClass[symbol]] = symbol;
+            }
+            classSizes[byteClass[symbol]]++;
+        }
+
+        // 搜索上限：长度不超过 maxLength 的输入总数不超过预算
+        size_t maxLength = 0;
+        for (size_t count = 1, total = 0;
+            maxLength < TERMINATOR_SEARCH_MAX_LENGTH && total + count * classCount <= TERMINATOR_SEARCH_BUDGET;) {
+            count *= classCount;
+            total += count;
+            maxLength++;
+        }
+
+        // 按长度从小到大穷举输入，取第一个恰好在结尾离开模式的输入作为候选 T
+        std::vector<int> terminatorClasses;
+        for (size_t length = 1; length <= maxLength && terminatorClasses.empty(); ++length) {
+            std::vector<int> classes(length, 0);
+            std::vector<int> input(length, representatives[0]);
+            while (true) {
+                size_t exitEnd = 0;
+                if (simulateMode(transitionTable, acceptStates, start, modes, input, exitEnd) == ModeRunOutcome::EXIT
+                    && exitEnd == input.size()) {
+                    terminatorClasses = classes;
+                    break;
+                }
+                size_t digit = 0;
+                while (digit < length && ++classes[digit] == classCount) {
+                    classes[digit] = 0;
+                    input[digit] = representatives[0];
+                    digit++;
+                }
+                if (digit == length) {
+                    break;
+                }
+                input[digit] = representatives[classes[digit]];
+            }
+        }
+        if (terminatorClasses.empty()) {
+            return false;
+        }
+        std::string text;
+        for (int classId : terminatorClasses) {
+            if (classSizes[classId] != 1) {
+                return false;
+            }
+            text += static_cast<char>(representatives[classId]);
+        }
+
+        ModeTerminatorChecker checker(transitionTable, acceptStates, start, modes, representatives, terminatorClasses);
+        if (!checker.equivalent()) {
+            return false;
+        }
+
+        terminator = ModeTerminator{ text, *targets.begin(), checker.configCount() };
+        return true;
+    }
+
+    // 字节串的 C++ 字符串字面量，不可打印字节用八进制转义
+    static std::string cppStringLiteral(const std::string& text) {
+        std::ostringstream oss;
+        oss << '"';
+        for (char c : text) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            if (byte == '"' || byte == '\\') {
+                oss << '\\' << c;
+            }
+            else if (byte >= ' ' && byte < 127) {
+                oss << c;
+            }
+            else {
+                oss << '\\' << std::oct << static_cast<int>(byte) / 64 << static_cast<int>(byte) / 8 % 8 << static_cast<int>(byte) % 8 << std::dec;
+            }
+        }
+        oss << '"';
+        return oss.str();
+    }
+
+    bool DFA::exportToHeaderFile(const std::string & filePath, const std::vector<std::string>& tokenNames,
+        const std::string& subNamespace, const LexerModes& modes) const {
         // 导出DFA表到头文件
         std::ofstream outFile(filePath);
         if (!outFile.is_open()) {
@@ -348,16 +1148,33 @@ namespace Compiler {
         }
 
         // 生成DFA表
-        std::map<int, std::map<char, int>> transitionTable;
-        std::map<int, std::string> acceptStates;
+        std::vector<std::vector<int>> transitionTable;
+        std::vector<std::string> acceptStates;
         generateTable(transitionTable, acceptStates);
 
+        // 按状态数选择最小的状态ID存储类型，使表尽量紧凑；所有模式的表共用一种类型
+        size_t maxStates = states.size();
+        for (const auto& [modeName, modeDFA] : modes.others) {
+            maxStates = std::max(maxStates, modeDFA->getAllStates().size());
+        }
+        std::string stateIdType = "std::int32_t";
+        int stateIdBytes = 4;
+        if (maxStates <= 127) {
+            stateIdType = "std::int8_t";
+            stateIdBytes = 1;
+        }
+        else if (maxStates <= 32767) {
+            stateIdType = "std::int16_t";
+            stateIdBytes = 2;
+        }
+
         // 写入头文件保护宏
-        outFile << "#ifndef DFA_TABLES_HPP\n";
-        outFile << "#define DFA_TABLES_HPP\n\n";
-        outFile << "#include <map>\n";
-        outFile << "#include <string>\n\n";
-        outFile << "namespace Compiler {\n\n";
+        std::string guard = headerGuard("DFA_TABLES", subNamespace);
+        std::string nameSpace = headerNamespace(subNamespace);
+        outFile << "#ifndef " << guard << "\n";
+        outFile << "#define " << guard << "\n\n";
+        outFile << "#include <cstdint>\n\n";
+        outFile << "namespace " << nameSpace << " {\n\n";
 
         // 写入起始状态
         outFile << "// DFA start state ID\n";
@@ -367,90 +1184,363 @@ namespace Compiler {
         outFile << "// DFA states count\n";
         outFile << "constexpr int DFA_STATE_COUNT = " << states.size() << ";\n\n";
 
-        // 写入转移表
-        outFile << "// DFA transition table: [current state ID][input symbol] -> target state ID\n";
-        outFile << "const std::map<int, std::map<char, int>> DFA_TRANSITION_TABLE = {\n";
+        // 写入死状态哨兵
+        outFile << "// Dead state sentinel: no transition on the input byte\n";
+        outFile << "constexpr int DFA_DEAD_STATE = -1;\n\n";
 
-        bool firstState = true;
-        for (const std::pair<const int, std::map<char, int>> &stateEntry : transitionTable) {
-            if (!firstState) {
-                outFile << ",\n";
-            }
-            firstState = false;
+        // 写入状态ID类型
+        outFile << "// Storage type of a state ID in the transition table\n";
+        outFile << "using DFAStateId = " << stateIdType << ";\n\n";
 
-            int stateId = stateEntry.first;
-            const std::map<char, int> &transitions = stateEntry.second;
+        // 计算输入字节等价类，转移表按等价类压缩
+        std::vector<int> byteClass;
+        int classCount = computeByteClasses(transitionTable, byteClass);
 
-            outFile << "    {" << stateId << ", {\n";
+        // 写入等价类数量
+        outFile << "// Number of input byte equivalence classes\n";
+        outFile << "constexpr int DFA_CLASS_COUNT = " << classCount << ";\n\n";
 
-            bool firstTrans = true;
-            for (const std::pair<const char, int> &trans : transitions) {
-                if (!firstTrans) {
-                    outFile << ",\n";
-                }
-                firstTrans = false;
+        // 写入转移表每行的元素个数
+        int rowStride = transitionRowStride(classCount, stateIdBytes, cacheAlignedRows);
+        outFile << "// Entries per transition table row (DFA_CLASS_COUNT, or more when rows are padded to cache line boundaries)\n";
+        outFile << "constexpr int DFA_ROW_STRIDE = " << rowStride << ";\n\n";
 
-                char symbol = trans.first;
-                int targetId = trans.second;
+        // 写入字节到等价类的映射
+        writeCharClassTable(outFile, "DFA_", byteClass, classCount);
 
-                // 处理特殊字符
-                if (symbol == '\n') {
-                    outFile << "        {'\\n', " << targetId << "}";
-                }
-                else if (symbol == '\t') {
-                    outFile << "        {'\\t', " << targetId << "}";
-                }
-                else if (symbol == '\r') {
-                    outFile << "        {'\\r', " << targetId << "}";
-                }
-                else if (symbol == '\\') {
-                    outFile << "        {'\\\\', " << targetId << "}";
-                }
-                else if (symbol == '\'') {
-                    outFile << "        {'\\'', " << targetId << "}";
-                }
-                else if (symbol == '\"') {
-                    outFile << "        {'\\\"', " << targetId << "}";
-                }
-                else if (isprint(symbol)) {
-                    outFile << "        {'" << symbol << "', " << targetId << "}";
-                }
-                else {
-                    // 不可打印字符用十六进制表示
-                    outFile << "        {'\\x" << std::hex << static_cast<int>(static_cast<unsigned char>(symbol)) << "', " << std::dec << targetId << "}";
+        // 写入转移表
+        writeTransitionTable(outFile, "DFA_", transitionTable, byteClass, classCount, rowStride);
+
+        // 其余模式的稠密表与等价类
+        std::vector<std::vector<std::vector<int>>> modeTransitionTables(modes.others.size());
+        std::vector<std::vector<std::string>> modeAcceptStates(modes.others.size());
+        for (size_t mode = 0; mode < modes.others.size(); ++mode) {
+            modes.others[mode].second->generateTable(modeTransitionTables[mode], modeAcceptStates[mode]);
+        }
+
+        // 词法单元种类按优先级排列，接受状态中出现但不在列表中的名称追加在末尾；所有模式共用一套种类
+        std::vector<std::string> kinds = tokenNames;
+        std::vector<const std::vector<std::string>*> allAcceptStates = { &acceptStates };
+        for (const std::vector<std::string>& modeAccepts : modeAcceptStates) {
+            allAcceptStates.push_back(&modeAccepts);
+        }
+        for (const std::vector<std::string>* modeAccepts : allAcceptStates) {
+            for (const std::string& tokenName : *modeAccepts) {
+                if (!tokenName.empty() && std::find(kinds.begin(), kinds.end(), tokenName) == kinds.end()) {
+                    kinds.push_back(tokenName);
                 }
             }
-            outFile << "\n    }}";
+        }
+
+        // 写入词法单元种类枚举，超过 255 种规则时使用 16 位存储
+        outFile << "// Token kinds: one per rule in priority order (highest first), DFA_TOKEN_NONE for non-accepting states\n";
+        outFile << "enum DFATokenKind : " << (kinds.size() + 1 <= 256 ? "std::uint8_t" : "std::uint16_t") << " {\n";
+        outFile << "    DFA_TOKEN_NONE = 0,\n";
+        for (size_t kind = 0; kind < kinds.size(); ++kind) {
+            outFile << "    " << tokenKindName(kinds[kind]) << " = " << (kind + 1)
+                << (kind + 1 == kinds.size() ? "" : ",") << " // " << kinds[kind] << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入种类数量和名称
+        outFile << "// Token kinds count (including DFA_TOKEN_NONE)\n";
+        outFile << "constexpr int DFA_TOKEN_KIND_COUNT = " << (kinds.size() + 1) << ";\n\n";
+        outFile << "// Token kind -> rule name (for diagnostics)\n";
+        outFile << "constexpr const char* DFA_TOKEN_NAMES[DFA_TOKEN_KIND_COUNT] = {\n";
+        outFile << "    nullptr";
+        for (const std::string& kind : kinds) {
+            outFile << ",\n    \"" << kind << "\"";
         }
         outFile << "\n};\n\n";
 
         // 写入接受状态表
-        outFile << "// DFA accept states table: [state ID] -> Token name\n";
-        outFile << "const std::map<int, std::string> DFA_ACCEPT_STATES = {\n";
-
-        bool firstAccept = true;
-        for (const std::pair<const int, std::string> &entry : acceptStates) {
-            if (!firstAccept) {
-                outFile << ",\n";
+        size_t acceptCount = writeAcceptKindTable(outFile, "DFA_", acceptStates);
+
+        // 写入加速表
+        size_t acceleratedCount = writeAccelerationTable(outFile, "DFA_", transitionTable);
+
+        // 写入 pshufb 转移表：每个等价类一个 16 字节向量，第 s 个字节为状态 s 的目标状态。
+        // 一条 pshufb 即可推进状态，因此要求状态数不超过 16；超过时只输出全为死状态的占位表
+        bool shuffleAvailable = states.size() <= SHUFFLE_STATE_LIMIT;
+        std::uint32_t acceptMask = 0;
+        for (size_t stateId = 0; shuffleAvailable && stateId < acceptStates.size(); ++stateId) {
+            if (!acceptStates[stateId].empty()) {
+                acceptMask |= 1u << stateId;
+            }
+        }
+        outFile << "// Shuffle DFA (pshufb): lane s of DFA_SHUFFLE_TABLE[byte class] is the target state of state s,\n";
+        outFile << "// DFA_SHUFFLE_DEAD if there is no transition. Only usable when DFA_SHUFFLE_AVAILABLE (at most 16 states).\n";
+        outFile << "constexpr bool DFA_SHUFFLE_AVAILABLE = " << (shuffleAvailable ? "true" : "false") << ";\n";
+        outFile << "constexpr std::uint8_t DFA_SHUFFLE_DEAD = 0x80;\n";
+        outFile << "constexpr std::uint16_t DFA_SHUFFLE_ACCEPT_MASK = 0x" << std::hex << acceptMask << std::dec << ";\n";
+        outFile << "alignas(16) constexpr std::uint8_t DFA_SHUFFLE_TABLE[DFA_CLASS_COUNT][16] = {\n";
+        for (int classId = 0; classId < classCount; ++classId) {
+            int representative = static_cast<int>(std::find(byteClass.begin(), byteClass.end(), classId) - byteClass.begin());
+            outFile << "    { ";
+            for (size_t lane = 0; lane < SHUFFLE_STATE_LIMIT; ++lane) {
+                int target = shuffleAvailable && lane < transitionTable.size() ? transitionTable[lane][representative] : -1;
+                if (target < 0) {
+                    outFile << "0x80";
+                }
+                else {
+                    outFile << target;
+                }
+                if (lane + 1 != SHUFFLE_STATE_LIMIT) {
+                    outFile << ", ";
+                }
+            }
+            outFile << " }";
+            if (classId + 1 != classCount) {
+                outFile << ",";
+            }
+            outFile << " // class " << classId << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入其余模式的表，名称带模式前缀，如 DFA_COMMENT_TRANSITION_TABLE；同时推导各模式的终结符
+        std::vector<std::string> modeNames = { modes.initialName };
+        std::vector<std::optional<ModeTerminator>> modeTerminators(modes.others.size() + 1);
+        for (size_t mode = 0; mode < modes.others.size(); ++mode) {
+            const auto& [modeName, modeDFA] = modes.others[mode];
+            std::string prefix = "DFA_" + constantName(modeName) + "_";
+            std::vector<int> modeByteClass;
+            int modeClassCount = computeByteClasses(modeTransitionTables[mode], modeByteClass);
+            std::shared_ptr<DFAState> modeStart = modeDFA->getStartState();
+
+            outFile << "// ---- Lexer mode " << modeName << " ----\n\n";
+            outFile << "constexpr int " << prefix << "START_STATE = " << (modeStart ? static_cast<int>(modeStart->getId()) : 0) << ";\n";
+            outFile << "constexpr int " << prefix << "STATE_COUNT = " << modeTransitionTables[mode].size() << ";\n";
+            outFile << "constexpr int " << prefix << "CLASS_COUNT = " << modeClassCount << ";\n";
+            int modeRowStride = transitionRowStride(modeClassCount, stateIdBytes, modeDFA->cacheAlignedRows);
+            outFile << "constexpr int " << prefix << "ROW_STRIDE = " << modeRowStride << ";\n\n";
+            writeCharClassTable(outFile, prefix, modeByteClass, modeClassCount);
+            writeTransitionTable(outFile, prefix, modeTransitionTables[mode], modeByteClass, modeClassCount, modeRowStride);
+            writeAcceptKindTable(outFile, prefix, modeAcceptStates[mode]);
+            size_t modeAccelerated = writeAccelerationTable(outFile, prefix, modeTransitionTables[mode]);
+            modeNames.push_back(modeName);
+
+            std::cout << "Mode " << modeName << ": " << modeTransitionTables[mode].size() << " states, "
+                << modeClassCount << " byte classes, " << modeAccelerated << " accelerated states" << std::endl;
+
+            ModeTerminator terminator;
+            if (modeStart && deriveModeTerminator(modeTransitionTables[mode], modeAcceptStates[mode],
+                static_cast<int>(modeStart->getId()), modeName, modes, modeByteClass, modeClassCount, terminator)) {
+                std::cout << "Mode " << modeName << ": terminator " << cppStringLiteral(terminator.text)
+                    << " -> " << terminator.nextMode << std::endl;
+                modeTerminators[mode + 1] = terminator;
             }
-            firstAccept = false;
+        }
 
-            int stateId = entry.first;
-            const std::string &tokenName = entry.second;
-            outFile << "    {" << stateId << ", \"" << tokenName << "\"}";
+        // 写入模式枚举与名称
+        outFile << "// Lexer modes (start conditions); mode 0 is the initial mode and uses the unprefixed tables\n";
+        outFile << "enum DFAMode : std::uint8_t {\n";
+        for (size_t mode = 0; mode < modeNames.size(); ++mode) {
+            outFile << "    DFA_MODE_" << constantName(modeNames[mode]) << " = " << mode
+                << (mode + 1 == modeNames.size() ? "" : ",") << "\n";
         }
-        outFile << "\n};\n\n";
+        outFile << "};\n\n";
+        outFile << "constexpr int DFA_MODE_COUNT = " << modeNames.size() << ";\n\n";
+        outFile << "// Mode -> name (for diagnostics)\n";
+        outFile << "constexpr const char* DFA_MODE_NAMES[DFA_MODE_COUNT] = {\n";
+        for (size_t mode = 0; mode < modeNames.size(); ++mode) {
+            outFile << "    \"" << modeNames[mode] << "\"" << (mode + 1 == modeNames.size() ? "" : ",") << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入每个模式的表描述，转移表按行展开为一维
+        outFile << "// Tables of one lexer mode: transitions[state * rowStride + charClass[byte]] -> target state ID\n";
+        outFile << "struct DFAModeTable {\n";
+        outFile << "    int start;\n";
+        outFile << "    int stateCount;\n";
+        outFile << "    int classCount;\n";
+        outFile << "    int rowStride;\n";
+        outFile << "    const std::uint8_t* charClass;\n";
+        outFile << "    const DFAStateId* transitions;\n";
+        outFile << "    const DFATokenKind* acceptKind;\n";
+        outFile << "    const std::uint8_t* accel; // [state * 4], see DFA_ACCEL\n";
+        outFile << "};\n\n";
+        outFile << "constexpr DFAModeTable DFA_MODE_TABLES[DFA_MODE_COUNT] = {\n";
+        for (size_t mode = 0; mode < modeNames.size(); ++mode) {
+            std::string prefix = mode == 0 ? "DFA_" : "DFA_" + constantName(modeNames[mode]) + "_";
+            outFile << "    { " << prefix << "START_STATE, " << prefix << "STATE_COUNT, " << prefix << "CLASS_COUNT, " << prefix << "ROW_STRIDE, "
+                << prefix << "CHAR_CLASS, " << prefix << "TRANSITION_TABLE[0], " << prefix << "ACCEPT_KIND, " << prefix << "ACCEL[0] }"
+                << (mode + 1 == modeNames.size() ? "" : ",") << " // " << modeNames[mode] << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入令牌动作表：匹配后进入的模式与是否丢弃
+        outFile << "// Token kind -> mode entered after the token (BEGIN action), DFA_MODE_KEEP to stay in the current mode\n";
+        outFile << "constexpr std::int8_t DFA_MODE_KEEP = -1;\n";
+        outFile << "constexpr std::int8_t DFA_TOKEN_NEXT_MODE[DFA_TOKEN_KIND_COUNT] = {\n";
+        outFile << "    DFA_MODE_KEEP" << (kinds.empty() ? "" : ",") << " // DFA_TOKEN_NONE\n";
+        for (size_t kind = 0; kind < kinds.size(); ++kind) {
+            auto next = modes.nextModes.find(kinds[kind]);
+            outFile << "    " << (next == modes.nextModes.end() ? "DFA_MODE_KEEP" : "DFA_MODE_" + constantName(next->second))
+                << (kind + 1 == kinds.size() ? "" : ",") << " // " << kinds[kind] << "\n";
+        }
+        outFile << "};\n\n";
+        outFile << "// Token kind -> dropped instead of returned to the caller (skip action)\n";
+        outFile << "constexpr bool DFA_TOKEN_SKIP[DFA_TOKEN_KIND_COUNT] = {\n";
+        outFile << "    false" << (kinds.empty() ? "" : ",") << " // DFA_TOKEN_NONE\n";
+        for (size_t kind = 0; kind < kinds.size(); ++kind) {
+            outFile << "    " << (modes.skippedTokens.count(kinds[kind]) ? "true" : "false")
+                << (kind + 1 == kinds.size() ? "" : ",") << " // " << kinds[kind] << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入各模式的终结符，没有终结符的模式查表分析
+        outFile << "// Mode -> terminator derived from the rules: lexing in the mode is equivalent to skipping the input up to and\n";
+        outFile << "// including the first occurrence of text, then entering nextMode (proved by the generator for all inputs, over\n";
+        outFile << "// the noted number of abstract lexer configurations). length is 0 for modes lexed with their tables\n";
+        outFile << "struct DFAModeTerminator {\n";
+        outFile << "    const char* text;\n";
+        outFile << "    int length;\n";
+        outFile << "    std::int8_t nextMode;\n";
+        outFile << "};\n\n";
+        outFile << "constexpr DFAModeTerminator DFA_MODE_TERMINATORS[DFA_MODE_COUNT] = {\n";
+        for (size_t mode = 0; mode < modeNames.size(); ++mode) {
+            const std::optional<ModeTerminator>& terminator = modeTerminators[mode];
+            outFile << "    ";
+            if (terminator) {
+                outFile << "{ " << cppStringLiteral(terminator->text) << ", " << terminator->text.size()
+                    << ", DFA_MODE_" << constantName(terminator->nextMode) << " }";
+            }
+            else {
+                outFile << "{ nullptr, 0, DFA_MODE_KEEP }";
+            }
+            outFile << (mode + 1 == modeNames.size() ? "" : ",") << " // " << modeNames[mode];
+            if (terminator) {
+                outFile << " (proved over " << terminator->configCount << " lexer configurations)";
+            }
+            outFile << "\n";
+        }
+        outFile << "};\n\n";
 
         // 结束命名空间和头文件保护
-        outFile << "} // namespace Compiler\n\n";
-        outFile << "#endif // DFA_TABLES_HPP\n";
+        outFile << "} // namespace " << nameSpace << "\n\n";
+        outFile << "#endif // " << guard << "\n";
 
         outFile.close();
 
         std::cout << "DFA tables exported to " << filePath << std::endl;
         std::cout << "Total states: " << states.size() << std::endl;
-        std::cout << "Accept states: " << acceptStates.size() << std::endl;
+        std::cout << "Accept states: " << acceptCount << std::endl;
+        std::cout << "Byte classes: " << classCount << std::endl;
+        std::cout << "Accelerated states: " << acceleratedCount << std::endl;
+
+        return true;
+    }
+
+    bool DFA::exportDirectCodedFile(const std::string& filePath, const std::string& tableHeaderName,
+        const std::string& subNamespace) const {
+        std::ofstream outFile(filePath);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Cannot open file " << filePath << " for writing" << std::endl;
+            return false;
+        }
+
+        // 与表头文件使用同一套转移表和字节等价类，状态ID也保持一致
+        std::vector<std::vector<int>> transitionTable;
+        std::vector<std::string> acceptStates;
+        generateTable(transitionTable, acceptStates);
+        std::vector<int> byteClass;
+        int classCount = computeByteClasses(transitionTable, byteClass);
+
+        std::string guard = headerGuard("DFA_DIRECT_CODED", subNamespace);
+        std::string nameSpace = headerNamespace(subNamespace);
+        outFile << "#ifndef " << guard << "\n";
+        outFile << "#define " << guard << "\n\n";
+        outFile << "#include <cstddef>\n";
+        outFile << "#include <string_view>\n";
+        outFile << "#include \"" << tableHeaderName << "\"\n\n";
+        outFile << "namespace " << nameSpace << " {\n\n";
+
+        int start = startState ? static_cast<int>(startState->getId()) : 0;
+        outFile << "// Direct-coded longest match starting at input[start]: every DFA state is a label and\n";
+        outFile << "// transitions are a switch on the byte class, so no transition table is loaded.\n";
+        outFile << "// Returns the last accepting state ID (DFA_DEAD_STATE if none) and stores the end of that match in end.\n";
+        outFile << "inline int matchDirectCoded(std::string_view input, std::size_t start, std::size_t& end) {\n";
+        outFile << "    const unsigned char* const data = reinterpret_cast<const unsigned char*>(input.data());\n";
+        outFile << "    const unsigned char* const limit = data + input.size();\n";
+        outFile << "    const unsigned char* p = data + start;\n";
+        outFile << "    const unsigned char* acceptEnd = p;\n";
+        outFile << "    int acceptState = DFA_DEAD_STATE;\n";
+
+        // 状态块按ID顺序输出。省略的只有两处跳转：起始状态为 0 时入口直接落入第一块，最后一块没有转移时直接落入 done；
+        // switch 中的转移即使目标是下一块也输出 goto。只输出被跳转到的标号，以免未使用的标号产生警告
+        std::vector<bool> labelUsed(transitionTable.size(), false);
+        for (const std::vector<int>& row : transitionTable) {
+            for (int target : row) {
+                if (target >= 0) {
+                    labelUsed[target] = true;
+                }
+            }
+        }
+        if (start != 0) {
+            outFile << "    goto state_" << start << ";\n";
+            labelUsed[start] = true;
+        }
+
+        for (size_t stateId = 0; stateId < transitionTable.size(); ++stateId) {
+            if (labelUsed[stateId]) {
+                outFile << "\nstate_" << stateId << ":\n";
+            }
+            else {
+                outFile << "\n";
+            }
+            if (!acceptStates[stateId].empty()) {
+                outFile << "    acceptState = " << stateId << "; // " << acceptStates[stateId] << "\n";
+                outFile << "    acceptEnd = p;\n";
+            }
+
+            // 按目标状态合并等价类，同一目标的类共用一个分支
+            std::vector<std::pair<int, std::vector<int>>> targets;
+            for (int classId = 0; classId < classCount; ++classId) {
+                int representative = static_cast<int>(std::find(byteClass.begin(), byteClass.end(), classId) - byteClass.begin());
+                int target = transitionTable[stateId][representative];
+                if (target < 0) {
+                    continue;
+                }
+                auto it = std::find_if(targets.begin(), targets.end(),
+                    [target](const std::pair<int, std::vector<int>>& entry) { return entry.first == target; });
+                if (it == targets.end()) {
+                    targets.push_back({ target, { classId } });
+                }
+                else {
+                    it->second.push_back(classId);
+                }
+            }
+
+            if (targets.empty()) {
+                if (stateId + 1 < transitionTable.size()) {
+                    outFile << "    goto done;\n";
+                }
+                continue;
+            }
+            outFile << "    if (p == limit) goto done;\n";
+            outFile << "    switch (DFA_CHAR_CLASS[*p]) {\n";
+            for (const auto& [target, classes] : targets) {
+                for (int classId : classes) {
+                    outFile << "    case " << classId << ":\n";
+                }
+                outFile << "        ++p;\n";
+                outFile << "        goto state_" << target << ";\n";
+            }
+            outFile << "    default:\n";
+            outFile << "        goto done;\n";
+            outFile << "    }\n";
+        }
+
+        outFile << "\ndone:\n";
+        outFile << "    end = static_cast<std::size_t>(acceptEnd - data);\n";
+        outFile << "    return acceptState;\n";
+        outFile << "}\n\n";
+        outFile << "} // namespace " << nameSpace << "\n\n";
+        outFile << "#endif // " << guard << "\n";
+
+        outFile.close();
 
+        std::cout << "Direct-coded DFA exported to " << filePath << std::endl;
         return true;
     }
 
@@ -1,19 +1,69 @@
 #include "RegexEngine.hpp"
 #include "NFA.hpp"
 #include "DFA.hpp"
+#include "KeywordHash.hpp"
 #include <iostream>
 #include <string>
 #include <memory>
+#include <streambuf>
+
+// 丢弃写入内容的输出缓冲区
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return traits_type::not_eof(c); }
+};
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        std::cout << "Usage: " << argv[0] << " <rules_file> <output_header_file>" << std::endl;
+        std::cout << "Usage: " << argv[0] << " <rules_file> <output_header_file>"
+            << " [--keywords <keywords_file> <keyword_header_file>] [--namespace <name>]"
+            << " [--direct <direct_coded_header_file>] [--profile <dfa_profile_file>] [--quiet]" << std::endl;
         return 1;
     }
 
     std::string rulesFile = argv[1];
     std::string outputFile = argv[2];
 
+    // 可选：关键字说明文件及其完美哈希表头文件
+    std::string keywordsFile;
+    std::string keywordOutputFile;
+    // 可选：表所在的子命名空间
+    std::string subNamespace;
+    // 可选：直接编码词法分析函数的头文件
+    std::string directOutputFile;
+    // 可选：词法分析器记录的 DFA 剖析文件，按其中的访问次数重新编号初始模式的状态
+    std::string profileFile;
+    // 可选：不输出规则加载与自动机构造过程（构建时生成表用），错误仍输出到 std::cerr
+    bool quiet = false;
+    for (int i = 3; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--keywords" && i + 2 < argc) {
+            keywordsFile = argv[++i];
+            keywordOutputFile = argv[++i];
+        }
+        else if (option == "--namespace" && i + 1 < argc) {
+            subNamespace = argv[++i];
+        }
+        else if (option == "--direct" && i + 1 < argc) {
+            directOutputFile = argv[++i];
+        }
+        else if (option == "--profile" && i + 1 < argc) {
+            profileFile = argv[++i];
+        }
+        else if (option == "--quiet") {
+            quiet = true;
+        }
+        else {
+            std::cerr << "Error: Unknown or incomplete option: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    // 安静模式下丢弃标准输出；缓冲区为静态对象，程序退出时刷新 std::cout 仍然有效
+    static NullBuffer nullBuffer;
+    if (quiet) {
+        std::cout.rdbuf(&nullBuffer);
+    }
+
     // 创建正则表达式引擎
     Compiler::RegexEngine regexEngine;
 
@@ -23,30 +73,74 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // 构建NFA
-    std::shared_ptr<Compiler::NFA> nfa = regexEngine.buildCombinedNFA();
-    if (!nfa) {
-        std::cerr << "Error: Failed to build NFA" << std::endl;
-        return 1;
-    }
+    // 每个词法模式分别构建NFA、转换为DFA并最小化，第一个模式为初始模式
+    std::shared_ptr<Compiler::DFA> dfa;
+    Compiler::LexerModes modes;
+    for (const std::string& mode : regexEngine.getModes()) {
+        // 构建NFA
+        std::shared_ptr<Compiler::NFA> nfa = regexEngine.buildCombinedNFA(mode);
+        if (!nfa) {
+            std::cerr << "Error: Failed to build NFA for mode " << mode << std::endl;
+            return 1;
+        }
 
-    // 将NFA转换为DFA
-    std::shared_ptr<Compiler::DFA> dfa = nfa->toDFA();
-    if (!dfa) {
-        std::cerr << "Error: Failed to convert NFA to DFA" << std::endl;
+        // 将NFA转换为DFA
+        std::shared_ptr<Compiler::DFA> modeDFA = nfa->toDFA();
+        if (!modeDFA) {
+            std::cerr << "Error: Failed to convert NFA to DFA for mode " << mode << std::endl;
+            return 1;
+        }
+
+        // 最小化DFA
+        modeDFA->minimize();
+
+        if (!dfa) {
+            dfa = modeDFA;
+            modes.initialName = mode;
+        }
+        else {
+            modes.others.push_back({ mode, modeDFA });
+        }
+    }
+    // 按剖析结果重新编号初始模式的状态，使热点行在转移表中连续
+    if (!profileFile.empty() && !dfa->reorderByProfile(profileFile)) {
+        std::cerr << "Error: Failed to apply DFA profile: " << profileFile << std::endl;
         return 1;
     }
 
-    // 最小化DFA
-    dfa->minimize();
+    modes.nextModes = regexEngine.getNextModes();
+    modes.skippedTokens = regexEngine.getSkippedTokens();
 
     // 导出DFA表到头文件
-    if (!dfa->exportToHeaderFile(outputFile)) {
+    if (!dfa->exportToHeaderFile(outputFile, regexEngine.getTokenNames(), subNamespace, modes)) {
         std::cerr << "Error: Failed to export DFA to header file: " << outputFile << std::endl;
         return 1;
     }
 
     std::cout << "DFA has been successfully generated and exported to: " << outputFile << std::endl;
 
+    // 导出直接编码的词法分析函数，它通过文件名包含表头文件
+    if (!directOutputFile.empty()) {
+        std::string tableHeaderName = outputFile.substr(outputFile.find_last_of("/\\") + 1);
+        if (!dfa->exportDirectCodedFile(directOutputFile, tableHeaderName, subNamespace)) {
+            std::cerr << "Error: Failed to export direct-coded DFA to header file: " << directOutputFile << std::endl;
+            return 1;
+        }
+    }
+
+    // 生成关键字完美哈希表
+    if (!keywordsFile.empty()) {
+        Compiler::KeywordHash keywordHash;
+        if (!keywordHash.loadFromFile(keywordsFile) || !keywordHash.build()) {
+            std::cerr << "Error: Failed to build keyword table from file: " << keywordsFile << std::endl;
+            return 1;
+        }
+        if (!keywordHash.exportToHeaderFile(keywordOutputFile)) {
+            std::cerr << "Error: Failed to export keyword table to header file: " << keywordOutputFile << std::endl;
+            return 1;
+        }
+        std::cout << "Keyword table has been successfully generated and exported to: " << keywordOutputFile << std::endl;
+    }
+
     return 0;
 }
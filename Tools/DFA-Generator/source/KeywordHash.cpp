@@ -0,0 +1,308 @@
+#include "KeywordHash.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
+
+namespace Compiler {
+
+    // 生成代码与本文件中的哈希计算必须保持一致
+    static const std::uint32_t HASH_BASE = 31;
+
+    KeywordHash::KeywordHash()
+        : multiplier(0), tableBits(0) {}
+
+    bool KeywordHash::loadFromFile(const std::string& filePath) {
+        // 格式：每行一个关键字，'#' 开头的行和空行被忽略
+        std::ifstream file(filePath);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file " << filePath << std::endl;
+            return false;
+        }
+
+        std::set<std::string> seen;
+        std::map<std::string, std::string> enumNames;  // 枚举名 -> 关键字，大小写不同的关键字会得到同一个枚举名
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::string keyword;
+            if (!(iss >> keyword) || keyword[0] == '#') {
+                continue;
+            }
+
+            // 关键字只能由字母、数字和下划线组成，保证能够作为枚举名和字符字面量输出
+            for (char c : keyword) {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+                    std::cerr << "Error: Invalid keyword: " << keyword << std::endl;
+                    return false;
+                }
+            }
+            if (!seen.insert(keyword).second) {
+                std::cerr << "Error: Duplicate keyword: " << keyword << std::endl;
+                return false;
+            }
+            auto [existing, inserted] = enumNames.emplace(enumName(keyword), keyword);
+            if (!inserted) {
+                std::cerr << "Error: Keywords " << existing->second << " and " << keyword
+                    << " both map to KeywordId::" << existing->first << std::endl;
+                return false;
+            }
+            if (keywords.size() == MAX_KEYWORD_COUNT) {
+                std::cerr << "Error: Too many keywords (KeywordId holds at most " << MAX_KEYWORD_COUNT << ")" << std::endl;
+                return false;
+            }
+
+            keywords.push_back(keyword);
+        }
+
+        file.close();
+        std::cout << "Total keywords loaded: " << keywords.size() << std::endl;
+        return !keywords.empty();
+    }
+
+    std::string KeywordHash::enumName(const std::string& keyword) {
+        std::string name = "KW_" + keyword;
+        std::transform(name.begin(), name.end(), name.begin(),
+            [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        return name;
+    }
+
+    std::uint32_t KeywordHash::hashKey(const std::string& keyword) const {
+        std::uint32_t key = static_cast<std::uint32_t>(keyword.size());
+        for (int position : keyPositions) {
+            std::size_t index = std::min(static_cast<std::size_t>(position), keyword.size() - 1);
+            key = key * HASH_BASE + static_cast<unsigned char>(keyword[index]);
+        }
+        key = key * HASH_BASE + static_cast<unsigned char>(keyword.back());
+        return key;
+    }
+
+    std::uint32_t KeywordHash::slotOf(const std::string& keyword) const {
+        return (hashKey(keyword) * multiplier) >> (32 - tableBits);
+    }
+
+    bool KeywordHash::choosePositions() {
+        // 依次尝试 {首}、{首, 第2个}、{首, 第2个, 第3个} ... 字符（尾字符始终参与），
+        // 直到 (长度, 所选字符, 尾字符) 能区分所有关键字
+        std::size_t maxLength = 0;
+        for (const auto& keyword : keywords) {
+            maxLength = std::max(maxLength, keyword.size());
+        }
+
+        keyPositions.clear();
+        for (std::size_t count = 1; count <= maxLength; ++count) {
+            keyPositions.push_back(static_cast<int>(count - 1));
+
+            std::set<std::string> tuples;
+            for (const auto& keyword : keywords) {
+                std::string tuple = std::to_string(keyword.size()) + ":";
+                for (int position : keyPositions) {
+                    tuple += keyword[std::min(static_cast<std::size_t>(position), keyword.size() - 1)];
+                }
+                tuple += keyword.back();
+                tuples.insert(tuple);
+            }
+            if (tuples.size() == keywords.size()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool KeywordHash::searchMultiplier() {
+        // 表大小从不小于关键字数的 2 的幂开始，逐步放大，每个大小下尝试一批确定性的奇数乘数
+        int minBits = 1;
+        while ((std::size_t(1) << minBits) < keywords.size()) {
+            minBits++;
+        }
+
+        std::uint32_t state = 0x9E3779B9u;
+        for (tableBits = minBits; tableBits <= minBits + 4; ++tableBits) {
+            for (int attempt = 0; attempt < 100000; ++attempt) {
+                // xorshift32 产生候选乘数
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                multiplier = state | 1u;
+
+                slots.assign(std::size_t(1) << tableBits, -1);
+                bool collision = false;
+                for (std::size_t i = 0; i < keywords.size() && !collision; ++i) {
+                    std::uint32_t slot = slotOf(keywords[i]);
+                    if (slots[slot] != -1) {
+                        collision = true;
+                    }
+                    else {
+                        slots[slot] = static_cast<int>(i);
+                    }
+                }
+                if (!collision) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool KeywordHash::build() {
+        if (keywords.empty()) {
+            std::cerr << "Error: No keywords to build" << std::endl;
+            return false;
+        }
+        if (!choosePositions()) {
+            std::cerr << "Error: Keywords cannot be distinguished by their characters" << std::endl;
+            return false;
+        }
+        if (!searchMultiplier()) {
+            std::cerr << "Error: Failed to find a collision-free keyword hash" << std::endl;
+            return false;
+        }
+
+        std::cout << "Keyword perfect hash: " << keywords.size() << " keywords, "
+            << (1u << tableBits) << " slots, multiplier " << multiplier << std::endl;
+        return true;
+    }
+
+    bool KeywordHash::exportToHeaderFile(const std::string& filePath) const {
+        std::ofstream outFile(filePath);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Cannot open file " << filePath << " for writing" << std::endl;
+            return false;
+        }
+
+        std::size_t minLength = keywords[0].size();
+        std::size_t maxLength = keywords[0].size();
+        for (const auto& keyword : keywords) {
+            minLength = std::min(minLength, keyword.size());
+            maxLength = std::max(maxLength, keyword.size());
+        }
+
+        // 写入头文件保护宏
+        outFile << "#ifndef KEYWORD_TABLE_HPP\n";
+        outFile << "#define KEYWORD_TABLE_HPP\n\n";
+        outFile << "#include <cstddef>\n";
+        outFile << "#include <cstdint>\n";
+        outFile << "#include <string_view>\n\n";
+        outFile << "namespace Compiler {\n\n";
+
+        // 写入关键字ID枚举
+        outFile << "// Keyword IDs in spec file order (NONE: not a keyword)\n";
+        outFile << "enum class KeywordId : std::uint8_t {\n";
+        outFile << "    NONE = 0,\n";
+        for (std::size_t i = 0; i < keywords.size(); ++i) {
+            outFile << "    " << enumName(keywords[i]) << " = " << (i + 1) << (i + 1 == keywords.size() ? "\n" : ",\n");
+        }
+        outFile << "};\n\n";
+
+        // 写入关键字数量和长度范围
+        outFile << "// Keywords count\n";
+        outFile << "constexpr int KEYWORD_COUNT = " << keywords.size() << ";\n\n";
+        outFile << "// Keyword length range\n";
+        outFile << "constexpr std::size_t KEYWORD_MIN_LENGTH = " << minLength << ";\n";
+        outFile << "constexpr std::size_t KEYWORD_MAX_LENGTH = " << maxLength << ";\n\n";
+
+        // 写入关键字文本
+        outFile << "// Keyword text: [keyword ID] -> spelling\n";
+        outFile << "constexpr std::string_view KEYWORD_NAMES[KEYWORD_COUNT + 1] = {\n";
+        outFile << "    \"\",\n";
+        for (std::size_t i = 0; i < keywords.size(); ++i) {
+            outFile << "    \"" << keywords[i] << "\"" << (i + 1 == keywords.size() ? "\n" : ",\n");
+        }
+        outFile << "};\n\n";
+
+        // 写入哈希参数
+        outFile << "// Perfect hash: key = length, then key = key * " << HASH_BASE << " + byte for each of text[";
+        for (int position : keyPositions) {
+            outFile << position << ", ";
+        }
+        outFile << "last] (indices clamped to the last byte)\n";
+        outFile << "//   slot = (key * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_HASH_BITS)\n";
+        outFile << "constexpr std::uint32_t KEYWORD_HASH_MULTIPLIER = " << multiplier << "u;\n";
+        outFile << "constexpr int KEYWORD_HASH_BITS = " << tableBits << ";\n\n";
+
+        // 写入哈希槽
+        outFile << "// Hash slot -> keyword ID (collision-free)\n";
+        outFile << "constexpr KeywordId KEYWORD_SLOTS[1 << KEYWORD_HASH_BITS] = {\n";
+        for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+            outFile << "    ";
+            if (slots[slot] == -1) {
+                outFile << "KeywordId::NONE";
+            }
+            else {
+                outFile << "KeywordId::" << enumName(keywords[slots[slot]]);
+            }
+            outFile << (slot + 1 == slots.size() ? "" : ",") << " // slot " << slot << "\n";
+        }
+        outFile << "};\n\n";
+
+        // 写入查找函数
+        outFile << "// Keyword lookup: returns KeywordId::NONE if text is not a keyword\n";
+        outFile << "constexpr KeywordId lookupKeyword(std::string_view text) {\n";
+        outFile << "    const std::size_t length = text.size();\n";
+        outFile << "    if (length < KEYWORD_MIN_LENGTH || length > KEYWORD_MAX_LENGTH) {\n";
+        outFile << "        return KeywordId::NONE;\n";
+        outFile << "    }\n";
+        outFile << "    const unsigned char first = static_cast<unsigned char>(text[0]);\n";
+        outFile << "    const unsigned char last = static_cast<unsigned char>(text[length - 1]);\n\n";
+
+        // 快速拒绝：按长度分支，只接受该长度下关键字的首尾字符组合
+        outFile << "    // Fast reject: only (first, last) pairs of keywords with this length pass\n";
+        outFile << "    switch (length) {\n";
+        std::map<std::size_t, std::set<std::pair<char, char>>> pairsByLength;
+        std::map<std::size_t, std::vector<std::string>> namesByLength;
+        for (const auto& keyword : keywords) {
+            pairsByLength[keyword.size()].insert({ keyword.front(), keyword.back() });
+            namesByLength[keyword.size()].push_back(keyword);
+        }
+        for (const auto& entry : pairsByLength) {
+            outFile << "    case " << entry.first << ": //";
+            for (const auto& name : namesByLength[entry.first]) {
+                outFile << " " << name;
+            }
+            outFile << "\n";
+            outFile << "        if (!(";
+            bool firstPair = true;
+            for (const auto& pair : entry.second) {
+                if (!firstPair) {
+                    outFile << " ||\n              ";
+                }
+                outFile << "(first == '" << pair.first << "' && last == '" << pair.second << "')";
+                firstPair = false;
+            }
+            outFile << ")) {\n";
+            outFile << "            return KeywordId::NONE;\n";
+            outFile << "        }\n";
+            outFile << "        break;\n";
+        }
+        outFile << "    default:\n";
+        outFile << "        return KeywordId::NONE;\n";
+        outFile << "    }\n\n";
+
+        // 完美哈希定位唯一候选，再比较一次文本
+        outFile << "    std::uint32_t key = static_cast<std::uint32_t>(length);\n";
+        for (int position : keyPositions) {
+            outFile << "    key = key * " << HASH_BASE << "u + static_cast<unsigned char>(text[";
+            if (static_cast<std::size_t>(position) < minLength) {
+                outFile << position;
+            }
+            else {
+                outFile << "length > " << position << " ? " << position << " : length - 1";
+            }
+            outFile << "]);\n";
+        }
+        outFile << "    key = key * " << HASH_BASE << "u + last;\n";
+        outFile << "    const KeywordId id = KEYWORD_SLOTS[(key * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_HASH_BITS)];\n";
+        outFile << "    return KEYWORD_NAMES[static_cast<int>(id)] == text ? id : KeywordId::NONE;\n";
+        outFile << "}\n\n";
+
+        outFile << "} // namespace Compiler\n\n";
+        outFile << "#endif // KEYWORD_TABLE_HPP\n";
+
+        outFile.close();
+        return true;
+    }
+
+} // namespace Compiler
@@ -64,12 +64,26 @@ void print_nfa(std::shared_ptr<Compiler::NFA> nfa) {
     std::cout << std::endl;
 }
 
+// 字符类 [...] 中 regex[i]（'['）对应的 ']' 的位置，字符类中的 '\' 转义下一个字符；没有闭合时返回 npos
+size_t charClassEnd(const std::string& regex, size_t i) {
+    for (size_t j = i + 1; j < regex.size(); j++) {
+        if (regex[j] == '\\') {
+            j++;
+        }
+        else if (regex[j] == ']' && j > i + 1 && !(j == i + 2 && regex[i + 1] == '^')) {
+            return j;
+        }
+    }
+    return std::string::npos;
+}
+
 namespace Compiler {
 
     bool RegexEngine::loadRulesFromFile(const std::string& filePath) {
         // 从文件中读取正则表达式规则
-        // 格式为：<tokenName>  pattern  priority
-        // 每行一个规则
+        // 格式为：<tokenName>  pattern  priority  [actions...]
+        // 每行一个规则。"%mode name" 一行开始一个词法模式（起始条件），之后的规则属于该模式，
+        // 第一个 %mode 之前的规则属于初始模式 initial。动作为 skip（丢弃该词法单元）和 BEGIN(mode)（匹配后进入 mode）
 
         std::ifstream file(filePath);
         if (!file.is_open()) {
@@ -77,6 +91,10 @@ namespace Compiler {
             return false;
         }
 
+        modes.assign(1, INITIAL_MODE);
+        std::string currentMode = INITIAL_MODE;
+        bool valid = true;
+
         std::string line;
         while (std::getline(file, line)) {
             // 跳过空行和注释行
@@ -85,6 +103,23 @@ namespace Compiler {
             }
 
             std::istringstream iss(line);
+
+            // 词法模式声明，同名模式可以分多段声明
+            if (line[0] == '%') {
+                std::string directive, modeName;
+                if (!(iss >> directive >> modeName) || directive != "%mode") {
+                    std::cerr << "Error: Invalid directive in line: " << line << std::endl;
+                    valid = false;
+                    continue;
+                }
+                if (std::find(modes.begin(), modes.end(), modeName) == modes.end()) {
+                    modes.push_back(modeName);
+                }
+                currentMode = modeName;
+                std::cout << "Entering lexer mode: " << modeName << std::endl;
+                continue;
+            }
+
             std::string tokenName, pattern;
             int priority;
 
@@ -101,25 +136,101 @@ namespace Compiler {
                 tokenPriorities[tokenName] = 0; // 默认优先级为0
             }
 
+            if (regexrules.count(tokenName) && tokenModes[tokenName] != currentMode) {
+                std::cerr << "Error: Token " << tokenName << " is defined in modes " << tokenModes[tokenName]
+                    << " and " << currentMode << std::endl;
+                valid = false;
+            }
             regexrules[tokenName] = pattern;  // map会自动按key排序
+            tokenModes[tokenName] = currentMode;
+
+            // 读取动作(如果存在)
+            std::vector<std::string> actions;
+            for (std::string action; iss >> action;) {
+                actions.push_back(action);
+            }
+            if (!parseActions(tokenName, actions)) {
+                std::cerr << "Error: Invalid action in line: " << line << std::endl;
+                valid = false;
+            }
 
             std::cout << "Loaded rule: " << tokenName
                 << " -> " << pattern
-                << " (priority: " << tokenPriorities[tokenName] << ")" << std::endl;
+                << " (priority: " << tokenPriorities[tokenName] << ", mode: " << currentMode << ")" << std::endl;
         }
 
         file.close();
-        std::cout << "Total rules loaded: " << regexrules.size() << std::endl;
+
+        // BEGIN 可以引用之后才声明的模式，读完整个文件后再检查
+        for (const auto& [tokenName, nextMode] : tokenNextModes) {
+            if (std::find(modes.begin(), modes.end(), nextMode) == modes.end()) {
+                std::cerr << "Error: Token " << tokenName << " switches to undeclared mode " << nextMode << std::endl;
+                valid = false;
+            }
+        }
+        if (!valid) {
+            return false;
+        }
+
+        std::cout << "Total rules loaded: " << regexrules.size() << " in " << modes.size() << " mode(s)" << std::endl;
         std::cout << std::endl;
         std::cout << "====================Starting regex to NFA conversion...========================" << std::endl;
         std::cout << std::endl;
         return true;
     }
 
+    bool RegexEngine::parseActions(const std::string& tokenName, const std::vector<std::string>& actions) {
+        for (const std::string& action : actions) {
+            if (action == "skip") {
+                skippedTokens.insert(tokenName);
+            }
+            else if (action.size() > 7 && action.compare(0, 6, "BEGIN(") == 0 && action.back() == ')') {
+                tokenNextModes[tokenName] = action.substr(6, action.size() - 7);
+            }
+            else {
+                return false;
+            }
+        }
+
+        // 宏定义不会成为词法单元，动作没有意义
+        if (!actions.empty() && tokenPriorities[tokenName] == 0) {
+            std::cerr << "Warning: Actions of macro definition " << tokenName << " are ignored" << std::endl;
+        }
+        return true;
+    }
+
     const std::map<std::string, std::string>& RegexEngine::getRules() const {
         return regexrules;
     }
 
+    const std::vector<std::string>& RegexEngine::getModes() const {
+        return modes;
+    }
+
+    const std::map<std::string, std::string>& RegexEngine::getNextModes() const {
+        return tokenNextModes;
+    }
+
+    const std::set<std::string>& RegexEngine::getSkippedTokens() const {
+        return skippedTokens;
+    }
+
+    std::vector<std::string> RegexEngine::getTokenNames() const {
+        std::vector<std::pair<int, std::string>> ordered;
+        for (const auto& [tokenName, priority] : tokenPriorities) {
+            if (priority != 0) {
+                ordered.push_back({ -priority, tokenName });
+            }
+        }
+        std::sort(ordered.begin(), ordered.end());
+
+        std::vector<std::string> tokenNames;
+        for (const auto& entry : ordered) {
+            tokenNames.push_back(entry.second);
+        }
+        return tokenNames;
+    }
+
     // 使用MYT算法将正则表达式转换为NFA
     void RegexEngine::regexToNFA(std::map<std::string, std::string> &regexrules) {
         // 1. 预处理正则表达式
@@ -201,6 +312,17 @@ namespace Compiler {
                         break;
                     }
                 }
+                else if (c == '[') {
+                    // 处理字符类
+                    std::bitset<256> bytes;
+                    if (!parseCharClass(postfix, i, bytes)) {
+                        std::cerr << "Error: Invalid character class in token " << token_name
+                            << " (position: " << i << ")" << std::endl;
+                        hasError = true;
+                        break;
+                    }
+                    nfaStack.push(createCharSetNFA(bytes));
+                }
                 else {
                     // 处理普通字符
                     nfaStack.push(createBasicNFA(c));
@@ -238,15 +360,24 @@ namespace Compiler {
         return;
     }
 
-    std::shared_ptr<NFA> RegexEngine::buildCombinedNFA() {
-        regexToNFA(regexrules);
+    std::shared_ptr<NFA> RegexEngine::buildCombinedNFA(const std::string& mode) {
+        // 所有模式的规则只转换一次，之后按模式挑选
         if (nfa_map.empty()) {
-            std::cerr << "Error: No NFA rules loaded." << std::endl;
+            regexToNFA(regexrules);
+        }
+        std::map<std::string, std::shared_ptr<NFA>> modeNFAs;
+        for (const auto& [tokenName, tokenNFA] : nfa_map) {
+            if (tokenModes[tokenName] == mode) {
+                modeNFAs[tokenName] = tokenNFA;
+            }
+        }
+        if (modeNFAs.empty()) {
+            std::cerr << "Error: No NFA rules loaded in mode " << mode << "." << std::endl;
             return nullptr;
         }
-        if (nfa_map.size() == 1) {
-            print_nfa(nfa_map.begin()->second);
-            return nfa_map.begin()->second;
+        if (modeNFAs.size() == 1) {
+            print_nfa(modeNFAs.begin()->second);
+            return modeNFAs.begin()->second;
         }
 
         std::shared_ptr<NFA> combinedNFA = std::make_shared<NFA>();
@@ -259,8 +390,8 @@ namespace Compiler {
         std::shared_ptr<NFAState> finalState = combinedNFA->createState(true);
         combinedNFA->setFinalState(finalState);
 
-        // 将所有 NFA 的状态和转移复制到合并的 NFA 中
-        for (const auto& [tokenName, tokenNFA] : nfa_map) {
+        // 将该模式所有 NFA 的状态和转移复制到合并的 NFA 中
+        for (const auto& [tokenName, tokenNFA] : modeNFAs) {
             // 复制当前 NFA 的所有状态
             std::map<std::shared_ptr<NFAState>, std::shared_ptr<NFAState>> stateMap;
 
@@ -299,7 +430,7 @@ namespace Compiler {
             tokenFinalState->setPriority(tokenNFA->getFinalState()->getPriority());
         }
 
-        std::cout << "Successfully built combined NFA." << std::endl;
+        std::cout << "Successfully built combined NFA for mode " << mode << "." << std::endl;
         print_nfa(combinedNFA);
         return combinedNFA;
     }
@@ -318,6 +449,11 @@ namespace Compiler {
             std::string &regex = item.second;
 
             for (size_t i = 0; i < regex.size(); i++) {
+                // 字符类中的字符都是普通字符
+                if (regex[i] == '[' && charClassEnd(regex, i) != std::string::npos) {
+                    i = charClassEnd(regex, i);
+                    continue;
+                }
                 if ((regex[i] == '<' && regex[i + 1] == '=') ||
                     (regex[i] == '>' && regex[i + 1] == '=') ||
                     (regex[i] == '!' && regex[i + 1] == '=') ||
@@ -342,6 +478,10 @@ namespace Compiler {
                 std::string &regex = item.second;
 
                 for (size_t i = 0; i < regex.size(); i++) {
+                    if (regex[i] == '[' && charClassEnd(regex, i) != std::string::npos) {
+                        i = charClassEnd(regex, i);
+                        continue;
+                    }
                     if (regex[i] == '<' && (i + 1 < regex.size()) && regex[i + 1] != '|' && regex[i + 1] != '=') {
                         // 查找宏定义结束位置
                         size_t macro_end = regex.find('>', i + 1);
@@ -407,6 +547,13 @@ namespace Compiler {
                 i++; // 跳过被转义的字符
                 current = regex[i]; // 更新 current，用于后续连接符判断
             }
+            // 字符类整体作为一个操作数
+            else if (current == '[' && charClassEnd(regex, i) != std::string::npos) {
+                size_t end = charClassEnd(regex, i);
+                result += regex.substr(i + 1, end - i);
+                i = end;
+                current = ']';
+            }
 
             // 如果还有下一个字符，检查是否需要添加连接符
             if (i + 1 < regex.size()) {
@@ -467,6 +614,11 @@ namespace Compiler {
                     i++; // 跳过下一个字符
                 }
             }
+            else if (c == '[' && charClassEnd(regex, i) != std::string::npos) { // 字符类，原样作为一个操作数
+                size_t end = charClassEnd(regex, i);
+                postfix += regex.substr(i, end - i + 1);
+                i = end;
+            }
             else if (c == '(') {
                 ops.push(c);
             }
@@ -517,6 +669,67 @@ namespace Compiler {
         return nfa;
     }
 
+    // 解析字符类：[abc]、区间 [a-z]、取反 [^*]，'\' 转义下一个字符（如 [\]\-]）
+    bool RegexEngine::parseCharClass(const std::string& regex, size_t& i, std::bitset<256>& bytes) const {
+        size_t end = charClassEnd(regex, i);
+        if (end == std::string::npos) {
+            return false;
+        }
+
+        size_t j = i + 1;
+        bool negated = regex[j] == '^';
+        if (negated) {
+            j++;
+        }
+        bytes.reset();
+        while (j < end) {
+            if (regex[j] == '\\') {
+                j++;
+            }
+            unsigned char first = static_cast<unsigned char>(regex[j]);
+            unsigned char last = first;
+            j++;
+            if (j + 1 < end && regex[j] == '-') {
+                j++;
+                if (regex[j] == '\\') {
+                    j++;
+                }
+                last = static_cast<unsigned char>(regex[j]);
+                j++;
+                if (last < first) {
+                    return false;
+                }
+            }
+            for (int byte = first; byte <= last; byte++) {
+                bytes.set(byte);
+            }
+        }
+        if (negated) {
+            bytes.flip();
+        }
+
+        i = end;
+        return bytes.any();
+    }
+
+    // 创建接受字符集合中任一字节的NFA：开始状态对每个字节各有一条转移
+    std::shared_ptr<NFA> RegexEngine::createCharSetNFA(const std::bitset<256>& bytes) {
+        std::shared_ptr<NFA> nfa = std::make_shared<NFA>();
+
+        std::shared_ptr<NFAState> start = nfa->createState(false);
+        std::shared_ptr<NFAState> accept = nfa->createState(true);
+
+        for (int byte = 0; byte < 256; byte++) {
+            if (bytes.test(byte)) {
+                start->addTransition(static_cast<char>(byte), accept);
+            }
+        }
+        nfa->setStartState(start);
+        nfa->setFinalState(accept);
+
+        return nfa;
+    }
+
     // 创建两个NFA的连接
     std::shared_ptr<NFA> RegexEngine::createConcatenation(std::shared_ptr<NFA> first, std::shared_ptr<NFA> second) {
         // 创建新的nfa
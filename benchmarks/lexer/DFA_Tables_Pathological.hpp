@@ -0,0 +1,153 @@
+#ifndef DFA_TABLES_PATHOLOGICAL_HPP
+#define DFA_TABLES_PATHOLOGICAL_HPP
+
+#include <cstdint>
+
+namespace Compiler::Pathological {
+
+// DFA start state ID
+constexpr int DFA_START_STATE = 0;
+
+// DFA states count
+constexpr int DFA_STATE_COUNT = 3;
+
+// Dead state sentinel: no transition on the input byte
+constexpr int DFA_DEAD_STATE = -1;
+
+// Storage type of a state ID in the transition table
+using DFAStateId = std::int8_t;
+
+// Number of input byte equivalence classes
+constexpr int DFA_CLASS_COUNT = 3;
+
+// Entries per transition table row (DFA_CLASS_COUNT, or more when rows are padded to cache line boundaries)
+constexpr int DFA_ROW_STRIDE = 3;
+
+// Input byte -> equivalence class ID (bytes of one class behave identically in every state)
+//   class 0: 0x00-'`' 'c'-0xff
+//   class 1: 'a'
+//   class 2: 'b'
+constexpr std::uint8_t DFA_CHAR_CLASS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// DFA transition table: [current state ID][byte class] -> target state ID
+alignas(64) constexpr DFAStateId DFA_TRANSITION_TABLE[DFA_STATE_COUNT][DFA_ROW_STRIDE] = {
+    { -1, 1, 0 }, // state 0
+    { -1, 1, 2 }, // state 1
+    { -1, 1, 0 } // state 2
+};
+
+// Token kinds: one per rule in priority order (highest first), DFA_TOKEN_NONE for non-accepting states
+enum DFATokenKind : std::uint8_t {
+    DFA_TOKEN_NONE = 0,
+    DFA_TOKEN_TEST1 = 1 // <test1>
+};
+
+// Token kinds count (including DFA_TOKEN_NONE)
+constexpr int DFA_TOKEN_KIND_COUNT = 2;
+
+// Token kind -> rule name (for diagnostics)
+constexpr const char* DFA_TOKEN_NAMES[DFA_TOKEN_KIND_COUNT] = {
+    nullptr,
+    "<test1>"
+};
+
+// DFA accept states table: [state ID] -> token kind (DFA_TOKEN_NONE if not accepting)
+constexpr DFATokenKind DFA_ACCEPT_KIND[DFA_STATE_COUNT] = {
+    DFA_TOKEN_NONE, // state 0
+    DFA_TOKEN_NONE, // state 1
+    DFA_TOKEN_TEST1 // state 2
+};
+
+// DFA acceleration table: [state ID] -> { escape byte count, escape bytes... } for states that loop back
+// to themselves on every other byte (the run up to the next escape byte can be skipped at once); { 0 } otherwise
+constexpr std::uint8_t DFA_ACCEL[DFA_STATE_COUNT][4] = {
+    { 0 }, // state 0
+    { 0 }, // state 1
+    { 0 } // state 2
+};
+
+// Shuffle DFA (pshufb): lane s of DFA_SHUFFLE_TABLE[byte class] is the target state of state s,
+// DFA_SHUFFLE_DEAD if there is no transition. Only usable when DFA_SHUFFLE_AVAILABLE (at most 16 states).
+constexpr bool DFA_SHUFFLE_AVAILABLE = true;
+constexpr std::uint8_t DFA_SHUFFLE_DEAD = 0x80;
+constexpr std::uint16_t DFA_SHUFFLE_ACCEPT_MASK = 0x4;
+alignas(16) constexpr std::uint8_t DFA_SHUFFLE_TABLE[DFA_CLASS_COUNT][16] = {
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 0
+    { 1, 1, 1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 1
+    { 0, 2, 0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 } // class 2
+};
+
+// Lexer modes (start conditions); mode 0 is the initial mode and uses the unprefixed tables
+enum DFAMode : std::uint8_t {
+    DFA_MODE_INITIAL = 0
+};
+
+constexpr int DFA_MODE_COUNT = 1;
+
+// Mode -> name (for diagnostics)
+constexpr const char* DFA_MODE_NAMES[DFA_MODE_COUNT] = {
+    "initial"
+};
+
+// Tables of one lexer mode: transitions[state * rowStride + charClass[byte]] -> target state ID
+struct DFAModeTable {
+    int start;
+    int stateCount;
+    int classCount;
+    int rowStride;
+    const std::uint8_t* charClass;
+    const DFAStateId* transitions;
+    const DFATokenKind* acceptKind;
+    const std::uint8_t* accel; // [state * 4], see DFA_ACCEL
+};
+
+constexpr DFAModeTable DFA_MODE_TABLES[DFA_MODE_COUNT] = {
+    { DFA_START_STATE, DFA_STATE_COUNT, DFA_CLASS_COUNT, DFA_ROW_STRIDE, DFA_CHAR_CLASS, DFA_TRANSITION_TABLE[0], DFA_ACCEPT_KIND, DFA_ACCEL[0] } // initial
+};
+
+// Token kind -> mode entered after the token (BEGIN action), DFA_MODE_KEEP to stay in the current mode
+constexpr std::int8_t DFA_MODE_KEEP = -1;
+constexpr std::int8_t DFA_TOKEN_NEXT_MODE[DFA_TOKEN_KIND_COUNT] = {
+    DFA_MODE_KEEP, // DFA_TOKEN_NONE
+    DFA_MODE_KEEP // <test1>
+};
+
+// Token kind -> dropped instead of returned to the caller (skip action)
+constexpr bool DFA_TOKEN_SKIP[DFA_TOKEN_KIND_COUNT] = {
+    false, // DFA_TOKEN_NONE
+    false // <test1>
+};
+
+// Mode -> terminator derived from the rules: lexing in the mode is equivalent to skipping the input up to and
+// including the first occurrence of text, then entering nextMode (proved by the generator for all inputs, over
+// the noted number of abstract lexer configurations). length is 0 for modes lexed with their tables
+struct DFAModeTerminator {
+    const char* text;
+    int length;
+    std::int8_t nextMode;
+};
+
+constexpr DFAModeTerminator DFA_MODE_TERMINATORS[DFA_MODE_COUNT] = {
+    { nullptr, 0, DFA_MODE_KEEP } // initial
+};
+
+} // namespace Compiler::Pathological
+
+#endif // DFA_TABLES_PATHOLOGICAL_HPP
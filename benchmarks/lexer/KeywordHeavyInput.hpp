@@ -0,0 +1,117 @@
+#pragma once
+
+#ifndef KEYWORD_HEAVY_INPUT_HPP
+#define KEYWORD_HEAVY_INPUT_HPP
+
+#include "DFA_Tables_Large.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 大规则集的基准测试输入，由 LexerBenchmark 与构建时记录剖析文件的 LargeProfileTrainer 共用
+namespace Compiler::Benchmark {
+
+    // 任一套生成的表的访问方式（MaximalMunch 与 DFAProfile 所需的全部接口），用于命名空间不同的基准测试表
+    template <int Start, int StateCount, int ClassCount, const auto& CharClass, const auto& Transitions, const auto& AcceptKind>
+    struct TableDFA {
+        static constexpr int START = Start;
+        static constexpr int STATE_COUNT = StateCount;
+        static constexpr int CLASS_COUNT = ClassCount;
+
+        static int charClass(unsigned char byte) {
+            return CharClass[byte];
+        }
+
+        static int transition(int state, int charClass) {
+            return Transitions[state][charClass];
+        }
+
+        static int next(int state, unsigned char byte) {
+            return Transitions[state][CharClass[byte]];
+        }
+
+        static bool accepts(int state) {
+            return AcceptKind[state] != 0;
+        }
+    };
+
+    // input/lex_rules_large.txt（500 多个关键字各为一条规则）按最小化顺序编号的表，构建时由 DFAGenerator 生成
+    using LargeDFA = TableDFA<Large::DFA_START_STATE, Large::DFA_STATE_COUNT, Large::DFA_CLASS_COUNT,
+        Large::DFA_CHAR_CLASS, Large::DFA_TRANSITION_TABLE, Large::DFA_ACCEPT_KIND>;
+
+    // 关键字密集的输入：关键字与标识符按 Zipf 分布（第 r 常用的出现概率正比于 1/r）抽取，
+    // 夹杂数字和符号，模拟查询语句一类的机器生成代码。seed 不同的输入用于训练和测量
+    inline std::string makeKeywordHeavyInput(std::size_t targetBytes, std::uint64_t seed) {
+        std::vector<std::string> keywords;
+        for (int kind = 1; kind < Large::DFA_TOKEN_KIND_COUNT; ++kind) {
+            std::string_view name = Large::DFA_TOKEN_NAMES[kind];
+            if (name.starts_with("<kw_")) {
+                keywords.emplace_back(name.substr(4, name.size() - 5));
+            }
+        }
+        std::vector<std::string> identifiers;
+        for (int index = 0; index < 2000; ++index) {
+            identifiers.push_back("col_" + std::to_string(index));
+        }
+
+        // 关键字的常用程度排名由固定的种子打乱，训练和测量输入相同
+        std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+        auto random = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (std::size_t index = keywords.size(); index > 1; --index) {
+            std::swap(keywords[index - 1], keywords[random() % index]);
+        }
+
+        // Zipf 分布的累积权重
+        auto zipf = [](std::size_t count) {
+            std::vector<double> cumulative(count);
+            double total = 0.0;
+            for (std::size_t rank = 0; rank < count; ++rank) {
+                total += 1.0 / static_cast<double>(rank + 1);
+                cumulative[rank] = total;
+            }
+            return cumulative;
+        };
+        std::vector<double> keywordWeights = zipf(keywords.size());
+        std::vector<double> identifierWeights = zipf(identifiers.size());
+        auto pick = [&](const std::vector<std::string>& words, const std::vector<double>& weights) -> const std::string& {
+            double target = static_cast<double>(random() % 1000000) / 1000000.0 * weights.back();
+            return words[std::lower_bound(weights.begin(), weights.end(), target) - weights.begin()];
+        };
+
+        state = seed;
+        const char* punctuation[] = { ",", ";", "(", ")", "=", "." };
+        std::string input;
+        input.reserve(targetBytes + 64);
+        while (input.size() < targetBytes) {
+            std::uint64_t choice = random() % 10;
+            if (choice < 5) {
+                input += pick(keywords, keywordWeights);
+            }
+            else if (choice < 8) {
+                input += pick(identifiers, identifierWeights);
+            }
+            else if (choice < 9) {
+                input += std::to_string(random() % 100000);
+            }
+            else {
+                input += punctuation[random() % 6];
+            }
+            input += random() % 8 == 0 ? '\n' : ' ';
+        }
+        return input;
+    }
+
+    // 训练用输入（与测量用输入的 seed 不同）
+    inline constexpr std::uint64_t LARGE_TRAINING_SEED = 88172645463325252ULL;
+    inline constexpr std::uint64_t LARGE_MEASURE_SEED = 2463534242ULL;
+
+} // namespace Compiler::Benchmark
+
+#endif // KEYWORD_HEAVY_INPUT_HPP
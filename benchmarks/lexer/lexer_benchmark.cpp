@@ -0,0 +1,1186 @@
+#include "Lexer.hpp"
+#include "DFA_Tables.hpp"
+#include "SIMDScan.hpp"
+#include "Keyword_Table.hpp"
+#include "TokenStream.hpp"
+#include "ParallelLexer.hpp"
+#include "StreamLexer.hpp"
+#include "MaximalMunch.hpp"
+#include "DFA_Tables_Pathological.hpp"
+#include "DFA_DirectCoded.hpp"
+#include "ShuffleDFA.hpp"
+#include "BatchLexer.hpp"
+#include "StringInterner.hpp"
+#include "NumberParser.hpp"
+#include "IncrementalLexer.hpp"
+#include "DFA_TokenTypes.hpp"
+#include "DFAProfile.hpp"
+#include "DFA_Tables_LargeProfiled.hpp"
+#include "KeywordHeavyInput.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <charconv>
+#include <cctype>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace Compiler;
+using namespace Compiler::Benchmark;
+
+namespace {
+
+    // 典型的机器生成源程序片段，重复拼接得到大输入
+    const std::string SAMPLE_PROGRAM =
+        "{\n"
+        "    int alpha;\n"
+        "    int beta2;\n"
+        "    read alpha;\n"
+        "    beta2 = alpha * 2 + 3;\n"
+        "    if (alpha >= beta2) write alpha; else write beta2;\n"
+        "    while (alpha < 100) alpha = alpha + 1;\n"
+        "    for (alpha = 0; alpha <= 10; alpha = alpha + 1) { write alpha / 2 - 1; }\n"
+        "}\n";
+
+    // 生成不小于 targetBytes 字节的输入
+    std::string makeInput(std::size_t targetBytes) {
+        std::string input;
+        input.reserve(targetBytes + SAMPLE_PROGRAM.size());
+        while (input.size() < targetBytes) {
+            input += SAMPLE_PROGRAM;
+        }
+        return input;
+    }
+
+    // 生成深度缩进的输入：每行前加 indent 个空格，并夹杂空行，模拟机器生成的代码
+    std::string makeIndentedInput(std::size_t targetBytes, std::size_t indent) {
+        std::string input;
+        input.reserve(targetBytes + SAMPLE_PROGRAM.size() * 4);
+        std::string padding(indent, ' ');
+        while (input.size() < targetBytes) {
+            std::size_t lineStart = 0;
+            while (lineStart < SAMPLE_PROGRAM.size()) {
+                std::size_t lineEnd = SAMPLE_PROGRAM.find('\n', lineStart);
+                input += padding;
+                input.append(SAMPLE_PROGRAM, lineStart, lineEnd - lineStart + 1);
+                input += "\n";
+                lineStart = lineEnd + 1;
+            }
+        }
+        return input;
+    }
+
+    // 许可证头风格的块注释
+    const std::string LICENSE_COMMENT =
+        "/*\n"
+        " * Copyright (c) The TESTCompiler Authors. All rights reserved.\n"
+        " *\n"
+        " * Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+        " * you may not use this file except in compliance with the License.\n"
+        " * Unless required by applicable law or agreed to in writing, software\n"
+        " * distributed under the License is distributed on an \"AS IS\" BASIS.\n"
+        " */\n";
+
+    // 生成注释密集的输入：每段程序前都有一个许可证头，并夹杂连续的短注释
+    std::string makeCommentInput(std::size_t targetBytes) {
+        std::string input;
+        input.reserve(targetBytes + LICENSE_COMMENT.size() + SAMPLE_PROGRAM.size() + 64);
+        while (input.size() < targetBytes) {
+            input += LICENSE_COMMENT;
+            input += "/* a */ /* b */ /* c */\n";
+            input += SAMPLE_PROGRAM;
+        }
+        return input;
+    }
+
+    // 生成有大量词法错误的输入：每段程序后跟一行含未知字符、孤立的 "*/" 和超出范围的数字的损坏代码，
+    // 模拟批量校验时遇到的损坏的机器生成文件
+    std::string makeMalformedInput(std::size_t targetBytes) {
+        const std::string garbage = "    beta2 = @@@ alpha ## 99999999999999999999 */ $$$$ 1;\n";
+        std::string input;
+        input.reserve(targetBytes + SAMPLE_PROGRAM.size() + garbage.size());
+        while (input.size() < targetBytes) {
+            input += SAMPLE_PROGRAM;
+            input += garbage;
+        }
+        return input;
+    }
+
+    // 丢弃所有输出的流缓冲区，用于测量诊断的格式化开销而不受终端影响
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+    };
+
+    // 计时辅助函数，返回秒数
+    template <typename Func>
+    double measureSeconds(Func&& func) {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - begin).count();
+    }
+
+    // 输出一行结果: 名称 吞吐量(MB/s) 令牌速率(Mtok/s)
+    void report(const std::string& name, std::size_t bytes, std::size_t tokens, double seconds) {
+        double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        std::cout << std::left << std::setw(32) << name
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << megabytes / seconds << " MB/s"
+            << std::setw(10) << static_cast<double>(tokens) / seconds / 1e6 << " Mtok/s"
+            << std::setw(12) << tokens << " tokens" << std::endl;
+    }
+
+    // ==================== 旧实现：std::map 转移表 ====================
+    // 旧的令牌布局：值以 std::string 持有
+    struct LegacyToken {
+        TokenType type;
+        std::string value;
+        std::size_t line;
+        std::size_t column;
+        std::size_t position;
+
+        LegacyToken(TokenType t, const std::string& v, std::size_t l, std::size_t c, std::size_t p)
+            : type(t), value(v), line(l), column(c), position(p) {}
+    };
+
+    // 按原有格式从稠密表重建 std::map 转移表，用于对照旧的 runDFA 路径
+    struct LegacyTables {
+        std::map<int, std::map<char, int>> transitions;
+        std::map<int, std::string> acceptStates;
+
+        LegacyTables() {
+            for (int state = 0; state < DFA_STATE_COUNT; ++state) {
+                std::map<char, int>& row = transitions[state];
+                for (int symbol = 0; symbol < 256; ++symbol) {
+                    int target = DFA_TRANSITION_TABLE[state][DFA_CHAR_CLASS[symbol]];
+                    if (target != DFA_DEAD_STATE) {
+                        row[static_cast<char>(symbol)] = target;
+                    }
+                }
+                if (DFA_ACCEPT_KIND[state] != DFA_TOKEN_NONE) {
+                    acceptStates[state] = DFA_TOKEN_NAMES[DFA_ACCEPT_KIND[state]];
+                }
+            }
+        }
+    };
+
+    // 复现旧的逐字节 map 查找 + 字符串拼接的令牌化过程
+    std::vector<LegacyToken> legacyMapTokenize(const std::string& input, const LegacyTables& tables) {
+        static const std::unordered_set<std::string> keywords = {
+            "if", "else", "while", "for", "return", "int", "float", "char", "string",
+            "bool", "true", "false", "read", "write"
+        };
+
+        std::vector<LegacyToken> tokens;
+        std::size_t position = 0;
+        std::size_t line = 1;
+        std::size_t column = 1;
+        auto advance = [&]() {
+            if (input[position] == '\n') {
+                line++;
+                column = 1;
+            }
+            else {
+                column++;
+            }
+            position++;
+        };
+
+        while (position < input.size()) {
+            while (position < input.size() && std::isspace(static_cast<unsigned char>(input[position]))) {
+                advance();
+            }
+            if (position >= input.size()) {
+                break;
+            }
+
+            std::size_t startPos = position;
+            std::size_t startLine = line;
+            std::size_t startColumn = column;
+            int currentState = DFA_START_STATE;
+            int lastAcceptState = -1;
+            std::size_t lastAcceptPos = position;
+            std::size_t lastAcceptLine = line;
+            std::size_t lastAcceptColumn = column;
+            std::string value;
+            std::string lastAcceptValue;
+            while (position < input.size()) {
+                if (tables.acceptStates.find(currentState) != tables.acceptStates.end()) {
+                    lastAcceptState = currentState;
+                    lastAcceptPos = position;
+                    lastAcceptLine = line;
+                    lastAcceptColumn = column;
+                    lastAcceptValue = value;
+                }
+                auto stateIt = tables.transitions.find(currentState);
+                if (stateIt == tables.transitions.end()) {
+                    break;
+                }
+                auto transIt = stateIt->second.find(input[position]);
+                if (transIt == stateIt->second.end()) {
+                    break;
+                }
+                currentState = transIt->second;
+                value += input[position];
+                advance();
+            }
+            if (tables.acceptStates.find(currentState) != tables.acceptStates.end()) {
+                lastAcceptState = currentState;
+                lastAcceptPos = position;
+                lastAcceptLine = line;
+                lastAcceptColumn = column;
+                lastAcceptValue = value;
+            }
+
+            if (lastAcceptState != -1) {
+                position = lastAcceptPos;
+                line = lastAcceptLine;
+                column = lastAcceptColumn;
+                std::string tokenName = tables.acceptStates.at(lastAcceptState);
+                TokenType type = tokenName == "<identifier>" ? TokenType::IDENTIFIER : TokenType::SINGLEWORD;
+                if (type == TokenType::IDENTIFIER && keywords.count(lastAcceptValue)) {
+                    type = TokenType::KEYWORD;
+                }
+                tokens.push_back(LegacyToken(type, lastAcceptValue, startLine, startColumn, startPos));
+            }
+            else {
+                advance();
+                tokens.push_back(LegacyToken(TokenType::UNKNOWN, value, startLine, startColumn, startPos));
+            }
+        }
+        return tokens;
+    }
+
+
+    // input/lex_rules_pathological.txt 中单独的 (a|b)*ab 规则生成的表（生成时指定 --namespace Pathological）
+    struct PathologicalDFA {
+        static constexpr int START = Pathological::DFA_START_STATE;
+
+        static int next(int state, unsigned char byte) {
+            return Pathological::DFA_TRANSITION_TABLE[state][Pathological::DFA_CHAR_CLASS[byte]];
+        }
+
+        static bool accepts(int state) {
+            return Pathological::DFA_ACCEPT_KIND[state] != Pathological::DFA_TOKEN_NONE;
+        }
+    };
+
+    // 与 Lexer 相同的令牌化主循环（无接受状态时消费一个字节），返回令牌数
+    std::size_t munchTokenize(std::string_view input, MunchMemo* memo) {
+        std::size_t tokens = 0;
+        std::size_t position = 0;
+        while (position < input.size()) {
+            MunchResult match = MaximalMunch<PathologicalDFA>::match(input, position, memo);
+            position = match.acceptState >= 0 ? match.end : position + 1;
+            ++tokens;
+        }
+        return tokens;
+    }
+
+    // 同一套规则按训练输入的剖析重新编号的表（LargeDFA 见 KeywordHeavyInput.hpp）。两套表与剖析文件都在构建时生成：
+    //   DFAGenerator input/lex_rules_large.txt DFA_Tables_Large.hpp --namespace Large
+    //   LargeProfileTrainer lex_profile_large.txt
+    //   DFAGenerator input/lex_rules_large.txt DFA_Tables_LargeProfiled.hpp --namespace LargeProfiled --profile lex_profile_large.txt
+    using LargeProfiledDFA = TableDFA<LargeProfiled::DFA_START_STATE, LargeProfiled::DFA_STATE_COUNT, LargeProfiled::DFA_CLASS_COUNT,
+        LargeProfiled::DFA_CHAR_CLASS, LargeProfiled::DFA_TRANSITION_TABLE, LargeProfiled::DFA_ACCEPT_KIND>;
+
+    // 跳过空白 + 最长匹配的令牌化主循环，返回所有令牌 (结束位置, 接受状态的种类) 的校验和
+    template <typename DFA, const auto& AcceptKind>
+    std::uint64_t tableTokenize(std::string_view input, std::size_t& tokens) {
+        std::uint64_t checksum = 0;
+        tokens = 0;
+        std::size_t position = scanWhitespace(input, 0);
+        while (position < input.size()) {
+            MunchResult match = MaximalMunch<DFA>::match(input, position, nullptr);
+            std::size_t end = match.acceptState >= 0 ? match.end : position + 1;
+            checksum = checksum * 31 + end * 131 + (match.acceptState >= 0 ? AcceptKind[match.acceptState] : 0);
+            position = scanWhitespace(input, end);
+            ++tokens;
+        }
+        return checksum;
+    }
+
+    // 覆盖 99% 的转移表查询所需的状态行共占多少个缓存行（表按缓存行对齐）
+    template <typename DFA>
+    std::size_t hotCacheLines(const DFAProfile& profile, std::size_t rowBytes) {
+        std::vector<int> order(DFA::STATE_COUNT);
+        std::uint64_t total = 0;
+        for (int state = 0; state < DFA::STATE_COUNT; ++state) {
+            order[state] = state;
+            total += profile.stateVisits(state);
+        }
+        std::sort(order.begin(), order.end(), [&profile](int a, int b) {
+            return profile.stateVisits(a) > profile.stateVisits(b);
+        });
+        std::set<std::size_t> lines;
+        std::uint64_t covered = 0;
+        for (std::size_t index = 0; index < order.size() && covered * 100 < total * 99; ++index) {
+            std::size_t rowStart = static_cast<std::size_t>(order[index]) * rowBytes;
+            for (std::size_t line = rowStart / 64; line <= (rowStart + rowBytes - 1) / 64; ++line) {
+                lines.insert(line);
+            }
+            covered += profile.stateVisits(order[index]);
+        }
+        return lines.size();
+    }
+} // namespace
+
+// 稠密转移表 vs 旧 std::map 转移表
+void benchmarkDenseTable(const std::string& input) {
+    std::cout << "\n[Dense DFA table vs std::map table]" << std::endl;
+
+    LegacyTables legacyTables;
+    std::size_t legacyTokens = 0;
+    double legacySeconds = measureSeconds([&]() {
+        legacyTokens = legacyMapTokenize(input, legacyTables).size();
+    });
+    report("std::map table (before)", input.size(), legacyTokens, legacySeconds);
+
+    std::size_t denseTokens = 0;
+    double denseSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        denseTokens = lexer.tokenize().size();
+    });
+    report("flat table (after)", input.size(), denseTokens, denseSeconds);
+
+    std::cout << "Speedup: " << std::setprecision(2) << legacySeconds / denseSeconds << "x" << std::endl;
+}
+
+// 等价类压缩表 vs 展开的 [state][256] 表，仅测量 DFA 扫描循环
+void benchmarkByteClasses(const std::string& input) {
+    std::cout << "\n[Byte-class table vs [state][256] table, DFA loop only]" << std::endl;
+
+    // 从等价类表展开出每字节一列的稠密表
+    static DFAStateId expanded[DFA_STATE_COUNT][256];
+    for (int state = 0; state < DFA_STATE_COUNT; ++state) {
+        for (int symbol = 0; symbol < 256; ++symbol) {
+            expanded[state][symbol] = DFA_TRANSITION_TABLE[state][DFA_CHAR_CLASS[symbol]];
+        }
+    }
+    std::cout << "Table size: " << sizeof(expanded) << " bytes -> "
+        << sizeof(DFA_TRANSITION_TABLE) + sizeof(DFA_CHAR_CLASS) << " bytes" << std::endl;
+
+    // 以最长匹配方式扫描整个输入，返回令牌数
+    auto scan = [&](auto&& step) {
+        std::size_t tokens = 0;
+        std::size_t pos = 0;
+        while (pos < input.size()) {
+            int state = DFA_START_STATE;
+            std::size_t begin = pos;
+            while (pos < input.size()) {
+                int next = step(state, static_cast<unsigned char>(input[pos]));
+                if (next == DFA_DEAD_STATE) {
+                    break;
+                }
+                state = next;
+                pos++;
+            }
+            if (pos == begin) {
+                pos++; // 空白或未知字符
+            }
+            else {
+                tokens++;
+            }
+        }
+        return tokens;
+    };
+
+    std::size_t tokens = 0;
+    double expandedSeconds = measureSeconds([&]() {
+        tokens = scan([&](int state, unsigned char c) { return static_cast<int>(expanded[state][c]); });
+    });
+    report("[state][256]", input.size(), tokens, expandedSeconds);
+
+    double classSeconds = measureSeconds([&]() {
+        tokens = scan([&](int state, unsigned char c) { return static_cast<int>(DFA_TRANSITION_TABLE[state][DFA_CHAR_CLASS[c]]); });
+    });
+    report("[state][class] + class map", input.size(), tokens, classSeconds);
+}
+
+// 向量化空白跳过：分别强制使用各指令集级别，逐个取令牌直到结尾
+void benchmarkWhitespace(std::size_t bytes) {
+    std::cout << "\n[Whitespace skipping, heavily indented input]" << std::endl;
+
+    std::string input = makeIndentedInput(bytes, 24);
+    SIMDLevel detected = detectSIMDLevel();
+    std::cout << "Detected SIMD level: " << simdLevelToString(detected) << std::endl;
+
+    double scalarSeconds = 0.0;
+    for (SIMDLevel level : { SIMDLevel::SCALAR, SIMDLevel::SSE2, SIMDLevel::AVX2 }) {
+        if (static_cast<int>(level) > static_cast<int>(detected)) {
+            continue;
+        }
+        setActiveSIMDLevel(level);
+        std::size_t tokens = 0;
+        double seconds = measureSeconds([&]() {
+            Lexer lexer(input);
+            while (lexer.nextToken().type != TokenType::EOF_TOKEN) {
+                tokens++;
+            }
+        });
+        report("nextToken loop, " + simdLevelToString(level), input.size(), tokens, seconds);
+        if (level == SIMDLevel::SCALAR) {
+            scalarSeconds = seconds;
+        }
+        else {
+            std::cout << "Speedup over scalar: " << std::setprecision(2) << scalarSeconds / seconds << "x" << std::endl;
+        }
+    }
+    setActiveSIMDLevel(detected);
+}
+
+// 块注释跳过：旧的逐字节扫描 vs memchr / SSE2 / AVX2 查找 "*/"
+void benchmarkComments(std::size_t bytes) {
+    std::cout << "\n[Block comment skipping, comment-dense input]" << std::endl;
+
+    std::string input = makeCommentInput(bytes);
+    SIMDLevel detected = detectSIMDLevel();
+
+    // 只测量注释扫描本身：依次定位每个 "/*"，再查找对应的 "*/"
+    auto scanAll = [&](auto&& skip) {
+        std::size_t comments = 0;
+        std::size_t pos = input.find("/*");
+        while (pos != std::string::npos) {
+            pos = skip(pos + 2);
+            comments++;
+            pos = input.find("/*", pos);
+        }
+        return comments;
+    };
+
+    std::size_t comments = 0;
+    double byteSeconds = measureSeconds([&]() {
+        // 旧实现：逐字节检查 '*' 与下一字节
+        comments = scanAll([&](std::size_t pos) {
+            while (pos + 1 < input.size()) {
+                if (input[pos] == '*' && input[pos + 1] == '/') {
+                    return pos + 2;
+                }
+                pos++;
+            }
+            return input.size();
+        });
+    });
+    report("per-byte scan (before)", input.size(), comments, byteSeconds);
+
+    for (SIMDLevel level : { SIMDLevel::SCALAR, SIMDLevel::SSE2, SIMDLevel::AVX2 }) {
+        if (static_cast<int>(level) > static_cast<int>(detected)) {
+            continue;
+        }
+        double seconds = measureSeconds([&]() {
+            comments = scanAll([&](std::size_t pos) {
+                std::size_t end = scanTerminator(input, pos, modeTerminator(DFA_MODE_COMMENT), level);
+                return end == std::string::npos ? input.size() : end;
+            });
+        });
+        std::string name = level == SIMDLevel::SCALAR ? "memchr + memcmp" : simdLevelToString(level) + " two-byte match";
+        report(name, input.size(), comments, seconds);
+    }
+
+    // 注释模式的表驱动扫描：注释正文与结束符都是注释模式 DFA 的令牌，逐个做最长匹配直到进入初始模式
+    double modeSeconds = measureSeconds([&]() {
+        comments = scanAll([&](std::size_t pos) {
+            while (pos < input.size()) {
+                MunchResult match = MaximalMunch<GeneratedModeDFA<DFA_MODE_COMMENT>>::match(input, pos, nullptr);
+                pos = match.end;
+                if (DFA_TOKEN_NEXT_MODE[DFA_MODE_TABLES[DFA_MODE_COMMENT].acceptKind[match.acceptState]] == DFA_MODE_INITIAL) {
+                    break;
+                }
+            }
+            return pos;
+        });
+    });
+    report("comment mode DFA table", input.size(), comments, modeSeconds);
+
+    std::size_t tokens = 0;
+    double lexSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        while (lexer.nextToken().type != TokenType::EOF_TOKEN) {
+            tokens++;
+        }
+    });
+    report("nextToken loop, " + simdLevelToString(detected), input.size(), tokens, lexSeconds);
+}
+
+// 行首偏移索引：一次 memchr 扫描建立，之后按需二分查找行列号
+void benchmarkLineIndex(const std::string& input) {
+    std::cout << "\n[Newline index build]" << std::endl;
+
+    std::size_t lines = 0;
+    double seconds = measureSeconds([&]() {
+        LineIndex index(input);
+        lines = index.getLineCount();
+    });
+    std::cout << std::left << std::setw(32) << "memchr newline scan"
+        << std::right << std::fixed << std::setprecision(1)
+        << std::setw(10) << static_cast<double>(input.size()) / (1024.0 * 1024.0) / seconds << " MB/s"
+        << std::setw(12) << lines << " lines" << std::endl;
+}
+
+// 关键字识别：旧的 std::unordered_set<std::string> vs 生成的完美哈希
+void benchmarkKeywords(const std::string& input) {
+    std::cout << "\n[Keyword lookup on identifier-like tokens]" << std::endl;
+
+    std::vector<std::string_view> words;
+    Lexer lexer(input);
+    for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+        if (token.type == TokenType::IDENTIFIER || token.type == TokenType::KEYWORD) {
+            words.push_back(lexer.text(token));
+        }
+    }
+
+    static const std::unordered_set<std::string> keywords = {
+        "if", "else", "while", "for", "return", "int", "float", "char", "string",
+        "bool", "true", "false", "read", "write"
+    };
+    std::size_t hits = 0;
+    double setSeconds = measureSeconds([&]() {
+        for (std::string_view word : words) {
+            // 旧实现以 std::string 查找，每次都要构造临时字符串
+            hits += keywords.count(std::string(word));
+        }
+    });
+    report("unordered_set<string> (before)", input.size(), words.size(), setSeconds);
+
+    std::size_t perfectHits = 0;
+    double hashSeconds = measureSeconds([&]() {
+        for (std::string_view word : words) {
+            perfectHits += lookupKeyword(word) != KeywordId::NONE;
+        }
+    });
+    report("perfect hash (after)", input.size(), words.size(), hashSeconds);
+
+    std::cout << "Keywords found: " << hits << " / " << perfectHits << std::endl;
+}
+
+// std::vector<Token> vs 结构数组令牌流：内存占用与令牌速率
+void benchmarkTokenStream(const std::string& input) {
+    std::cout << "\n[Token storage: std::vector<Token> vs TokenStream]" << std::endl;
+
+    std::size_t vectorTokens = 0;
+    std::size_t vectorBytes = 0;
+    double vectorSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        std::vector<Token> tokens = lexer.tokenize();
+        vectorTokens = tokens.size();
+        vectorBytes = tokens.capacity() * sizeof(Token);
+    });
+    report("std::vector<Token> (before)", input.size(), vectorTokens, vectorSeconds);
+
+    std::size_t streamTokens = 0;
+    std::size_t streamBytes = 0;
+    double streamSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        TokenStream tokens = lexer.tokenizeStream();
+        streamTokens = tokens.size();
+        streamBytes = tokens.memoryBytes();
+    });
+    report("TokenStream (after)", input.size(), streamTokens, streamSeconds);
+
+    std::cout << "Token layout: " << sizeof(LegacyToken) << " bytes (std::string value, line, column, position) -> "
+        << sizeof(Token) << " bytes (offset, length, payload, kind), "
+        << vectorTokens * sizeof(LegacyToken) / 1024 << " KB -> " << vectorTokens * sizeof(Token) / 1024 << " KB" << std::endl;
+    std::cout << "Memory: " << vectorBytes / 1024 << " KB (" << sizeof(Token) << " bytes/token) -> "
+        << streamBytes / 1024 << " KB (" << std::setprecision(2)
+        << static_cast<double>(streamBytes) / static_cast<double>(streamTokens) << " bytes/token incl. reserve)" << std::endl;
+}
+
+// 多线程分块词法分析：1 到 64 个线程的扩展性，并校验结果与串行分析一致
+void benchmarkParallel(const std::string& input) {
+    std::cout << "\n[Parallel chunked lexing, hardware threads: " << std::thread::hardware_concurrency() << "]" << std::endl;
+
+    // 混入跨多行的块注释，使部分块从注释内部开始
+    std::string mixed;
+    mixed.reserve(input.size() + input.size() / 8);
+    std::size_t lineCount = 0;
+    for (std::size_t lineStart = 0; lineStart < input.size();) {
+        std::size_t lineEnd = input.find('\n', lineStart);
+        lineEnd = lineEnd == std::string::npos ? input.size() : lineEnd + 1;
+        if (++lineCount % 5000 == 0) {
+            mixed += LICENSE_COMMENT;
+        }
+        mixed.append(input, lineStart, lineEnd - lineStart);
+        lineStart = lineEnd;
+    }
+
+    TokenStream serial;
+    double serialSeconds = measureSeconds([&]() {
+        Lexer lexer(mixed);
+        serial = lexer.tokenizeStream();
+    });
+    report("serial tokenizeStream", mixed.size(), serial.size(), serialSeconds);
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+        TokenStream tokens;
+        std::size_t chunks = 0;
+        double seconds = measureSeconds([&]() {
+            ParallelLexer lexer(mixed, threads);
+            tokens = lexer.tokenizeStream();
+            chunks = lexer.getChunkCount();
+        });
+
+        bool identical = tokens.size() == serial.size();
+        for (std::size_t index = 0; identical && index < tokens.size(); ++index) {
+            identical = tokens.kind(index) == serial.kind(index) &&
+                tokens.offset(index) == serial.offset(index) &&
+                tokens.length(index) == serial.length(index);
+        }
+
+        report("parallel " + std::to_string(threads) + " threads, " + std::to_string(chunks) + " chunks",
+            mixed.size(), tokens.size(), seconds);
+        std::cout << "    speedup " << std::setprecision(2) << serialSeconds / seconds << "x, "
+            << (identical ? "identical to serial" : "MISMATCH") << std::endl;
+    }
+}
+
+// 流式词法分析：不同缓冲区大小下的吞吐量与峰值缓冲区
+void benchmarkStreaming(const std::string& input) {
+    std::cout << "\n[Streaming lexer over std::istream]" << std::endl;
+
+    std::size_t serialTokens = 0;
+    double serialSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            ++serialTokens;
+        }
+    });
+    report("whole-buffer Lexer", input.size(), serialTokens, serialSeconds);
+
+    for (std::size_t bufferSize : { std::size_t(4 * 1024), std::size_t(64 * 1024), std::size_t(1024 * 1024) }) {
+        std::istringstream stream(input);
+        StreamLexer lexer(stream, bufferSize);
+        std::size_t tokens = 0;
+        double seconds = measureSeconds([&]() {
+            for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+                ++tokens;
+            }
+        });
+        report("StreamLexer " + std::to_string(bufferSize / 1024) + " KB buffer", input.size(), tokens, seconds);
+        std::cout << "    peak buffer " << lexer.getBufferCapacity() / 1024 << " KB, "
+            << lexer.getRefillCount() << " refills"
+            << (tokens == serialTokens ? "" : ", TOKEN COUNT MISMATCH") << std::endl;
+    }
+}
+
+// 向前查看缓冲区：先查看再消费的调用方式下省去的 DFA 运行次数
+void benchmarkLookahead(const std::string& input) {
+    std::cout << "\n[Lookahead ring buffer: peek then consume]" << std::endl;
+
+    for (std::size_t depth : { std::size_t(1), std::size_t(2), std::size_t(4) }) {
+        Lexer lexer(input);
+        lexer.setLookaheadDepth(depth);
+        std::size_t tokens = 0;
+        double seconds = measureSeconds([&]() {
+            // 每次消费前查看全部 depth 个令牌，模拟需要多个向前查看令牌的语法分析器
+            while (true) {
+                for (std::size_t index = 0; index < depth; ++index) {
+                    lexer.peek(index);
+                }
+                if (lexer.peek().type == TokenType::EOF_TOKEN) {
+                    break;
+                }
+                lexer.consume();
+                ++tokens;
+            }
+        });
+        report("peek(0.." + std::to_string(depth - 1) + ") + consume", input.size(), tokens, seconds);
+        std::cout << "    DFA runs " << lexer.getDFARuns() << ", saved " << lexer.getDFARunsSaved()
+            << " (re-lexing peeks would run " << lexer.getDFARuns() + lexer.getDFARunsSaved() << ")" << std::endl;
+    }
+}
+
+// 表格化最长匹配：(a|b)*ab 遇到全是 'a' 的输入时，每个位置都要扫描到输入结尾才失败
+void benchmarkMaximalMunch(const std::string& input) {
+    std::cout << "\n[Maximal munch on (a|b)*ab, input \"aaa...a\"]" << std::endl;
+
+    for (std::size_t bytes = 4 * 1024; bytes <= 32 * 1024; bytes *= 2) {
+        std::string pathological(bytes, 'a');
+
+        std::size_t plainTokens = 0;
+        double plainSeconds = measureSeconds([&]() {
+            plainTokens = munchTokenize(pathological, nullptr);
+        });
+
+        std::size_t memoTokens = 0;
+        MunchMemo memo(Pathological::DFA_STATE_COUNT, pathological.size());
+        double memoSeconds = measureSeconds([&]() {
+            memoTokens = munchTokenize(pathological, &memo);
+        });
+
+        std::cout << std::setw(6) << bytes / 1024 << " KB: plain " << std::setw(10) << std::setprecision(3)
+            << plainSeconds * 1e9 / static_cast<double>(bytes) << " ns/byte, tabulating "
+            << std::setw(8) << memoSeconds * 1e9 / static_cast<double>(bytes) << " ns/byte"
+            << (plainTokens == memoTokens ? "" : ", TOKEN COUNT MISMATCH") << std::endl;
+    }
+
+    // 正常输入上的开销（当前规则的回退至多一个字节，表格化无从剪枝）
+    std::size_t plainTokens = 0;
+    double plainSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            ++plainTokens;
+        }
+    });
+    report("Lexer, plain munch", input.size(), plainTokens, plainSeconds);
+
+    std::size_t memoTokens = 0;
+    double memoSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        lexer.setTabulatingMunch(true);
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            ++memoTokens;
+        }
+    });
+    report("Lexer, tabulating munch", input.size(), memoTokens, memoSeconds);
+}
+
+// 直接编码 vs 查表：相同的跳过空白 + 最长匹配主循环，只替换匹配函数
+void benchmarkDirectCoded(const std::string& input) {
+    std::cout << "\n[DFA engines: transition table vs direct-coded vs shuffle]" << std::endl;
+
+    auto scanAll = [&](auto&& match) {
+        std::size_t tokens = 0;
+        std::size_t position = scanWhitespace(input, 0);
+        while (position < input.size()) {
+            MunchResult result = match(position);
+            position = scanWhitespace(input, result.acceptState >= 0 ? result.end : position + 1);
+            ++tokens;
+        }
+        return tokens;
+    };
+
+    std::size_t tableTokens = 0;
+    double tableSeconds = measureSeconds([&]() {
+        tableTokens = scanAll([&](std::size_t start) {
+            return MaximalMunch<GeneratedDFA>::match(input, start, nullptr);
+        });
+    });
+    report("transition table", input.size(), tableTokens, tableSeconds);
+
+    std::size_t directTokens = 0;
+    double directSeconds = measureSeconds([&]() {
+        directTokens = scanAll([&](std::size_t start) {
+            std::size_t end = start;
+            int acceptState = matchDirectCoded(input, start, end);
+            return MunchResult{ acceptState, end };
+        });
+    });
+    report("direct-coded", input.size(), directTokens, directSeconds);
+
+    std::size_t shuffleTokens = 0;
+    double shuffleSeconds = measureSeconds([&]() {
+        shuffleTokens = scanAll([&](std::size_t start) {
+            return matchShuffleDFA(input, start);
+        });
+    });
+    report(isShuffleDFASupported() ? "shuffle DFA (pshufb)" : "shuffle DFA (unsupported, table)", input.size(), shuffleTokens, shuffleSeconds);
+
+    std::cout << "Speedup: direct-coded " << std::setprecision(2) << tableSeconds / directSeconds
+        << "x, shuffle " << tableSeconds / shuffleSeconds << "x"
+        << (tableTokens == directTokens && tableTokens == shuffleTokens ? "" : ", TOKEN COUNT MISMATCH") << std::endl;
+
+    // 16 个起始状态同时运行：每 4KB 块计算一次完整的状态映射
+    const std::size_t BLOCK_SIZE = 4096;
+    std::uint8_t blockStates[16] = {};
+    double blockSeconds = measureSeconds([&]() {
+        for (std::size_t offset = 0; offset < input.size(); offset += BLOCK_SIZE) {
+            runShuffleDFABlock(std::string_view(input).substr(offset, BLOCK_SIZE), blockStates);
+        }
+    });
+    std::cout << std::left << std::setw(32) << "shuffle block, 16 start states" << std::right << std::fixed
+        << std::setprecision(1) << std::setw(10) << static_cast<double>(input.size()) / (1024.0 * 1024.0) / blockSeconds
+        << " MB/s" << std::endl;
+}
+
+// 交错多路批量分析：把输入切成大量小文件，比较逐个分析与多条通道交错分析
+void benchmarkBatch(const std::string& input) {
+    std::cout << "\n[Interleaved batch lexing of small files]" << std::endl;
+
+    // 在换行符处切成 512B 到 4KB 不等的"文件"
+    std::vector<std::string_view> files;
+    std::string_view whole(input);
+    std::size_t fileStart = 0;
+    for (std::size_t index = 0; fileStart < whole.size(); ++index) {
+        std::size_t target = std::min(whole.size(), fileStart + 512 + (index * 1237) % 3584);
+        std::size_t fileEnd = whole.find('\n', target);
+        fileEnd = fileEnd == std::string_view::npos ? whole.size() : fileEnd + 1;
+        files.push_back(whole.substr(fileStart, fileEnd - fileStart));
+        fileStart = fileEnd;
+    }
+
+    std::size_t serialTokens = 0;
+    double serialSeconds = measureSeconds([&]() {
+        for (std::string_view file : files) {
+            Lexer lexer{ std::string(file) };
+            serialTokens += lexer.tokenizeStream().size();
+        }
+    });
+    report("Lexer per file (" + std::to_string(files.size()) + " files)", input.size(), serialTokens, serialSeconds);
+
+    std::vector<BatchResult> baseline;
+    double oneLaneSeconds = 0;
+    for (std::size_t lanes : { std::size_t(1), std::size_t(2), std::size_t(4), std::size_t(6), std::size_t(8) }) {
+        BatchLexer lexer(files, lanes);
+        std::vector<BatchResult> results;
+        double seconds = measureSeconds([&]() {
+            results = lexer.tokenizeStreams();
+        });
+
+        std::size_t tokens = 0;
+        bool identical = true;
+        for (std::size_t file = 0; file < results.size(); ++file) {
+            const TokenStream& stream = results[file].tokens;
+            tokens += stream.size();
+            if (lanes == 1) {
+                continue;
+            }
+            const TokenStream& expected = baseline[file].tokens;
+            identical = identical && stream.size() == expected.size();
+            for (std::size_t index = 0; identical && index < stream.size(); ++index) {
+                identical = stream.kind(index) == expected.kind(index) &&
+                    stream.offset(index) == expected.offset(index) &&
+                    stream.length(index) == expected.length(index);
+            }
+        }
+        if (lanes == 1) {
+            baseline = std::move(results);
+            oneLaneSeconds = seconds;
+        }
+
+        report("BatchLexer " + std::to_string(lanes) + (lanes == 1 ? " lane" : " lanes"), input.size(), tokens, seconds);
+        std::cout << "    speedup " << std::setprecision(2) << serialSeconds / seconds << "x vs Lexer, "
+            << oneLaneSeconds / seconds << "x vs 1 lane"
+            << (tokens == serialTokens && identical ? "" : ", MISMATCH") << std::endl;
+    }
+}
+
+// 标识符驻留：每次出现各自持有 std::string（旧 AST 节点的做法） vs 驻留为符号编号，
+// 比较内存与按名称查找所有引用的速度。输入使用超出短字符串优化长度的标识符
+void benchmarkInterning(std::size_t bytes) {
+    std::cout << "\n[Identifier interning, identifier-heavy input]" << std::endl;
+
+    const std::size_t distinctNames = 4096;
+    auto nameOf = [](std::size_t index) { return "accumulatedValue" + std::to_string(index); };
+    std::string input = "{\n";
+    for (std::size_t statement = 0; input.size() < bytes; ++statement) {
+        input += "    " + nameOf(statement % distinctNames) + " = " + nameOf(statement * 7 % distinctNames) +
+            " + " + nameOf(statement * 13 % distinctNames) + ";\n";
+    }
+    input += "}\n";
+
+    std::vector<std::string_view> occurrences;
+    Lexer lexer(input);
+    double lexSeconds = measureSeconds([&]() {
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            if (token.type == TokenType::IDENTIFIER) {
+                occurrences.push_back(lexer.text(token));
+            }
+        }
+    });
+    report("Lexer with interning", input.size(), occurrences.size(), lexSeconds);
+
+    std::vector<std::string> copies;
+    std::size_t copyBytes = 0;
+    double copySeconds = measureSeconds([&]() {
+        copies.reserve(occurrences.size());
+        for (std::string_view name : occurrences) {
+            copies.emplace_back(name);
+        }
+    });
+    for (const std::string& name : copies) {
+        copyBytes += sizeof(std::string) + (name.capacity() > 15 ? name.capacity() + 1 : 0);
+    }
+    report("std::string per use (before)", input.size(), copies.size(), copySeconds);
+
+    StringInterner interner;
+    std::vector<SymbolId> symbols;
+    double internSeconds = measureSeconds([&]() {
+        symbols.reserve(occurrences.size());
+        for (std::string_view name : occurrences) {
+            symbols.push_back(interner.intern(name));
+        }
+    });
+    report("StringInterner (after)", input.size(), symbols.size(), internSeconds);
+
+    // 查找某个名称的全部引用
+    std::string target = nameOf(distinctNames / 2);
+    std::size_t stringHits = 0;
+    double stringCompare = measureSeconds([&]() {
+        for (int repeat = 0; repeat < 8; ++repeat) {
+            for (const std::string& name : copies) {
+                stringHits += name == target;
+            }
+        }
+    });
+    SymbolId targetSymbol = interner.find(target);
+    std::size_t symbolHits = 0;
+    double symbolCompare = measureSeconds([&]() {
+        for (int repeat = 0; repeat < 8; ++repeat) {
+            for (SymbolId symbol : symbols) {
+                symbolHits += symbol == targetSymbol;
+            }
+        }
+    });
+
+    std::size_t internBytes = interner.memoryBytes() + symbols.capacity() * sizeof(SymbolId);
+    std::cout << "Distinct names: " << interner.size() << " (lexer table: " << lexer.getSymbols()->size() << "), uses: "
+        << occurrences.size() << std::endl;
+    std::cout << "Memory: " << copyBytes / 1024 << " KB -> " << internBytes / 1024 << " KB" << std::endl;
+    std::cout << "Find all uses x8: string == " << std::setprecision(2) << stringCompare * 1e3 << " ms, symbol == "
+        << symbolCompare * 1e3 << " ms (" << stringHits << " / " << symbolHits << " hits)" << std::endl;
+}
+
+// 数字字面量转换：每次取值都 std::stoll 一遍（旧 NumberLiteralNode 的做法） vs std::from_chars vs 8 位一组的 SWAR 解析
+void benchmarkNumbers() {
+    std::cout << "\n[Numeric literal conversion, 1 to 19 digits]" << std::endl;
+
+    std::vector<std::string> literals;
+    std::uint64_t seed = 88172645463325252ULL;
+    std::size_t bytes = 0;
+    for (std::size_t index = 0; index < (1u << 20); ++index) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        std::string digits = std::to_string(seed % 9000000000000000000ULL);
+        literals.push_back(digits.substr(0, 1 + index % digits.size()));
+        bytes += literals.back().size();
+    }
+
+    std::uint64_t stollSum = 0;
+    double stollSeconds = measureSeconds([&]() {
+        for (const std::string& literal : literals) {
+            stollSum += static_cast<std::uint64_t>(std::stoll(literal));
+        }
+    });
+    report("std::stoll (before)", bytes, literals.size(), stollSeconds);
+
+    std::uint64_t charsSum = 0;
+    double charsSeconds = measureSeconds([&]() {
+        for (const std::string& literal : literals) {
+            std::int64_t value = 0;
+            std::from_chars(literal.data(), literal.data() + literal.size(), value);
+            charsSum += static_cast<std::uint64_t>(value);
+        }
+    });
+    report("std::from_chars", bytes, literals.size(), charsSeconds);
+
+    std::uint64_t swarSum = 0;
+    double swarSeconds = measureSeconds([&]() {
+        for (const std::string& literal : literals) {
+            std::int64_t value = 0;
+            parseDecimal(literal, value);
+            swarSum += static_cast<std::uint64_t>(value);
+        }
+    });
+    report("parseDecimal SWAR (after)", bytes, literals.size(), swarSeconds);
+
+    std::cout << "Sums " << (stollSum == charsSum && charsSum == swarSum ? "match" : "MISMATCH") << std::endl;
+}
+
+// 增量词法分析：模拟逐键输入（在某个位置插入一个字符，下一次编辑再删除），
+// 比较每次编辑后重新分析整个文件与从最近检查点开始的增量分析。只计分析时间，不计编辑文本本身。
+// 间隙移动的代价与相邻两次编辑的距离成正比，因此分别测量随机位置与集中在一处（连续输入）的编辑
+void benchmarkIncremental(const std::string& input) {
+    std::cout << "\n[Incremental re-lexing, single-character edits]" << std::endl;
+
+    std::string text = input.substr(0, std::min<std::size_t>(input.size(), 4 * 1024 * 1024));
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    auto random = [&]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return static_cast<std::size_t>(seed);
+    };
+
+    const std::size_t fullEdits = 20;
+    double fullSeconds = 0;
+    std::size_t fullTokens = 0;
+    for (std::size_t edit = 0; edit < fullEdits; ++edit) {
+        std::size_t position = random() % text.size();
+        text.insert(position, 1, 'q');
+        fullSeconds += measureSeconds([&]() {
+            Lexer lexer(text);
+            fullTokens = lexer.tokenizeStream().size();
+        });
+        text.erase(position, 1);
+    }
+    double fullPerEdit = fullSeconds / fullEdits;
+    std::cout << std::left << std::setw(32) << "full re-lex per edit" << std::right << std::fixed << std::setprecision(1)
+        << std::setw(10) << fullPerEdit * 1e6 << " us/edit" << std::setw(12) << fullTokens << " tokens" << std::endl;
+
+    IncrementalLexer incremental(text);
+    auto runEdits = [&](const std::string& name, std::size_t editCount, auto&& nextPosition) {
+        double seconds = 0;
+        std::size_t relexedBytes = 0;
+        std::size_t relexedTokens = 0;
+        for (std::size_t edit = 0; edit < editCount; edit += 2) {
+            std::size_t position = nextPosition();
+            text.insert(position, 1, 'q');
+            seconds += measureSeconds([&]() { incremental.applyEdit(text, position, 0, 1); });
+            relexedBytes += incremental.getRelexedEnd() - incremental.getRelexedBegin();
+            relexedTokens += incremental.getRelexedTokens();
+            text.erase(position, 1);
+            seconds += measureSeconds([&]() { incremental.applyEdit(text, position, 1, 0); });
+            relexedBytes += incremental.getRelexedEnd() - incremental.getRelexedBegin();
+            relexedTokens += incremental.getRelexedTokens();
+        }
+        double perEdit = seconds / static_cast<double>(editCount);
+        std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << perEdit * 1e6 << " us/edit" << std::setw(12) << incremental.size() << " tokens" << std::endl;
+        std::cout << "    re-lexed " << static_cast<double>(relexedBytes) / static_cast<double>(editCount) << " bytes, "
+            << static_cast<double>(relexedTokens) / static_cast<double>(editCount) << " tokens per edit; speedup "
+            << std::setprecision(0) << fullPerEdit / perEdit << "x" << std::endl;
+    };
+
+    runEdits("IncrementalLexer, random", 2000, [&]() { return random() % text.size(); });
+    std::size_t cursor = text.size() / 2;
+    runEdits("IncrementalLexer, local", 200000, [&]() {
+        cursor = std::min(text.size() - 1, cursor + random() % 64);
+        return cursor;
+    });
+
+    Lexer reference(text);
+    TokenStream expected = reference.tokenizeStream();
+    TokenStream actual = incremental.toStream();
+    bool identical = expected.size() == actual.size();
+    for (std::size_t index = 0; identical && index < expected.size(); ++index) {
+        identical = expected.kind(index) == actual.kind(index) && expected.offset(index) == actual.offset(index) &&
+            expected.length(index) == actual.length(index);
+    }
+    std::cout << "Input " << text.size() << " bytes, " << incremental.getLineCount() << " lines, tokens "
+        << (identical ? "identical to Lexer::tokenizeStream" : "MISMATCH") << std::endl;
+}
+
+// 词法错误路径：每个错误抛出异常、每个未知字节向 std::cerr 输出一行警告 vs 诊断收集器（连续的未知字符合并为一条）
+void benchmarkErrorPath(std::size_t bytes) {
+    std::cout << "\n[Lexical error path, malformed input]" << std::endl;
+
+    std::string input = makeMalformedInput(bytes);
+    NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(&nullBuffer);
+
+    // 异常：捕获后继续调用 nextToken（出错的令牌已被消费），未知字符按 tokenize 的格式逐个警告
+    std::size_t exceptionTokens = 0;
+    std::size_t exceptionReports = 0;
+    double exceptionSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        while (true) {
+            try {
+                Token token = lexer.nextToken();
+                if (token.type == TokenType::EOF_TOKEN) {
+                    break;
+                }
+                ++exceptionTokens;
+                if (token.type == TokenType::UNKNOWN) {
+                    SourceLocation location = lexer.getLocation(token.offset);
+                    std::cerr << "Warning: Unknown character '" << lexer.text(token) << "' at line " << location.line
+                        << ", column " << location.column << std::endl;
+                    ++exceptionReports;
+                }
+            }
+            catch (const LexerException& ex) {
+                std::cerr << ex.getFullMessage() << std::endl;
+                ++exceptionReports;
+            }
+        }
+    });
+    report("exceptions + cerr (before)", input.size(), exceptionTokens, exceptionSeconds);
+
+    // 诊断收集器：容量按上面的报告数一次预留，分析完后一次输出
+    std::size_t diagnosticTokens = 0;
+    std::size_t diagnosticReports = 0;
+    double diagnosticSeconds = measureSeconds([&]() {
+        Lexer lexer(input);
+        LexerDiagnostics diagnostics(exceptionReports);
+        lexer.setDiagnostics(&diagnostics);
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            ++diagnosticTokens;
+        }
+        diagnostics.print(nullStream, lexer.getInput(), lexer.getLineIndex());
+        diagnosticReports = diagnostics.total();
+    });
+    report("diagnostics sink (after)", input.size(), diagnosticTokens, diagnosticSeconds);
+
+    std::cerr.rdbuf(cerrBuffer);
+    std::cout << "Reports: " << exceptionReports << " -> " << diagnosticReports << ", speedup: " << std::setprecision(2)
+        << exceptionSeconds / diagnosticSeconds << "x" << std::endl;
+}
+
+// 剖析引导的状态编号：超出 L1 的大转移表上，按最小化顺序编号与按训练输入的访问次数重新编号的对比
+void benchmarkProfileGuidedOrder(std::size_t bytes) {
+    std::cout << "\n[Profile-guided state order, " << Large::DFA_STATE_COUNT << "-state keyword rule set]" << std::endl;
+
+    std::string input = makeKeywordHeavyInput(bytes, LARGE_MEASURE_SEED);
+    std::size_t defaultRowBytes = sizeof(Large::DFA_TRANSITION_TABLE[0]);
+    std::size_t profiledRowBytes = sizeof(LargeProfiled::DFA_TRANSITION_TABLE[0]);
+    std::cout << "Transition table: " << sizeof(Large::DFA_TRANSITION_TABLE) / 1024 << " KB (" << defaultRowBytes
+        << "-byte rows) -> " << sizeof(LargeProfiled::DFA_TRANSITION_TABLE) / 1024 << " KB (" << profiledRowBytes
+        << "-byte rows)" << std::endl;
+
+    // 测量输入上的实际访问：热点状态行占用的缓存行数
+    DFAProfile defaultProfile = DFAProfile::of<LargeDFA>();
+    DFAProfile profiledProfile = DFAProfile::of<LargeProfiledDFA>();
+    for (std::size_t position = scanWhitespace(input, 0); position < input.size();) {
+        MunchResult match = defaultProfile.match<LargeDFA>(input, position);
+        profiledProfile.match<LargeProfiledDFA>(input, position);
+        position = scanWhitespace(input, match.acceptState >= 0 ? match.end : position + 1);
+    }
+    std::cout << "Cache lines holding the rows of 99% of lookups: " << hotCacheLines<LargeDFA>(defaultProfile, defaultRowBytes)
+        << " -> " << hotCacheLines<LargeProfiledDFA>(profiledProfile, profiledRowBytes) << std::endl;
+
+    std::size_t defaultTokens = 0;
+    std::uint64_t defaultChecksum = 0;
+    double defaultSeconds = measureSeconds([&]() {
+        defaultChecksum = tableTokenize<LargeDFA, Large::DFA_ACCEPT_KIND>(input, defaultTokens);
+    });
+    report("minimization order (before)", input.size(), defaultTokens, defaultSeconds);
+
+    std::size_t profiledTokens = 0;
+    std::uint64_t profiledChecksum = 0;
+    double profiledSeconds = measureSeconds([&]() {
+        profiledChecksum = tableTokenize<LargeProfiledDFA, LargeProfiled::DFA_ACCEPT_KIND>(input, profiledTokens);
+    });
+    report("profile-guided order (after)", input.size(), profiledTokens, profiledSeconds);
+
+    std::cout << "Speedup: " << std::setprecision(2) << defaultSeconds / profiledSeconds << "x"
+        << (defaultChecksum == profiledChecksum ? "" : ", TOKEN MISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // 可选参数：输入大小(MB)，默认 16MB
+    std::size_t megabytes = 16;
+    if (argc > 1) {
+        megabytes = std::stoul(argv[1]);
+    }
+
+    std::string input = makeInput(megabytes * 1024 * 1024);
+    std::cout << "Lexer benchmark, input size: " << input.size() << " bytes" << std::endl;
+
+    benchmarkDenseTable(input);
+    benchmarkByteClasses(input);
+    benchmarkWhitespace(input.size());
+    benchmarkComments(input.size());
+    benchmarkLineIndex(input);
+    benchmarkKeywords(input);
+    benchmarkTokenStream(input);
+    benchmarkParallel(input);
+    benchmarkStreaming(input);
+    benchmarkLookahead(input);
+    benchmarkMaximalMunch(input);
+    benchmarkDirectCoded(input);
+    benchmarkBatch(input);
+    benchmarkInterning(input.size());
+    benchmarkNumbers();
+    benchmarkIncremental(input);
+    benchmarkProfileGuidedOrder(input.size());
+    benchmarkErrorPath(input.size());
+
+    return 0;
+}
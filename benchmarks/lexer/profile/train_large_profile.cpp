@@ -0,0 +1,30 @@
+#include "KeywordHeavyInput.hpp"
+#include "DFAProfile.hpp"
+#include "SIMDScan.hpp"
+#include <iostream>
+#include <string>
+
+using namespace Compiler;
+using namespace Compiler::Benchmark;
+
+// 在训练输入上记录大规则集表（LargeDFA）的剖析文件，构建时由它生成 DFA_Tables_LargeProfiled.hpp 所用的剖析
+// 用法: LargeProfileTrainer <剖析文件>
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <profile file>" << std::endl;
+        return 1;
+    }
+
+    std::string input = makeKeywordHeavyInput(16 * 1024 * 1024, LARGE_TRAINING_SEED);
+    DFAProfile profile = DFAProfile::of<LargeDFA>();
+    for (std::size_t position = scanWhitespace(input, 0); position < input.size();) {
+        MunchResult match = profile.match<LargeDFA>(input, position);
+        position = scanWhitespace(input, match.acceptState >= 0 ? match.end : position + 1);
+    }
+    if (!profile.writeToFile(argv[1])) {
+        std::cerr << "Error: Cannot write DFA profile " << argv[1] << std::endl;
+        return 1;
+    }
+    std::cout << "DFA profile of the large rule set written to " << argv[1] << std::endl;
+    return 0;
+}
@@ -2,10 +2,13 @@
 #define AST_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <iostream>
 #include <sstream>
+#include <cstdint>
+#include "StringInterner.hpp"
 
 namespace Compiler {
 
@@ -63,17 +66,21 @@ namespace Compiler {
     };
 
     // ==================== 程序根节点 ====================
+    // 根节点持有符号驻留表，树中各节点的名称视图指向其中，整棵树可比词法分析器和语法分析器存活更久
     class ProgramNode : public ASTNode {
     private:
         std::shared_ptr<ASTNode> declarations_;
         std::shared_ptr<ASTNode> statements_;
+        std::shared_ptr<const StringInterner> symbols_;
 
     public:
-        ProgramNode(std::shared_ptr<ASTNode> decls, std::shared_ptr<ASTNode> stmts)
-            : ASTNode(ASTNodeType::PROGRAM), declarations_(decls), statements_(stmts) {}
+        ProgramNode(std::shared_ptr<ASTNode> decls, std::shared_ptr<ASTNode> stmts,
+            std::shared_ptr<const StringInterner> symbols = nullptr)
+            : ASTNode(ASTNodeType::PROGRAM), declarations_(decls), statements_(stmts), symbols_(std::move(symbols)) {}
 
         std::shared_ptr<ASTNode> getDeclarations() const { return declarations_; }
         std::shared_ptr<ASTNode> getStatements() const { return statements_; }
+        const std::shared_ptr<const StringInterner>& getSymbols() const { return symbols_; }
 
         void print(std::ostream& os, int indent = 0) const override;
         std::string getNodeTypeName() const override { return "Program"; }
@@ -103,16 +110,18 @@ namespace Compiler {
     class DeclarationNode : public ASTNode {
     private:
         std::string varType_;      // 变量类型 (如 "int")
-        std::string varName_;      // 变量名
+        SymbolId varSymbol_;       // 变量名的符号编号
+        std::string_view varName_; // 变量名（符号驻留表中的视图）
 
     public:
-        DeclarationNode(const std::string& type, const std::string& name,
+        DeclarationNode(const std::string& type, SymbolId symbol, std::string_view name,
             std::size_t line, std::size_t column)
             : ASTNode(ASTNodeType::DECLARATION, line, column),
-            varType_(type), varName_(name) {}
+            varType_(type), varSymbol_(symbol), varName_(name) {}
 
         std::string getVarType() const { return varType_; }
-        std::string getVarName() const { return varName_; }
+        SymbolId getVarSymbol() const { return varSymbol_; }
+        std::string_view getVarName() const { return varName_; }
 
         void print(std::ostream& os, int indent = 0) const override;
         std::string getNodeTypeName() const override { return "Declaration"; }
@@ -237,13 +246,15 @@ namespace Compiler {
     // ==================== Read语句节点 ====================
     class ReadStatementNode : public ASTNode {
     private:
-        std::string varName_;
+        SymbolId varSymbol_;
+        std::string_view varName_;
 
     public:
-        ReadStatementNode(const std::string& name, std::size_t line, std::size_t column)
-            : ASTNode(ASTNodeType::READ_STATEMENT, line, column), varName_(name) {}
+        ReadStatementNode(SymbolId symbol, std::string_view name, std::size_t line, std::size_t column)
+            : ASTNode(ASTNodeType::READ_STATEMENT, line, column), varSymbol_(symbol), varName_(name) {}
 
-        std::string getVarName() const { return varName_; }
+        SymbolId getVarSymbol() const { return varSymbol_; }
+        std::string_view getVarName() const { return varName_; }
 
         void print(std::ostream& os, int indent = 0) const override;
         std::string getNodeTypeName() const override { return "ReadStatement"; }
@@ -288,13 +299,18 @@ namespace Compiler {
     // ==================== 标识符表达式节点 ====================
     class IdentifierNode : public ASTNode {
     private:
-        std::string name_;
+        SymbolId symbol_;
+        std::string_view name_;
 
     public:
-        IdentifierNode(const std::string& name, std::size_t line, std::size_t column)
-            : ASTNode(ASTNodeType::IDENTIFIER_EXPRESSION, line, column), name_(name) {}
+        // 名称是符号驻留表中的视图而不是输入缓冲区中的视图，AST 节点可比词法分析器的输入缓冲区存活更久；
+        // 同名标识符的符号编号相同，比较名称只需比较编号。
+        // 分析过程中运算符和关键字的临时叶子节点不驻留：符号编号为 NO_SYMBOL，名称引用输入缓冲区
+        IdentifierNode(SymbolId symbol, std::string_view name, std::size_t line, std::size_t column)
+            : ASTNode(ASTNodeType::IDENTIFIER_EXPRESSION, line, column), symbol_(symbol), name_(name) {}
 
-        std::string getName() const { return name_; }
+        SymbolId getSymbol() const { return symbol_; }
+        std::string_view getName() const { return name_; }
 
         void print(std::ostream& os, int indent = 0) const override;
         std::string getNodeTypeName() const override { return "Identifier"; }
@@ -303,14 +319,14 @@ namespace Compiler {
     // ==================== 数字字面量节点 ====================
     class NumberLiteralNode : public ASTNode {
     private:
-        std::string value_;
+        std::int64_t value_;
 
     public:
-        NumberLiteralNode(const std::string& val, std::size_t line, std::size_t column)
-            : ASTNode(ASTNodeType::NUMBER_LITERAL, line, column), value_(val) {}
+        // 数值由词法分析器转换（见 Token::payload 与 numberValue()），节点不再保存字面量文本
+        NumberLiteralNode(std::int64_t value, std::size_t line, std::size_t column)
+            : ASTNode(ASTNodeType::NUMBER_LITERAL, line, column), value_(value) {}
 
-        std::string getValue() const { return value_; }
-        int getIntValue() const { return std::stoi(value_); }
+        std::int64_t getValue() const { return value_; }
 
         void print(std::ostream& os, int indent = 0) const override;
         std::string getNodeTypeName() const override { return "NumberLiteral"; }
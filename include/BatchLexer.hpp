@@ -0,0 +1,118 @@
+#pragma once
+
+#ifndef BATCH_LEXER_HPP
+#define BATCH_LEXER_HPP
+
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "Lexer.hpp"
+#include "LexerDiagnostics.hpp"
+#include "TokenStream.hpp"
+
+namespace Compiler {
+
+    // 一个输入的批量分析结果
+    struct BatchResult {
+        // 每个输入最多保存的诊断数，批量任务的输入很多，容量比单个 Lexer 的默认值小
+        static constexpr std::size_t DIAGNOSTIC_CAPACITY = 64;
+
+        TokenStream tokens;                     // 令牌流，出错的文本以 UNKNOWN 令牌留在其中
+        LexerDiagnostics diagnostics{ DIAGNOSTIC_CAPACITY };    // 本输入的全部词法错误，包括未知字符
+        std::optional<LexerException> error;    // 第一个词法错误（未闭合注释、孤立的 "*/" 等，不含未知字符），只记录偏移
+
+        // 词法错误，行列号在调用时由输入计算
+        std::optional<LexerException> getError() const;
+    };
+
+    // 交错多路词法分析器
+    // 单个输入的 DFA 每前进一个字节都要等上一步的查表结果（状态 -> 转移表行 -> 下一状态），
+    // 这条依赖链决定了串行分析的速度。本分析器让若干条通道各自分析一个独立的输入，
+    // 在同一个循环里轮流推进一步，各通道的查表互不依赖，处理器可以重叠它们的访存延迟。
+    // 步进使用由生成的 DFA 推导出的批量转移表：按 [状态][字节] 直接索引，跳过空白、令牌结束后
+    // 重新开始匹配都编码在表项中，循环体没有分支；令牌边界写入通道缓冲区，每轮结束后统一写入令牌流。
+    // 通道分析完一个输入后立即领取下一个，适合一次分析成千上万个小文件的批量校验任务。
+    // 每个输入的令牌流与设置了诊断收集器的 Lexer::tokenizeStream 相同，错误不抛出也不输出警告：
+    // 连续的未知字符合并为一个 UNKNOWN 令牌，孤立的 "*/" 与超出范围的数字作为 UNKNOWN 令牌返回，
+    // 都记录到该输入的 BatchResult::diagnostics 中并继续分析；未闭合的注释记录后本输入结束。
+    // 某个输入出错不影响其他输入，BatchResult::getError 给出第一个错误（带行列号）。
+    class BatchLexer {
+    private:
+        // 通道缓冲的一个令牌，起止位置相对于本轮起点（起点可能在之前的轮中，因此有符号）
+        struct LaneEvent {
+            std::ptrdiff_t start;
+            std::int32_t end;
+            std::int32_t state;     // 令牌结束前的批量转移表状态，决定令牌类型
+        };
+
+        // 每轮最多推进的字节数，也是每条通道最多缓冲的令牌数
+        static constexpr std::size_t EVENT_CAPACITY = 64;
+
+        // 一条通道的分析状态
+        struct Lane {
+            std::size_t input;          // 正在分析的输入下标
+            const char* data;           // 输入数据
+            std::size_t size;           // 输入长度
+            std::size_t base;           // 本轮起点
+            int state;                  // 批量转移表状态
+            std::ptrdiff_t tokenStart;  // 当前令牌起点（相对于本轮起点）
+            std::size_t eventCount;     // 本轮缓冲的令牌数
+            LaneEvent events[EVENT_CAPACITY + 1]; // 每步都写入一格，多出的一格供最后一步写入
+        };
+
+        std::vector<std::string_view> inputs_;
+        std::size_t laneCount_;
+
+        // 让通道领取下一个输入，没有剩余输入时返回 false
+        bool startInput(Lane& lane, std::size_t& nextInput, std::vector<BatchResult>& results) const;
+
+        // 一轮结束后把通道缓冲的令牌写入令牌流，并处理带动作的令牌、'\0' 与输入结尾。
+        // 本输入已分析完或出错时返回 false
+        bool finishRound(Lane& lane, std::size_t steps, std::vector<BatchResult>& results) const;
+
+        // 把令牌 [start, end) 写入 lane.input 的令牌流（识别关键字，检查数字范围），错误记录为诊断
+        void emitToken(Lane& lane, TokenType type, std::size_t start, std::size_t end, std::vector<BatchResult>& results) const;
+
+        // 处理带令牌动作的令牌或孤立的注释结束符 [start, end)（state 为其批量转移表状态），
+        // 之后通道停在令牌进入的模式的结尾。本输入因此结束（包括未闭合的模式）时返回 false
+        bool applyTokenAction(Lane& lane, int state, std::size_t start, std::size_t end, std::vector<BatchResult>& results) const;
+
+        // 在 lane.input 的结果中记录 [position, position + length) 处的错误，并保留第一个错误；
+        // 行列号留到 BatchResult::getError 时计算。可恢复的错误由调用者写入 UNKNOWN 令牌后继续分析
+        void fail(const Lane& lane, LexerErrorKind kind, std::size_t position, std::size_t length,
+            std::vector<BatchResult>& results, int mode = 0) const;
+
+        // LANES 条通道交错分析全部输入，通道数为编译期常量以便展开循环
+        template <std::size_t LANES>
+        void lexLanes(std::vector<BatchResult>& results) const;
+
+        // 规则需要回退时批量转移表不适用，逐个输入串行分析
+        void lexSerial(std::vector<BatchResult>& results) const;
+
+    public:
+        // 最大通道数，超过后通道状态放不进寄存器，收益反而下降
+        static constexpr std::size_t MAX_LANE_COUNT = 8;
+
+        // 默认通道数
+        static constexpr std::size_t DEFAULT_LANE_COUNT = 4;
+
+        // 借用 inputs 中的各个输入，laneCount 取值 1 到 MAX_LANE_COUNT（超出时截断）。
+        // 输入必须比分析器及其结果存活得更久
+        explicit BatchLexer(std::vector<std::string_view> inputs, std::size_t laneCount = DEFAULT_LANE_COUNT);
+
+        BatchLexer(const BatchLexer&) = delete;
+        BatchLexer& operator=(const BatchLexer&) = delete;
+
+        // 令牌化全部输入，结果与输入一一对应
+        std::vector<BatchResult> tokenizeStreams() const;
+
+        std::size_t getLaneCount() const { return laneCount_; }
+        std::size_t getInputCount() const { return inputs_.size(); }
+    };
+
+} // namespace Compiler
+
+#endif // BATCH_LEXER_HPP
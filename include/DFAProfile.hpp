@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef DFA_PROFILE_HPP
+#define DFA_PROFILE_HPP
+
+#include "MaximalMunch.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // DFA 剖析：在训练语料上统计每个状态、每条 (状态, 等价类) 转移被查表的次数，
+    // 写出的剖析文件交给 DFAGenerator --profile，按访问次数重新编号状态使热点行在转移表中连续。
+    // 文件中的状态使用规范编号（从初始状态开始广度优先、转移按字节从小到大访问的顺序），转移用等价类中
+    // 最小的字节表示，因此剖析文件与生成表时的状态编号和等价类编号无关，重新生成后依然有效。
+    // 文件格式（文本，每行一项，# 开头为注释）：
+    //   dfa <状态数>
+    //   state <规范编号> <访问次数>
+    //   transition <规范编号> <字节> <访问次数>
+    class DFAProfile {
+    private:
+        std::size_t classCount_;
+        std::vector<int> canonicalId_;                  // 状态ID -> 规范编号
+        std::vector<int> classByte_;                    // 等价类 -> 其中最小的字节
+        std::vector<std::uint64_t> stateVisits_;        // [状态ID]
+        std::vector<std::uint64_t> transitionVisits_;   // [状态ID * 等价类数 + 等价类]
+
+        // transitions[state * classCount + charClass] -> 目标状态（死状态为负数）
+        DFAProfile(int start, std::size_t stateCount, std::size_t classCount,
+            const std::vector<int>& byteClass, const std::vector<int>& transitions);
+
+    public:
+        // 为一套 DFA 表创建空的剖析；DFA 需提供 START、STATE_COUNT、CLASS_COUNT、
+        // charClass(byte) 和 transition(state, charClass)（见 GeneratedDFA）
+        template <typename DFA>
+        static DFAProfile of() {
+            std::vector<int> byteClass(256);
+            for (int byte = 0; byte < 256; ++byte) {
+                byteClass[byte] = DFA::charClass(static_cast<unsigned char>(byte));
+            }
+            std::vector<int> transitions(static_cast<std::size_t>(DFA::STATE_COUNT) * DFA::CLASS_COUNT);
+            for (int state = 0; state < DFA::STATE_COUNT; ++state) {
+                for (int charClass = 0; charClass < DFA::CLASS_COUNT; ++charClass) {
+                    transitions[static_cast<std::size_t>(state) * DFA::CLASS_COUNT + charClass] = DFA::transition(state, charClass);
+                }
+            }
+            return DFAProfile(DFA::START, DFA::STATE_COUNT, DFA::CLASS_COUNT, byteClass, transitions);
+        }
+
+        // 与 MaximalMunch<DFA>::match(input, start, nullptr) 相同的最长匹配，同时记录每次查表
+        template <typename DFA>
+        MunchResult match(std::string_view input, std::size_t start) {
+            int state = DFA::START;
+            int lastAcceptState = -1;
+            std::size_t lastAcceptPos = start;
+            std::size_t pos = start;
+            while (true) {
+                if (DFA::accepts(state)) {
+                    lastAcceptState = state;
+                    lastAcceptPos = pos;
+                }
+                if (pos >= input.size()) {
+                    break;
+                }
+                int charClass = DFA::charClass(static_cast<unsigned char>(input[pos]));
+                ++stateVisits_[state];
+                ++transitionVisits_[static_cast<std::size_t>(state) * classCount_ + charClass];
+                int nextState = DFA::transition(state, charClass);
+                if (nextState < 0) {
+                    break;
+                }
+                state = nextState;
+                pos++;
+            }
+            return MunchResult{ lastAcceptState, lastAcceptPos };
+        }
+
+        std::uint64_t stateVisits(int state) const { return stateVisits_[state]; }
+        std::uint64_t transitionVisits(int state, int charClass) const {
+            return transitionVisits_[static_cast<std::size_t>(state) * classCount_ + charClass];
+        }
+
+        // 状态的规范编号
+        int canonicalId(int state) const { return canonicalId_[state]; }
+
+        // 清空计数
+        void clear();
+
+        // 写出剖析文件，只写出访问次数不为零的状态和转移；无法写入时返回 false
+        bool writeToFile(const std::string& filePath) const;
+    };
+
+} // namespace Compiler
+
+#endif // DFA_PROFILE_HPP
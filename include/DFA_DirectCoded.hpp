@@ -0,0 +1,132 @@
+#ifndef DFA_DIRECT_CODED_HPP
+#define DFA_DIRECT_CODED_HPP
+
+#include <cstddef>
+#include <string_view>
+#include "DFA_Tables.hpp"
+
+namespace Compiler {
+
+// Direct-coded longest match starting at input[start]: every DFA state is a label and
+// transitions are a switch on the byte class, so no transition table is loaded.
+// Returns the last accepting state ID (DFA_DEAD_STATE if none) and stores the end of that match in end.
+inline int matchDirectCoded(std::string_view input, std::size_t start, std::size_t& end) {
+    const unsigned char* const data = reinterpret_cast<const unsigned char*>(input.data());
+    const unsigned char* const limit = data + input.size();
+    const unsigned char* p = data + start;
+    const unsigned char* acceptEnd = p;
+    int acceptState = DFA_DEAD_STATE;
+
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 1:
+    case 6:
+        ++p;
+        goto state_1;
+    case 2:
+        ++p;
+        goto state_2;
+    case 3:
+        ++p;
+        goto state_3;
+    case 4:
+        ++p;
+        goto state_4;
+    case 5:
+        ++p;
+        goto state_5;
+    case 7:
+        ++p;
+        goto state_6;
+    default:
+        goto done;
+    }
+
+state_1:
+    acceptState = 1; // <comparison_single>
+    acceptEnd = p;
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 6:
+        ++p;
+        goto state_7;
+    default:
+        goto done;
+    }
+
+state_2:
+    acceptState = 2; // <singleword>
+    acceptEnd = p;
+    goto done;
+
+state_3:
+    acceptState = 3; // <singleword>
+    acceptEnd = p;
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 4:
+        ++p;
+        goto state_8;
+    default:
+        goto done;
+    }
+
+state_4:
+    acceptState = 4; // <division>
+    acceptEnd = p;
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 3:
+        ++p;
+        goto state_9;
+    default:
+        goto done;
+    }
+
+state_5:
+    acceptState = 5; // <number>
+    acceptEnd = p;
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 5:
+        ++p;
+        goto state_5;
+    default:
+        goto done;
+    }
+
+state_6:
+    acceptState = 6; // <identifier>
+    acceptEnd = p;
+    if (p == limit) goto done;
+    switch (DFA_CHAR_CLASS[*p]) {
+    case 5:
+    case 7:
+        ++p;
+        goto state_6;
+    default:
+        goto done;
+    }
+
+state_7:
+    acceptState = 7; // <comparison_double>
+    acceptEnd = p;
+    goto done;
+
+state_8:
+    acceptState = 8; // <commentlast>
+    acceptEnd = p;
+    goto done;
+
+state_9:
+    acceptState = 9; // <commentfirst>
+    acceptEnd = p;
+
+done:
+    end = static_cast<std::size_t>(acceptEnd - data);
+    return acceptState;
+}
+
+} // namespace Compiler
+
+#endif // DFA_DIRECT_CODED_HPP
@@ -1,8 +1,7 @@
 #ifndef DFA_TABLES_HPP
 #define DFA_TABLES_HPP
 
-#include <map>
-#include <string>
+#include <cstdint>
 
 namespace Compiler {
 
@@ -12,197 +11,270 @@ constexpr int DFA_START_STATE = 0;
 // DFA states count
 constexpr int DFA_STATE_COUNT = 10;
 
-// DFA transition table: [current state ID][input symbol] -> target state ID
-const std::map<int, std::map<char, int>> DFA_TRANSITION_TABLE = {
-    {0, {
-        {'!', 4},
-        {'(', 8},
-        {')', 8},
-        {'*', 9},
-        {'+', 8},
-        {',', 8},
-        {'-', 8},
-        {'/', 5},
-        {'0', 7},
-        {'1', 7},
-        {'2', 7},
-        {'3', 7},
-        {'4', 7},
-        {'5', 7},
-        {'6', 7},
-        {'7', 7},
-        {'8', 7},
-        {'9', 7},
-        {':', 8},
-        {';', 8},
-        {'<', 4},
-        {'=', 4},
-        {'>', 4},
-        {'A', 6},
-        {'B', 6},
-        {'C', 6},
-        {'D', 6},
-        {'E', 6},
-        {'F', 6},
-        {'G', 6},
-        {'H', 6},
-        {'I', 6},
-        {'J', 6},
-        {'K', 6},
-        {'L', 6},
-        {'M', 6},
-        {'N', 6},
-        {'O', 6},
-        {'P', 6},
-        {'Q', 6},
-        {'R', 6},
-        {'S', 6},
-        {'T', 6},
-        {'U', 6},
-        {'V', 6},
-        {'W', 6},
-        {'X', 6},
-        {'Y', 6},
-        {'Z', 6},
-        {'a', 6},
-        {'b', 6},
-        {'c', 6},
-        {'d', 6},
-        {'e', 6},
-        {'f', 6},
-        {'g', 6},
-        {'h', 6},
-        {'i', 6},
-        {'j', 6},
-        {'k', 6},
-        {'l', 6},
-        {'m', 6},
-        {'n', 6},
-        {'o', 6},
-        {'p', 6},
-        {'q', 6},
-        {'r', 6},
-        {'s', 6},
-        {'t', 6},
-        {'u', 6},
-        {'v', 6},
-        {'w', 6},
-        {'x', 6},
-        {'y', 6},
-        {'z', 6},
-        {'{', 8},
-        {'}', 8}
-    }},
-    {1, {
-
-    }},
-    {2, {
-
-    }},
-    {3, {
-
-    }},
-    {4, {
-        {'=', 3}
-    }},
-    {5, {
-        {'*', 1}
-    }},
-    {6, {
-        {'0', 6},
-        {'1', 6},
-        {'2', 6},
-        {'3', 6},
-        {'4', 6},
-        {'5', 6},
-        {'6', 6},
-        {'7', 6},
-        {'8', 6},
-        {'9', 6},
-        {'A', 6},
-        {'B', 6},
-        {'C', 6},
-        {'D', 6},
-        {'E', 6},
-        {'F', 6},
-        {'G', 6},
-        {'H', 6},
-        {'I', 6},
-        {'J', 6},
-        {'K', 6},
-        {'L', 6},
-        {'M', 6},
-        {'N', 6},
-        {'O', 6},
-        {'P', 6},
-        {'Q', 6},
-        {'R', 6},
-        {'S', 6},
-        {'T', 6},
-        {'U', 6},
-        {'V', 6},
-        {'W', 6},
-        {'X', 6},
-        {'Y', 6},
-        {'Z', 6},
-        {'a', 6},
-        {'b', 6},
-        {'c', 6},
-        {'d', 6},
-        {'e', 6},
-        {'f', 6},
-        {'g', 6},
-        {'h', 6},
-        {'i', 6},
-        {'j', 6},
-        {'k', 6},
-        {'l', 6},
-        {'m', 6},
-        {'n', 6},
-        {'o', 6},
-        {'p', 6},
-        {'q', 6},
-        {'r', 6},
-        {'s', 6},
-        {'t', 6},
-        {'u', 6},
-        {'v', 6},
-        {'w', 6},
-        {'x', 6},
-        {'y', 6},
-        {'z', 6}
-    }},
-    {7, {
-        {'0', 7},
-        {'1', 7},
-        {'2', 7},
-        {'3', 7},
-        {'4', 7},
-        {'5', 7},
-        {'6', 7},
-        {'7', 7},
-        {'8', 7},
-        {'9', 7}
-    }},
-    {8, {
-
-    }},
-    {9, {
-        {'/', 2}
-    }}
-};
-
-// DFA accept states table: [state ID] -> Token name
-const std::map<int, std::string> DFA_ACCEPT_STATES = {
-    {1, "<commentfirst>"},
-    {2, "<commentlast>"},
-    {3, "<comparison_double>"},
-    {4, "<comparison_single>"},
-    {5, "<division>"},
-    {6, "<identifier>"},
-    {7, "<number>"},
-    {8, "<singleword>"},
-    {9, "<singleword>"}
+// Dead state sentinel: no transition on the input byte
+constexpr int DFA_DEAD_STATE = -1;
+
+// Storage type of a state ID in the transition table
+using DFAStateId = std::int8_t;
+
+// Number of input byte equivalence classes
+constexpr int DFA_CLASS_COUNT = 8;
+
+// Entries per transition table row (DFA_CLASS_COUNT, or more when rows are padded to cache line boundaries)
+constexpr int DFA_ROW_STRIDE = 8;
+
+// Input byte -> equivalence class ID (bytes of one class behave identically in every state)
+//   class 0: 0x00-0x20 '"'-''' '.' '?'-'@' '['-'`' '|' '~'-0xff
+//   class 1: '!' '<' '>'
+//   class 2: '('-')' '+'-'-' ':'-';' '{' '}'
+//   class 3: '*'
+//   class 4: '/'
+//   class 5: '0'-'9'
+//   class 6: '='
+//   class 7: 'A'-'Z' 'a'-'z'
+constexpr std::uint8_t DFA_CHAR_CLASS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 0, 0, 0, 0, 0, 2, 2, 3, 2, 2, 2, 0, 4,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 1, 6, 1, 0,
+    0, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 0, 0, 0, 0, 0,
+    0, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 2, 0, 2, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// DFA transition table: [current state ID][byte class] -> target state ID
+alignas(64) constexpr DFAStateId DFA_TRANSITION_TABLE[DFA_STATE_COUNT][DFA_ROW_STRIDE] = {
+    { -1, 1, 2, 3, 4, 5, 1, 6 }, // state 0
+    { -1, -1, -1, -1, -1, -1, 7, -1 }, // state 1
+    { -1, -1, -1, -1, -1, -1, -1, -1 }, // state 2
+    { -1, -1, -1, -1, 8, -1, -1, -1 }, // state 3
+    { -1, -1, -1, 9, -1, -1, -1, -1 }, // state 4
+    { -1, -1, -1, -1, -1, 5, -1, -1 }, // state 5
+    { -1, -1, -1, -1, -1, 6, -1, 6 }, // state 6
+    { -1, -1, -1, -1, -1, -1, -1, -1 }, // state 7
+    { -1, -1, -1, -1, -1, -1, -1, -1 }, // state 8
+    { -1, -1, -1, -1, -1, -1, -1, -1 } // state 9
+};
+
+// Token kinds: one per rule in priority order (highest first), DFA_TOKEN_NONE for non-accepting states
+enum DFATokenKind : std::uint8_t {
+    DFA_TOKEN_NONE = 0,
+    DFA_TOKEN_COMMENTEND = 1, // <commentend>
+    DFA_TOKEN_COMMENTFIRST = 2, // <commentfirst>
+    DFA_TOKEN_COMMENTLAST = 3, // <commentlast>
+    DFA_TOKEN_COMMENTTEXT = 4, // <commenttext>
+    DFA_TOKEN_COMPARISON_DOUBLE = 5, // <comparison_double>
+    DFA_TOKEN_COMPARISON_SINGLE = 6, // <comparison_single>
+    DFA_TOKEN_DIVISION = 7, // <division>
+    DFA_TOKEN_SINGLEWORD = 8, // <singleword>
+    DFA_TOKEN_NUMBER = 9, // <number>
+    DFA_TOKEN_IDENTIFIER = 10 // <identifier>
+};
+
+// Token kinds count (including DFA_TOKEN_NONE)
+constexpr int DFA_TOKEN_KIND_COUNT = 11;
+
+// Token kind -> rule name (for diagnostics)
+constexpr const char* DFA_TOKEN_NAMES[DFA_TOKEN_KIND_COUNT] = {
+    nullptr,
+    "<commentend>",
+    "<commentfirst>",
+    "<commentlast>",
+    "<commenttext>",
+    "<comparison_double>",
+    "<comparison_single>",
+    "<division>",
+    "<singleword>",
+    "<number>",
+    "<identifier>"
+};
+
+// DFA accept states table: [state ID] -> token kind (DFA_TOKEN_NONE if not accepting)
+constexpr DFATokenKind DFA_ACCEPT_KIND[DFA_STATE_COUNT] = {
+    DFA_TOKEN_NONE, // state 0
+    DFA_TOKEN_COMPARISON_SINGLE, // state 1
+    DFA_TOKEN_SINGLEWORD, // state 2
+    DFA_TOKEN_SINGLEWORD, // state 3
+    DFA_TOKEN_DIVISION, // state 4
+    DFA_TOKEN_NUMBER, // state 5
+    DFA_TOKEN_IDENTIFIER, // state 6
+    DFA_TOKEN_COMPARISON_DOUBLE, // state 7
+    DFA_TOKEN_COMMENTLAST, // state 8
+    DFA_TOKEN_COMMENTFIRST // state 9
+};
+
+// DFA acceleration table: [state ID] -> { escape byte count, escape bytes... } for states that loop back
+// to themselves on every other byte (the run up to the next escape byte can be skipped at once); { 0 } otherwise
+constexpr std::uint8_t DFA_ACCEL[DFA_STATE_COUNT][4] = {
+    { 0 }, // state 0
+    { 0 }, // state 1
+    { 0 }, // state 2
+    { 0 }, // state 3
+    { 0 }, // state 4
+    { 0 }, // state 5
+    { 0 }, // state 6
+    { 0 }, // state 7
+    { 0 }, // state 8
+    { 0 } // state 9
+};
+
+// Shuffle DFA (pshufb): lane s of DFA_SHUFFLE_TABLE[byte class] is the target state of state s,
+// DFA_SHUFFLE_DEAD if there is no transition. Only usable when DFA_SHUFFLE_AVAILABLE (at most 16 states).
+constexpr bool DFA_SHUFFLE_AVAILABLE = true;
+constexpr std::uint8_t DFA_SHUFFLE_DEAD = 0x80;
+constexpr std::uint16_t DFA_SHUFFLE_ACCEPT_MASK = 0x3fe;
+alignas(16) constexpr std::uint8_t DFA_SHUFFLE_TABLE[DFA_CLASS_COUNT][16] = {
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 0
+    { 1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 1
+    { 2, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 2
+    { 3, 0x80, 0x80, 0x80, 9, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 3
+    { 4, 0x80, 0x80, 8, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 4
+    { 5, 0x80, 0x80, 0x80, 0x80, 5, 6, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 5
+    { 1, 7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 }, // class 6
+    { 6, 0x80, 0x80, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 } // class 7
+};
+
+// ---- Lexer mode comment ----
+
+constexpr int DFA_COMMENT_START_STATE = 0;
+constexpr int DFA_COMMENT_STATE_COUNT = 5;
+constexpr int DFA_COMMENT_CLASS_COUNT = 3;
+constexpr int DFA_COMMENT_ROW_STRIDE = 3;
+
+// Input byte -> equivalence class ID (bytes of one class behave identically in every state)
+//   class 0: 0x00-')' '+'-'.' '0'-0xff
+//   class 1: '*'
+//   class 2: '/'
+constexpr std::uint8_t DFA_COMMENT_CHAR_CLASS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 2,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// DFA transition table: [current state ID][byte class] -> target state ID
+alignas(64) constexpr DFAStateId DFA_COMMENT_TRANSITION_TABLE[DFA_COMMENT_STATE_COUNT][DFA_COMMENT_ROW_STRIDE] = {
+    { 1, 2, 1 }, // state 0
+    { 1, 3, 1 }, // state 1
+    { 1, 2, 4 }, // state 2
+    { 1, 3, -1 }, // state 3
+    { -1, -1, -1 } // state 4
+};
+
+// DFA accept states table: [state ID] -> token kind (DFA_TOKEN_NONE if not accepting)
+constexpr DFATokenKind DFA_COMMENT_ACCEPT_KIND[DFA_COMMENT_STATE_COUNT] = {
+    DFA_TOKEN_NONE, // state 0
+    DFA_TOKEN_COMMENTTEXT, // state 1
+    DFA_TOKEN_COMMENTTEXT, // state 2
+    DFA_TOKEN_NONE, // state 3
+    DFA_TOKEN_COMMENTEND // state 4
+};
+
+// DFA acceleration table: [state ID] -> { escape byte count, escape bytes... } for states that loop back
+// to themselves on every other byte (the run up to the next escape byte can be skipped at once); { 0 } otherwise
+constexpr std::uint8_t DFA_COMMENT_ACCEL[DFA_COMMENT_STATE_COUNT][4] = {
+    { 0 }, // state 0
+    { 1, 42 }, // state 1: escapes '*'
+    { 0 }, // state 2
+    { 0 }, // state 3
+    { 0 } // state 4
+};
+
+// Lexer modes (start conditions); mode 0 is the initial mode and uses the unprefixed tables
+enum DFAMode : std::uint8_t {
+    DFA_MODE_INITIAL = 0,
+    DFA_MODE_COMMENT = 1
+};
+
+constexpr int DFA_MODE_COUNT = 2;
+
+// Mode -> name (for diagnostics)
+constexpr const char* DFA_MODE_NAMES[DFA_MODE_COUNT] = {
+    "initial",
+    "comment"
+};
+
+// Tables of one lexer mode: transitions[state * rowStride + charClass[byte]] -> target state ID
+struct DFAModeTable {
+    int start;
+    int stateCount;
+    int classCount;
+    int rowStride;
+    const std::uint8_t* charClass;
+    const DFAStateId* transitions;
+    const DFATokenKind* acceptKind;
+    const std::uint8_t* accel; // [state * 4], see DFA_ACCEL
+};
+
+constexpr DFAModeTable DFA_MODE_TABLES[DFA_MODE_COUNT] = {
+    { DFA_START_STATE, DFA_STATE_COUNT, DFA_CLASS_COUNT, DFA_ROW_STRIDE, DFA_CHAR_CLASS, DFA_TRANSITION_TABLE[0], DFA_ACCEPT_KIND, DFA_ACCEL[0] }, // initial
+    { DFA_COMMENT_START_STATE, DFA_COMMENT_STATE_COUNT, DFA_COMMENT_CLASS_COUNT, DFA_COMMENT_ROW_STRIDE, DFA_COMMENT_CHAR_CLASS, DFA_COMMENT_TRANSITION_TABLE[0], DFA_COMMENT_ACCEPT_KIND, DFA_COMMENT_ACCEL[0] } // comment
+};
+
+// Token kind -> mode entered after the token (BEGIN action), DFA_MODE_KEEP to stay in the current mode
+constexpr std::int8_t DFA_MODE_KEEP = -1;
+constexpr std::int8_t DFA_TOKEN_NEXT_MODE[DFA_TOKEN_KIND_COUNT] = {
+    DFA_MODE_KEEP, // DFA_TOKEN_NONE
+    DFA_MODE_INITIAL, // <commentend>
+    DFA_MODE_COMMENT, // <commentfirst>
+    DFA_MODE_KEEP, // <commentlast>
+    DFA_MODE_KEEP, // <commenttext>
+    DFA_MODE_KEEP, // <comparison_double>
+    DFA_MODE_KEEP, // <comparison_single>
+    DFA_MODE_KEEP, // <division>
+    DFA_MODE_KEEP, // <singleword>
+    DFA_MODE_KEEP, // <number>
+    DFA_MODE_KEEP // <identifier>
+};
+
+// Token kind -> dropped instead of returned to the caller (skip action)
+constexpr bool DFA_TOKEN_SKIP[DFA_TOKEN_KIND_COUNT] = {
+    false, // DFA_TOKEN_NONE
+    true, // <commentend>
+    true, // <commentfirst>
+    false, // <commentlast>
+    true, // <commenttext>
+    false, // <comparison_double>
+    false, // <comparison_single>
+    false, // <division>
+    false, // <singleword>
+    false, // <number>
+    false // <identifier>
+};
+
+// Mode -> terminator derived from the rules: lexing in the mode is equivalent to skipping the input up to and
+// including the first occurrence of text, then entering nextMode (proved by the generator for all inputs, over
+// the noted number of abstract lexer configurations). length is 0 for modes lexed with their tables
+struct DFAModeTerminator {
+    const char* text;
+    int length;
+    std::int8_t nextMode;
+};
+
+constexpr DFAModeTerminator DFA_MODE_TERMINATORS[DFA_MODE_COUNT] = {
+    { nullptr, 0, DFA_MODE_KEEP }, // initial
+    { "*/", 2, DFA_MODE_INITIAL } // comment (proved over 5 lexer configurations)
 };
 
 } // namespace Compiler
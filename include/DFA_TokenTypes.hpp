@@ -0,0 +1,136 @@
+#pragma once
+
+#ifndef DFA_TOKEN_TYPES_HPP
+#define DFA_TOKEN_TYPES_HPP
+
+#include "Lexer.hpp"
+#include "DFA_Tables.hpp"
+#include "SIMDScan.hpp"
+
+namespace Compiler {
+
+    // 将生成的词法单元种类映射到 TokenType 枚举
+    constexpr TokenType tokenTypeOfKind(DFATokenKind kind) {
+        switch (kind) {
+        case DFA_TOKEN_IDENTIFIER: return TokenType::IDENTIFIER;
+        case DFA_TOKEN_NUMBER: return TokenType::NUMBER;
+        case DFA_TOKEN_SINGLEWORD: return TokenType::SINGLEWORD;
+        case DFA_TOKEN_COMPARISON_DOUBLE: return TokenType::COMPARISON_DOUBLE;
+        case DFA_TOKEN_COMPARISON_SINGLE: return TokenType::COMPARISON_SINGLE;
+        case DFA_TOKEN_DIVISION: return TokenType::DIVISION;
+        case DFA_TOKEN_COMMENTFIRST: return TokenType::COMMENT_FIRST;
+        case DFA_TOKEN_COMMENTLAST: return TokenType::COMMENT_LAST;
+        default: return TokenType::UNKNOWN;
+        }
+    }
+
+    // 词法单元种类是否带有令牌动作（模式切换或丢弃）
+    constexpr bool hasTokenAction(DFATokenKind kind) {
+        return DFA_TOKEN_NEXT_MODE[kind] != DFA_MODE_KEEP || DFA_TOKEN_SKIP[kind];
+    }
+
+    // 模式的终结符（见 DFA_MODE_TERMINATORS），没有终结符的模式为空
+    constexpr std::string_view modeTerminator(int mode) {
+        const DFAModeTerminator& terminator = DFA_MODE_TERMINATORS[mode];
+        return terminator.length == 0 ? std::string_view() : std::string_view(terminator.text, terminator.length);
+    }
+
+    // 初始模式中是否没有令牌含有换行符：每个状态在换行符的等价类上都转向死状态。
+    // 规则中出现能跨行的令牌（例如字符串字面量）时为假
+    constexpr bool initialTokensStopAtNewline() {
+        const int newlineClass = DFA_CHAR_CLASS[static_cast<unsigned char>('\n')];
+        for (int state = 0; state < DFA_STATE_COUNT; ++state) {
+            if (DFA_TRANSITION_TABLE[state][newlineClass] != DFA_DEAD_STATE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 能否在行首处于该模式时从行首恢复分析：初始模式要求其中的令牌不含换行符（见 initialTokensStopAtNewline）；
+    // 有终结符且换行符最多是终结符最后一个字节的模式，行首不会落在终结符的中间。
+    // ParallelLexer 与 IncrementalLexer 只在这样的行首切分或恢复分析
+    constexpr bool isResumableMode(int mode) {
+        if (mode == DFA_MODE_INITIAL) {
+            return initialTokensStopAtNewline();
+        }
+        std::string_view terminator = modeTerminator(mode);
+        return !terminator.empty() && terminator.find('\n') >= terminator.size() - 1;
+    }
+
+    // 是否所有模式都可以从行首恢复分析
+    constexpr bool allModesResumable() {
+        for (int mode = 0; mode < DFA_MODE_COUNT; ++mode) {
+            if (!isResumableMode(mode)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 编译期展开的初始模式 [状态ID] -> TokenType 表，接受状态分类只需一次数组读取；
+    // actionKinds 为带动作的接受状态的种类，其余为 DFA_TOKEN_NONE，没有动作的令牌只需一次判断；
+    // special 标记接受后不能直接输出的状态：带令牌动作的（如注释开始符）与孤立的注释结束符
+    struct StateTokenTypes {
+        TokenType types[DFA_STATE_COUNT];
+        DFATokenKind actionKinds[DFA_STATE_COUNT];
+        bool special[DFA_STATE_COUNT];
+
+        constexpr StateTokenTypes() : types(), actionKinds(), special() {
+            for (int state = 0; state < DFA_STATE_COUNT; ++state) {
+                types[state] = tokenTypeOfKind(DFA_ACCEPT_KIND[state]);
+                actionKinds[state] = hasTokenAction(DFA_ACCEPT_KIND[state]) ? DFA_ACCEPT_KIND[state] : DFA_TOKEN_NONE;
+                special[state] = actionKinds[state] != DFA_TOKEN_NONE || types[state] == TokenType::COMMENT_LAST;
+            }
+        }
+    };
+    inline constexpr StateTokenTypes STATE_TOKEN_TYPES;
+
+    // 生成的词法表的访问方式，供 MaximalMunch 和 DFAProfile 使用
+    struct GeneratedDFA {
+        static constexpr int START = DFA_START_STATE;
+        static constexpr int STATE_COUNT = DFA_STATE_COUNT;
+        static constexpr int CLASS_COUNT = DFA_CLASS_COUNT;
+
+        static int charClass(unsigned char byte) {
+            return DFA_CHAR_CLASS[byte];
+        }
+
+        static int transition(int state, int charClass) {
+            return DFA_TRANSITION_TABLE[state][charClass];
+        }
+
+        // 两级查表：输入字节 -> 等价类 -> 目标状态
+        static int next(int state, unsigned char byte) {
+            return DFA_TRANSITION_TABLE[state][DFA_CHAR_CLASS[byte]];
+        }
+
+        static bool accepts(int state) {
+            return DFA_ACCEPT_KIND[state] != DFA_TOKEN_NONE;
+        }
+    };
+
+    // 任一词法模式的表（见 DFA_MODE_TABLES）的访问方式，供 MaximalMunch 使用；初始模式直接使用 GeneratedDFA
+    template <int Mode>
+    struct GeneratedModeDFA {
+        static constexpr const DFAModeTable& TABLE = DFA_MODE_TABLES[Mode];
+        static constexpr int START = TABLE.start;
+
+        static int next(int state, unsigned char byte) {
+            return TABLE.transitions[state * TABLE.rowStride + TABLE.charClass[byte]];
+        }
+
+        static bool accepts(int state) {
+            return TABLE.acceptKind[state] != DFA_TOKEN_NONE;
+        }
+
+        // 加速状态（见 DFA_ACCEL）中一次跳到下一个出口字节，其余状态原样返回 pos
+        static std::size_t accelerate(int state, std::string_view input, std::size_t pos) {
+            const std::uint8_t* accel = TABLE.accel + state * 4;
+            return accel[0] == 0 ? pos : scanToAnyByte(input, pos, accel + 1, accel[0]);
+        }
+    };
+
+} // namespace Compiler
+
+#endif // DFA_TOKEN_TYPES_HPP
@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef INCREMENTAL_LEXER_HPP
+#define INCREMENTAL_LEXER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include "Lexer.hpp"
+#include "TokenStream.hpp"
+
+namespace Compiler {
+
+    // 增量词法分析器
+    // 为每一行的行首记录检查点（偏移、所处的词法模式、该行第一个令牌的下标）。
+    // 编辑后从编辑位置之前最近的可恢复检查点（见 isResumableMode）重新分析，每到一个位于编辑范围之后的行首，就与旧的检查点比较：
+    // 旧文本中对应的行首存在且模式相同（并且可以从该模式恢复），说明之后的令牌与旧令牌流一致，此时停止分析并把新令牌拼接进去。
+    // 令牌与检查点各自存放在以"间隙"分开的两段中：间隙之前的按绝对偏移保存，间隙之后的按到文本结尾的
+    // 距离逆序保存，编辑只改变间隙附近的元素，之后的元素不需要平移。因此每次编辑的工作量与编辑大小
+    // （以及与上一次编辑位置的距离）成正比，而与文件大小无关。
+    // 令牌序列与 Lexer::tokenizeStream 相同，出错时为出错之前的令牌，错误通过 getError 获取而不是抛出。
+    // 标识符不驻留，令牌没有符号编号；未知字符不输出警告
+    class IncrementalLexer {
+    private:
+        // 行首检查点
+        struct Checkpoint {
+            std::size_t offset;     // 行首偏移（间隙之后为到文本结尾的距离）
+            std::size_t firstToken; // 该行及之后第一个令牌的下标（间隙之后为到令牌序列结尾的令牌数）
+            std::uint8_t mode;      // 行首所处的词法模式（DFAMode）
+        };
+
+        // 分析中止于令牌错误（孤立的 "*/"、超出范围的数字）时记录的错误
+        struct TokenError {
+            std::string message;
+            std::size_t fromEnd;    // 错误位置到文本结尾的距离，之后的编辑只要在错误位置之前重新同步就仍然有效
+        };
+
+        std::string_view text_;
+        std::vector<Token> frontTokens_;        // 间隙之前的令牌
+        std::vector<Token> backTokens_;         // 间隙之后的令牌（逆序，offset 为到文本结尾的距离）
+        std::vector<Checkpoint> frontLines_;    // 间隙之前的检查点，第一行的检查点始终在此
+        std::vector<Checkpoint> backLines_;     // 间隙之后的检查点（逆序）
+        std::optional<TokenError> tokenError_;
+        std::uint8_t unterminatedMode_ = 0;     // 文本结尾所处的非初始模式（如未闭合的注释），0 为初始模式
+
+        std::size_t editEnd_ = 0;               // 新文本中编辑范围的结尾，只在其后的行首尝试重新同步
+        std::size_t relexBegin_ = 0;            // 最近一次重新分析的起点
+        std::size_t relexEnd_ = 0;              // 最近一次重新分析的终点（重新同步的位置或文本结尾）
+        std::size_t relexTokens_ = 0;           // 最近一次重新分析产生的令牌数
+
+        // 移动间隙：偏移不超过 offset 的检查点移到间隙之前，令牌移到最后一个这样的检查点处
+        void moveGap(std::size_t offset);
+
+        // 从间隙之前的最后一个检查点开始重新分析，直到重新同步或分析结束
+        void relex();
+
+        // 记录 [begin, end) 中每个换行符之后的行首检查点，行首所处的模式由分析器的模式切换记录 changes 确定：
+        // next 为下一条尚未生效的记录，mode 为当前模式，二者随之前进。某个检查点与旧检查点重新同步时返回 true
+        bool recordLines(std::size_t begin, std::size_t end, const std::vector<Lexer::ModeChange>& changes,
+            std::size_t& next, std::uint8_t& mode);
+
+        // 在 offset 处新增检查点并尝试与间隙之后的旧检查点重新同步
+        bool checkpoint(std::size_t offset, std::uint8_t mode);
+
+        static void checkInputSize(std::string_view text);
+
+        // 由行首检查点二分查找 offset 的行列号，不需要为整个文本建立行首索引
+        SourceLocation locate(std::size_t offset) const;
+
+    public:
+        // 借用 text 并完整分析一遍，text 必须在下一次 applyEdit 之前保持有效
+        explicit IncrementalLexer(std::string_view text);
+
+        IncrementalLexer(const IncrementalLexer&) = delete;
+        IncrementalLexer& operator=(const IncrementalLexer&) = delete;
+
+        // 旧文本的 [start, start + removedLength) 被替换为 insertedLength 个字节，text 是替换后的完整文本
+        void applyEdit(std::string_view text, std::size_t start, std::size_t removedLength, std::size_t insertedLength);
+
+        // 令牌数与第 index 个令牌
+        std::size_t size() const { return frontTokens_.size() + backTokens_.size(); }
+        Token operator[](std::size_t index) const;
+
+        // 当前文本
+        std::string_view text() const { return text_; }
+
+        // 转换为令牌流
+        TokenStream toStream() const;
+
+        // 词法错误，与 Lexer::tokenizeStream 抛出的异常相同；分析时只记录偏移，行列号在调用时由检查点计算
+        std::optional<LexerException> getError() const;
+
+        // 最近一次分析重新扫描的字节范围与产生的令牌数
+        std::size_t getRelexedBegin() const { return relexBegin_; }
+        std::size_t getRelexedEnd() const { return relexEnd_; }
+        std::size_t getRelexedTokens() const { return relexTokens_; }
+
+        // 检查点（行）数
+        std::size_t getLineCount() const { return frontLines_.size() + backLines_.size(); }
+    };
+
+} // namespace Compiler
+
+#endif // INCREMENTAL_LEXER_HPP
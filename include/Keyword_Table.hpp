@@ -0,0 +1,138 @@
+#ifndef KEYWORD_TABLE_HPP
+#define KEYWORD_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Compiler {
+
+// Keyword IDs in spec file order (NONE: not a keyword)
+enum class KeywordId : std::uint8_t {
+    NONE = 0,
+    KW_IF = 1,
+    KW_ELSE = 2,
+    KW_WHILE = 3,
+    KW_FOR = 4,
+    KW_RETURN = 5,
+    KW_INT = 6,
+    KW_FLOAT = 7,
+    KW_CHAR = 8,
+    KW_STRING = 9,
+    KW_BOOL = 10,
+    KW_TRUE = 11,
+    KW_FALSE = 12,
+    KW_READ = 13,
+    KW_WRITE = 14
+};
+
+// Keywords count
+constexpr int KEYWORD_COUNT = 14;
+
+// Keyword length range
+constexpr std::size_t KEYWORD_MIN_LENGTH = 2;
+constexpr std::size_t KEYWORD_MAX_LENGTH = 6;
+
+// Keyword text: [keyword ID] -> spelling
+constexpr std::string_view KEYWORD_NAMES[KEYWORD_COUNT + 1] = {
+    "",
+    "if",
+    "else",
+    "while",
+    "for",
+    "return",
+    "int",
+    "float",
+    "char",
+    "string",
+    "bool",
+    "true",
+    "false",
+    "read",
+    "write"
+};
+
+// Perfect hash: key = length, then key = key * 31 + byte for each of text[0, 1, last] (indices clamped to the last byte)
+//   slot = (key * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_HASH_BITS)
+constexpr std::uint32_t KEYWORD_HASH_MULTIPLIER = 3405680381u;
+constexpr int KEYWORD_HASH_BITS = 4;
+
+// Hash slot -> keyword ID (collision-free)
+constexpr KeywordId KEYWORD_SLOTS[1 << KEYWORD_HASH_BITS] = {
+    KeywordId::KW_BOOL, // slot 0
+    KeywordId::KW_FALSE, // slot 1
+    KeywordId::KW_FOR, // slot 2
+    KeywordId::KW_READ, // slot 3
+    KeywordId::KW_INT, // slot 4
+    KeywordId::KW_WRITE, // slot 5
+    KeywordId::KW_FLOAT, // slot 6
+    KeywordId::KW_RETURN, // slot 7
+    KeywordId::KW_WHILE, // slot 8
+    KeywordId::KW_TRUE, // slot 9
+    KeywordId::KW_STRING, // slot 10
+    KeywordId::KW_CHAR, // slot 11
+    KeywordId::KW_ELSE, // slot 12
+    KeywordId::KW_IF, // slot 13
+    KeywordId::NONE, // slot 14
+    KeywordId::NONE // slot 15
+};
+
+// Keyword lookup: returns KeywordId::NONE if text is not a keyword
+constexpr KeywordId lookupKeyword(std::string_view text) {
+    const std::size_t length = text.size();
+    if (length < KEYWORD_MIN_LENGTH || length > KEYWORD_MAX_LENGTH) {
+        return KeywordId::NONE;
+    }
+    const unsigned char first = static_cast<unsigned char>(text[0]);
+    const unsigned char last = static_cast<unsigned char>(text[length - 1]);
+
+    // Fast reject: only (first, last) pairs of keywords with this length pass
+    switch (length) {
+    case 2: // if
+        if (!((first == 'i' && last == 'f'))) {
+            return KeywordId::NONE;
+        }
+        break;
+    case 3: // for int
+        if (!((first == 'f' && last == 'r') ||
+              (first == 'i' && last == 't'))) {
+            return KeywordId::NONE;
+        }
+        break;
+    case 4: // else char bool true read
+        if (!((first == 'b' && last == 'l') ||
+              (first == 'c' && last == 'r') ||
+              (first == 'e' && last == 'e') ||
+              (first == 'r' && last == 'd') ||
+              (first == 't' && last == 'e'))) {
+            return KeywordId::NONE;
+        }
+        break;
+    case 5: // while float false write
+        if (!((first == 'f' && last == 'e') ||
+              (first == 'f' && last == 't') ||
+              (first == 'w' && last == 'e'))) {
+            return KeywordId::NONE;
+        }
+        break;
+    case 6: // return string
+        if (!((first == 'r' && last == 'n') ||
+              (first == 's' && last == 'g'))) {
+            return KeywordId::NONE;
+        }
+        break;
+    default:
+        return KeywordId::NONE;
+    }
+
+    std::uint32_t key = static_cast<std::uint32_t>(length);
+    key = key * 31u + static_cast<unsigned char>(text[0]);
+    key = key * 31u + static_cast<unsigned char>(text[1]);
+    key = key * 31u + last;
+    const KeywordId id = KEYWORD_SLOTS[(key * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_HASH_BITS)];
+    return KEYWORD_NAMES[static_cast<int>(id)] == text ? id : KeywordId::NONE;
+}
+
+} // namespace Compiler
+
+#endif // KEYWORD_TABLE_HPP
@@ -4,14 +4,27 @@
 #define LEXER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <optional>
+#include <cstdint>
+#include <limits>
+#include "LineIndex.hpp"
+#include "MaximalMunch.hpp"
+#include "StringInterner.hpp"
+#include "LexerDiagnostics.hpp"
 
 namespace Compiler {
 
+    class SourceBuffer;
+    class TokenStream;
+    class DFAProfile;
+    class LexerException;
+
     // 令牌类型枚举
-    enum class TokenType {
+    enum class TokenType : std::uint8_t {
         // 基本令牌类型
         IDENTIFIER,     // 标识符
         NUMBER,         // 数字
@@ -26,83 +39,276 @@ namespace Compiler {
         UNKNOWN         // 未知令牌
     };
 
+    // 令牌偏移的类型：默认 32 位，令牌占 16 字节，输入不超过 4GB；
+    // 定义 LEXER_WIDE_TOKENS 时为 64 位，令牌占 24 字节，可分析更大的输入
+#ifdef LEXER_WIDE_TOKENS
+    using TokenOffset = std::uint64_t;
+#else
+    using TokenOffset = std::uint32_t;
+#endif
+
+    // 令牌偏移可表示的最大输入长度
+    inline constexpr std::size_t MAX_TOKEN_INPUT_SIZE = static_cast<std::size_t>(std::numeric_limits<TokenOffset>::max());
+
     // 令牌结构
+    // 令牌不持有也不指向令牌值，只记录它在输入中的字节偏移与长度：值由 Lexer::text 从输入缓冲区还原，
+    // 行列号通过 Lexer::getLocation 按需计算，因此令牌不能比产生它的输入缓冲区存活得更久。
+    // payload 在分析时填入：标识符为驻留表中的符号编号，数字为不超过 32 位的数值；
+    // 没有 payload 的令牌（未驻留的标识符、超过 32 位或来自令牌流的数字）由使用者从令牌值推导
     struct Token {
-        TokenType type; // 令牌类型
-        std::string value; // 令牌值
-        std::size_t line;   // 行号
-        std::size_t column; // 列号
-        std::size_t position; // 在输入中的位置
-
-        Token(TokenType t, const std::string& v, std::size_t l, std::size_t c, std::size_t p)
-            : type(t), value(v), line(l), column(c), position(p) {}
+        TokenOffset offset;     // 在输入中的字节偏移
+        std::uint32_t length;   // 令牌长度
+        std::uint32_t payload;  // 符号编号或数值（hasPayload 为真时有效）
+        TokenType type;         // 令牌类型
+        bool hasPayload;
+
+        Token(TokenType t, std::size_t o, std::size_t l)
+            : offset(static_cast<TokenOffset>(o)), length(static_cast<std::uint32_t>(l)), payload(0), type(t), hasPayload(false) {}
+
+        Token(TokenType t, std::size_t o, std::size_t l, std::uint32_t p)
+            : offset(static_cast<TokenOffset>(o)), length(static_cast<std::uint32_t>(l)), payload(p), type(t), hasPayload(true) {}
+
+        // 令牌结尾的偏移
+        std::size_t end() const { return static_cast<std::size_t>(offset) + length; }
+
+        // 在令牌所属的输入中取出令牌值
+        std::string_view text(std::string_view input) const { return input.substr(offset, length); }
+
+        // 标识符的符号编号（见 Lexer::getSymbols），未驻留或不是标识符时为 NO_SYMBOL
+        SymbolId symbol() const { return hasPayload && type == TokenType::IDENTIFIER ? payload : NO_SYMBOL; }
     };
 
+    static_assert(sizeof(Token) == (sizeof(TokenOffset) == 4 ? 16 : 24), "Token must stay compact");
+
     // 词法分析器类
     class Lexer {
     private:
-        std::string input_;
+        std::string storage_;       // 以字符串构造时持有的输入
+        std::string_view input_;    // 实际扫描的输入（指向 storage_ 或外部 SourceBuffer）
         std::size_t position_;
-        std::size_t line_;
-        std::size_t column_;
+        mutable std::optional<LineIndex> lineIndex_; // 行首偏移索引，首次查询行列号时建立
+
+        // 词法模式（起始条件，见 input/lex_rules.txt 的 %mode）：令牌动作 BEGIN(mode) 切换，每个模式有自己的 DFA 表
+        int mode_ = 0;                  // 当前模式（DFAMode），0 为初始模式
+        std::size_t modeStart_ = 0;     // 进入当前模式的位置（如注释 "/*" 之后）
+
+        // 分块模式：输入只是整个源程序的一个前缀，在非初始模式中结束（如未闭合的注释）不是错误，
+        // 结束时 mode_ 与 modeStart_ 留给调用者拼接；从块开头就处于的模式中结束时 modeStart_ 为 npos
+        bool chunked_ = false;
+
+        // 模式切换记录：每次切换后的模式及其生效的位置，供 IncrementalLexer 确定各行首所处的模式（未启用时为空）
+        struct ModeChange {
+            std::size_t offset;
+            int mode;
+        };
+        std::vector<ModeChange>* modeChanges_ = nullptr;
+
+        // 向前查看环形缓冲区：已分析但尚未消费的令牌，每个令牌只分析一次
+        struct LookaheadSlot {
+            Token token;
+            std::size_t dfaRuns;    // 产生该令牌（含其前被跳过的注释）所用的 DFA 运行次数
+        };
+        std::vector<LookaheadSlot> lookahead_;  // 容量为 2 的幂
+        std::size_t lookaheadDepth_;            // 最多可向前查看的令牌数 k
+        std::size_t lookaheadHead_ = 0;         // 队首（下一个被消费的令牌）下标
+        std::size_t lookaheadCount_ = 0;        // 缓冲区中的令牌数
+        std::size_t dfaRuns_ = 0;               // DFA 运行总次数
+        std::size_t dfaRunsSaved_ = 0;          // 向前查看命中缓冲区而省去的 DFA 运行次数
+
+        std::optional<MunchMemo> munchMemo_;    // 表格化最长匹配的失败记录表（未启用时为空）
+        DFAProfile* profile_ = nullptr;         // 记录初始模式 DFA 访问次数的剖析（未启用时为空）
+
+        LexerDiagnostics* diagnostics_ = nullptr;   // 收集词法错误的诊断（为空时错误抛出 LexerException）
+        bool hasError_ = false;                     // 是否出现过词法错误，出现后保持到 reset()
+
+        // 标识符驻留表，由词法分析器与语法分析器共享，AST 中的名称指向其中；分块模式下为空，不驻留
+        std::shared_ptr<StringInterner> symbols_;
 
         char currentChar();
         char peekChar(std::size_t offset = 1);
         void advance();
         void skipWhitespace();
-        void skipComment();
 
-        // DFA 驱动的词法分析
-        Token runDFA();
-        TokenType mapTokenName(const std::string& tokenName);
+        // 输入在非初始模式中结束：分块模式下保留模式留给调用者，否则报告未结束的构造（如 "Unterminated comment"）
+        void endInsideMode();
+
+        // 从当前位置起进入 mode
+        void enterMode(int mode);
+
+        // 分析出下一个令牌（不经过向前查看缓冲区）
+        Token lexToken();
+
+        // 在非初始模式中分析一步：返回得到的令牌（包括 EOF），离开模式或令牌被丢弃时返回空
+        std::optional<Token> lexInMode();
+
+        // 执行令牌动作（DFATokenKind 的 BEGIN(mode) 与 skip）：切换模式，返回令牌是否被丢弃
+        bool applyTokenAction(int actionKind);
+
+        // DFA 驱动的词法分析，使用当前模式的表；actionKind 为带令牌动作（模式切换或丢弃）的词法单元种类
+        // （DFATokenKind），没有动作时为 DFA_TOKEN_NONE
+        Token runDFA(int& actionKind);
+
+        // 在 startPos 处使用当前模式的表做最长匹配（初始模式下按设置记录剖析或使用表格化最长匹配）
+        MunchResult matchAt(std::size_t startPos);
+
+        // 由最长匹配的结果得到令牌：处理令牌动作与未知字符，其余交给 makeToken
+        Token acceptMatch(const MunchResult& match, std::size_t startPos, int& actionKind);
+
+        // 类型为 type 的令牌 [startPos, end)：由 classifyToken 分类，出错时经 lexError 报告，其余标识符驻留为符号编号。
+        // acceptMatch 与初始模式的快速路径都经由此处
+        Token makeToken(TokenType type, std::size_t startPos, std::size_t end);
+
+        // 报告词法错误：设置了诊断收集器时记录下来，否则抛出 LexerException
+        void lexError(LexerErrorKind kind, std::size_t offset, std::size_t length);
+
+        // offset 处的词法错误；分块模式下只记录偏移，行列号由调用者在整个输入上计算
+        LexerException errorAt(const std::string& message, std::size_t offset) const;
+
+        // 报告未知字符（未设置诊断收集器时）
+        void warnUnknownToken(const Token& token) const;
+
+        // 借用 input，从 begin 开始在模式 mode 中分析到 input 结尾；chunked 为真时按分块模式分析，
+        // 供 ParallelLexer、BatchLexer 与 IncrementalLexer 使用。这样构造的词法分析器不驻留标识符，
+        // 令牌的符号编号均为 NO_SYMBOL；与其他构造函数一样拒绝令牌偏移无法表示的输入
+        Lexer(std::string_view input, std::size_t begin, bool chunked, int mode = 0);
+
+        friend class ParallelLexer;
+        friend class BatchLexer;
+        friend class IncrementalLexer;
 
     public:
-        Lexer(const std::string& input);
+        // 词法分析器持有输入缓冲区，令牌的值均为该缓冲区中的视图
+        explicit Lexer(std::string input);
+
+        // 借用已加载的源程序缓冲区，不拷贝输入；source 必须比词法分析器及其令牌存活得更久
+        explicit Lexer(const SourceBuffer& source);
+
+        // 令牌引用内部缓冲区，禁止拷贝和移动以免视图失效
+        Lexer(const Lexer&) = delete;
+        Lexer& operator=(const Lexer&) = delete;
+
+        // 默认向前查看深度
+        static constexpr std::size_t DEFAULT_LOOKAHEAD_DEPTH = 4;
+
+        // 设置向前查看深度 k（至少为 1），缓冲区中尚有令牌时不能修改
+        void setLookaheadDepth(std::size_t depth);
+        std::size_t getLookaheadDepth() const { return lookaheadDepth_; }
 
-        // 获取下一个令牌
-        Token nextToken();
+        // 查看之后的第 index 个令牌（0 为下一个）但不消费，index 必须小于向前查看深度。
+        // 尚未分析的令牌在此时分析并放入缓冲区，之后的查看和消费不再重复分析
+        const Token& peek(std::size_t index = 0);
 
-        // 查看下一个令牌但不消费它
-        Token peekToken();
+        // 消费下一个令牌：缓冲区非空时取出队首，否则直接分析
+        Token consume();
 
-        // 检查是否到达输入结尾
+        // 获取下一个令牌（等同于 consume）
+        Token nextToken() { return consume(); }
+
+        // 查看下一个令牌但不消费它（等同于 peek(0)）
+        Token peekToken() { return peek(0); }
+
+        // 检查是否到达输入结尾（缓冲区中没有待消费的令牌且分析位置已到结尾）
         bool isAtEnd() const;
 
+        // 启用/关闭表格化最长匹配：记住失败的 (状态, 位置) 对，保证最坏情况下也是线性时间。
+        // 位表大小为 状态数 * 输入长度 位；当前规则的回退最多一个字节，默认关闭
+        void setTabulatingMunch(bool enabled);
+        bool isTabulatingMunch() const { return munchMemo_.has_value(); }
+
+        // 设置/清除 DFA 剖析（需包含 DFAProfile.hpp，由 DFAProfile::of<GeneratedDFA>() 创建）：
+        // 之后初始模式的每次最长匹配都记录状态与转移的访问次数，profile 须比词法分析器存活得更久。
+        // 剖析时不使用表格化最长匹配
+        void setProfile(DFAProfile* profile) { profile_ = profile; }
+
+        // 设置/清除诊断收集器：设置后词法错误（未知字符、未闭合的注释、孤立的 "*/"、超出范围的数字、过长的令牌）不再抛出
+        // LexerException 或向 std::cerr 输出警告，而是记录到 diagnostics 中并继续分析，出错的文本作为 UNKNOWN 令牌返回，
+        // 连续的未知字符合并为一个令牌和一条诊断。diagnostics 须比词法分析器存活得更久。
+        // 输入超出令牌格式的上限（见 LEXER_WIDE_TOKENS）仍然在构造时抛出异常
+        void setDiagnostics(LexerDiagnostics* diagnostics) { diagnostics_ = diagnostics; }
+        LexerDiagnostics* getDiagnostics() const { return diagnostics_; }
+
+        // 是否出现过词法错误（包括未知字符）：一旦出现就保持为真，直到 reset()
+        bool hasError() const { return hasError_; }
+
+        // DFA 运行总次数，以及向前查看缓冲区省去的次数
+        std::size_t getDFARuns() const { return dfaRuns_; }
+        std::size_t getDFARunsSaved() const { return dfaRunsSaved_; }
+
         // 令牌化整个输入
         std::vector<Token> tokenize();
 
-        // 重置词法分析器
+        // 令牌化整个输入，返回结构数组形式的令牌流（需包含 TokenStream.hpp）
+        // 令牌流引用词法分析器的输入
+        TokenStream tokenizeStream();
+
+        // 重置词法分析器（回到初始模式，清除错误状态；诊断收集器中的记录由其所有者清空）
         void reset();
 
-        // 获取当前位置信息
+        // 获取标识符驻留表，标识符令牌的 symbol 是其中的编号
+        const std::shared_ptr<StringInterner>& getSymbols() const { return symbols_; }
+
+        // 获取输入与令牌值（令牌值是输入缓冲区中的视图）
+        std::string_view getInput() const { return input_; }
+        std::string_view text(const Token& token) const { return token.text(input_); }
+
+        // 获取当前分析位置（向前查看过的令牌已被分析，因此可能超前于已消费的令牌）
         std::size_t getPosition() const { return position_; }
-        std::size_t getLine() const { return line_; }
-        std::size_t getColumn() const { return column_; }
+
+        // 获取行首偏移索引（首次调用时建立）
+        const LineIndex& getLineIndex() const;
+
+        // 将字节偏移转换为行列号
+        SourceLocation getLocation(std::size_t position) const { return getLineIndex().locate(position); }
     };
 
     // 令牌类型到字符串的转换
     std::string tokenTypeToString(TokenType type);
 
     // 检查是否为关键字
-    bool isKeyword(const std::string& identifier);
+    bool isKeyword(std::string_view identifier);
+
+    // 数字令牌的值：有 payload 时直接取出，否则从 input 中的令牌值转换（令牌值已在分析时检查过范围）
+    std::int64_t numberValue(const Token& token, std::string_view input);
+
+    // 为最长匹配得到的令牌分类，Lexer、StreamLexer 与 BatchLexer 共用：检查令牌长度（LEXER_WIDE_TOKENS 时）、
+    // 识别关键字并转换数字（不超过 32 位的数值放入 payload）。出错时设置 error 并返回 UNKNOWN 令牌，由调用者报告
+    Token classifyToken(TokenType type, std::size_t offset, std::string_view value,
+        std::optional<LexerErrorKind>& error);
 
     // 词法分析异常类
+    // 出错位置同时记录字节偏移与行列号。分块分析（ParallelLexer、BatchLexer、IncrementalLexer）只记录偏移，
+    // 行号为 0 表示行列号尚未计算，由调用者确定真正的错误之后用 located 补上，避免每个出错的块都建立行首索引
     class LexerException : public std::exception {
     private:
         std::string message_;
+        std::size_t offset_;
         std::size_t line_;
         std::size_t column_;
 
     public:
         LexerException(const std::string& message, std::size_t line, std::size_t column)
-            : message_(message), line_(line), column_(column) {}
+            : message_(message), offset_(std::string_view::npos), line_(line), column_(column) {}
+
+        LexerException(const std::string& message, std::size_t offset, SourceLocation location)
+            : message_(message), offset_(offset), line_(location.line), column_(location.column) {}
+
+        // 只记录偏移，行列号待计算
+        LexerException(const std::string& message, std::size_t offset)
+            : message_(message), offset_(offset), line_(0), column_(0) {}
 
         const char* what() const noexcept override {
             return message_.c_str();
         }
 
+        std::size_t getOffset() const { return offset_; }
         std::size_t getLine() const { return line_; }
         std::size_t getColumn() const { return column_; }
+        bool hasLocation() const { return line_ != 0; }
+
+        // 补上行列号后的副本
+        LexerException located(SourceLocation location) const {
+            return LexerException(message_, offset_, location);
+        }
 
         std::string getFullMessage() const {
             return "LexError (in line:" + std::to_string(line_) +
@@ -112,7 +318,8 @@ namespace Compiler {
 } // namespace Compiler
 
 // 输出词法分析结果，格式适合语法分析器使用
-// 输出格式: <TokenType, TokenValue, Line, Column>
-void outputLexerResults(const std::vector<Compiler::Token>& tokens, std::ostream& out = std::cout);
+// 输出格式: <TokenType, TokenValue, Line, Column>，令牌值与行列号由 lexer 的输入和行首索引还原
+void outputLexerResults(const std::vector<Compiler::Token>& tokens, const Compiler::Lexer& lexer,
+    std::ostream& out = std::cout);
 
 #endif // LEXER_HPP
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef LEXER_DIAGNOSTICS_HPP
+#define LEXER_DIAGNOSTICS_HPP
+
+#include "LineIndex.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 词法错误的种类
+    enum class LexerErrorKind : std::uint8_t {
+        UNKNOWN_CHARACTERS,     // 一段连续的、无法开始任何令牌的字符
+        UNTERMINATED_MODE,      // 输入在非初始模式中结束，如未闭合的注释
+        ISOLATED_COMMENT_END,   // 孤立的注释结束符 "*/"
+        NUMBER_OUT_OF_RANGE,    // 超出 64 位有符号整数范围的数字
+        TOKEN_TOO_LONG          // 长度超出令牌格式上限的令牌（只在 LEXER_WIDE_TOKENS 时可能出现）
+    };
+
+    // 词法错误的说明文字，抛出的 LexerException 与诊断输出都由此生成。
+    // text 为出错的文本（UNKNOWN_CHARACTERS 时引用），mode 为未结束的模式（UNTERMINATED_MODE 时使用）
+    std::string lexerErrorMessage(LexerErrorKind kind, std::string_view text = {}, int mode = 0);
+
+    // 一条词法诊断：只记录种类和输入中的位置，行列号与说明文字在输出时才计算
+    struct LexerDiagnostic {
+        LexerErrorKind kind;
+        std::uint8_t mode;      // UNTERMINATED_MODE 时为未结束的模式（DFAMode）
+        std::size_t offset;     // 出错文本的起点（未结束的模式为进入该模式的位置）
+        std::size_t length;
+    };
+
+    // 词法诊断收集器（见 Lexer::setDiagnostics）
+    // 容量在构造时一次预留，记录诊断不分配内存；记满后只计数不再保存，
+    // 因此大量出错的输入也不会使出错路径变慢或占用过多内存
+    class LexerDiagnostics {
+    private:
+        std::vector<LexerDiagnostic> entries_;
+        std::size_t capacity_;
+        std::size_t dropped_ = 0;   // 记满后未保存的诊断数
+
+    public:
+        // 默认最多保存的诊断数
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+        explicit LexerDiagnostics(std::size_t capacity = DEFAULT_CAPACITY);
+
+        // 记录一条诊断
+        void report(LexerErrorKind kind, std::size_t offset, std::size_t length, std::uint8_t mode = 0) {
+            if (entries_.size() < capacity_) {
+                entries_.push_back(LexerDiagnostic{ kind, mode, offset, length });
+            }
+            else {
+                ++dropped_;
+            }
+        }
+
+        // 已保存的诊断（按在输入中出现的顺序）
+        const std::vector<LexerDiagnostic>& entries() const { return entries_; }
+
+        // 记满后未保存的诊断数，以及包括它们在内的诊断总数
+        std::size_t dropped() const { return dropped_; }
+        std::size_t total() const { return entries_.size() + dropped_; }
+
+        bool empty() const { return total() == 0; }
+
+        // 清空诊断，保留预留的容量
+        void clear();
+
+        // 诊断的说明文字，与抛出的 LexerException 相同；input 为诊断所属的输入
+        static std::string message(const LexerDiagnostic& diagnostic, std::string_view input);
+
+        // 按 LexerException::getFullMessage 的格式输出所有诊断，每条一行，最后刷新一次
+        void print(std::ostream& out, std::string_view input, const LineIndex& lineIndex) const;
+    };
+
+} // namespace Compiler
+
+#endif // LEXER_DIAGNOSTICS_HPP
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 源程序中的行列位置（均从 1 开始）
+    struct SourceLocation {
+        std::size_t line;
+        std::size_t column;
+    };
+
+    // 行首偏移索引
+    // 词法分析只记录字节偏移，需要行列号时（诊断信息、AST 节点位置）再由本索引二分查找得到
+    class LineIndex {
+    private:
+        std::vector<std::size_t> lineStarts_;   // 每一行第一个字节的偏移，lineStarts_[0] 恒为 0
+
+    public:
+        LineIndex();
+
+        // 用 memchr 逐个定位换行符，一次性建立索引
+        explicit LineIndex(std::string_view input);
+
+        // 将字节偏移转换为行列号
+        SourceLocation locate(std::size_t offset) const;
+
+        // 获取行数
+        std::size_t getLineCount() const { return lineStarts_.size(); }
+
+        // 获取第 line 行（从 1 开始）首字节的偏移
+        std::size_t getLineStart(std::size_t line) const { return lineStarts_[line - 1]; }
+    };
+
+} // namespace Compiler
+
+#endif // LINE_INDEX_HPP
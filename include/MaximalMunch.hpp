@@ -0,0 +1,124 @@
+#pragma once
+
+#ifndef MAXIMAL_MUNCH_HPP
+#define MAXIMAL_MUNCH_HPP
+
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 表格化最长匹配的失败记录表
+    // 记录所有"从状态 s、位置 p 出发再也到达不了接受状态"的 (s, p) 对。该性质只取决于输入和 DFA，
+    // 与令牌从哪里开始无关，因此一次扫描中得出的结论可供之后的令牌复用：每个 (s, p) 对至多被
+    // 走过一次就被记为失败，最长匹配的总耗时从最坏 O(n^2) 降为 O(状态数 * n)。
+    // 位表占 状态数 * (输入长度 + 1) 位内存。
+    class MunchMemo {
+    private:
+        std::vector<std::uint64_t> bits_;               // 下标为 位置 * 状态数 + 状态
+        std::size_t stateCount_ = 0;
+        std::vector<std::pair<int, std::size_t>> trail_; // 最近一次接受之后走过的 (状态, 位置)
+
+        template <typename DFA>
+        friend struct MaximalMunch;
+
+    public:
+        MunchMemo() = default;
+        MunchMemo(std::size_t stateCount, std::size_t inputSize)
+            : bits_((stateCount * (inputSize + 1) + 63) / 64), stateCount_(stateCount) {}
+
+        bool failed(int state, std::size_t position) const {
+            std::size_t index = position * stateCount_ + static_cast<std::size_t>(state);
+            return (bits_[index / 64] >> (index % 64)) & 1u;
+        }
+
+        void markFailed(int state, std::size_t position) {
+            std::size_t index = position * stateCount_ + static_cast<std::size_t>(state);
+            bits_[index / 64] |= std::uint64_t(1) << (index % 64);
+        }
+
+        // 位表占用的字节数
+        std::size_t memoryBytes() const { return bits_.size() * sizeof(std::uint64_t); }
+    };
+
+    // 一次最长匹配的结果：最后到达的接受状态（没有时为 -1）及其结束位置
+    struct MunchResult {
+        int acceptState;
+        std::size_t end;
+    };
+
+    // 在生成的 DFA 表上做最长匹配
+    // DFA 需提供 START、next(state, byte)（死状态返回负数）和 accepts(state)；
+    // 可选的 accelerate(state, input, pos) 返回从 pos 起停留在 state 中的一段输入的结尾，供非表格化匹配跳过自环
+    template <typename DFA>
+    struct MaximalMunch {
+        // 从 start 开始匹配；memo 为空时为普通的最长匹配，否则按表格化算法剪去已知失败的 (状态, 位置)
+        static MunchResult match(std::string_view input, std::size_t start, MunchMemo* memo) {
+            int state = DFA::START;
+            int lastAcceptState = -1;
+            std::size_t lastAcceptPos = start;
+            const std::size_t inputSize = input.size();
+            std::size_t pos = start;
+
+            if (memo == nullptr) {
+                while (true) {
+                    bool accepting = DFA::accepts(state);
+                    if constexpr (requires { DFA::accelerate(state, input, pos); }) {
+                        pos = DFA::accelerate(state, input, pos);
+                    }
+                    if (accepting) {
+                        lastAcceptState = state;
+                        lastAcceptPos = pos;
+                    }
+                    if (pos >= inputSize) {
+                        break;
+                    }
+                    int nextState = DFA::next(state, static_cast<unsigned char>(input[pos]));
+                    if (nextState < 0) {
+                        break;
+                    }
+                    state = nextState;
+                    pos++;
+                }
+                return MunchResult{ lastAcceptState, lastAcceptPos };
+            }
+
+            // 接受状态之前走过的对都能到达接受状态，只需记录最近一次接受之后的部分
+            memo->trail_.clear();
+            while (true) {
+                if (DFA::accepts(state)) {
+                    lastAcceptState = state;
+                    lastAcceptPos = pos;
+                    memo->trail_.clear();
+                }
+                else if (memo->failed(state, pos)) {
+                    break;
+                }
+                else {
+                    memo->trail_.emplace_back(state, pos);
+                }
+                if (pos >= inputSize) {
+                    break;
+                }
+                int nextState = DFA::next(state, static_cast<unsigned char>(input[pos]));
+                if (nextState < 0) {
+                    break;
+                }
+                state = nextState;
+                pos++;
+            }
+
+            // 扫描停止时仍未再次接受，记录中的每一对都无法到达接受状态
+            for (const auto& [failedState, failedPos] : memo->trail_) {
+                memo->markFailed(failedState, failedPos);
+            }
+            return MunchResult{ lastAcceptState, lastAcceptPos };
+        }
+    };
+
+} // namespace Compiler
+
+#endif // MAXIMAL_MUNCH_HPP
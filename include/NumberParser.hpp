@@ -0,0 +1,22 @@
+#pragma once
+
+#ifndef NUMBER_PARSER_HPP
+#define NUMBER_PARSER_HPP
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 去掉前导零后最多的有效数字位数，不超过该位数的十进制数一定能放进 64 位无符号整数
+    inline constexpr std::size_t MAX_DECIMAL_DIGITS = 19;
+
+    // 将十进制数字串转换为 64 位有符号整数，不分配内存。digits 非空且只含 '0'-'9'（由 DFA 保证）。
+    // 每次取 8 个数字按 SWAR 方式合并（三次乘法代替八次乘加），剩余不足 8 个时逐位处理。
+    // 超出 INT64_MAX 时返回 false，value 不变
+    bool parseDecimal(std::string_view digits, std::int64_t& value);
+
+} // namespace Compiler
+
+#endif // NUMBER_PARSER_HPP
@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef PARALLEL_LEXER_HPP
+#define PARALLEL_LEXER_HPP
+
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <memory>
+#include <cstddef>
+#include "Lexer.hpp"
+#include "TokenStream.hpp"
+
+namespace Compiler {
+
+    // 多线程分块词法分析器
+    // 输入在换行符处切分成若干块（初始模式的令牌不跨行，只有注释这样的词法模式可能跨块），由一组工作线程并行分析。
+    // 块开头处于哪个模式要等前一块分析完才知道，因此除第一块外每块都按每个模式各分析一次，
+    // 最后按顺序沿着实际的模式选取结果拼接。输出和报错与串行的 Lexer::tokenizeStream 完全一致。
+    // 有模式不能从行首恢复分析（见 isResumableMode）时不切分
+    class ParallelLexer {
+    private:
+        // 一个块按某一种起始模式分析的结果，令牌偏移均相对于整个输入
+        struct ChunkResult {
+            TokenStream tokens;
+            std::optional<LexerException> error;    // 块内遇到的词法错误（只有偏移，没有行列号）
+            bool stopped = false;                   // 在块结尾之前遇到 '\0'，整个输入到此结束
+            int endMode = 0;                        // 块结尾所处的模式
+            std::size_t modeStart = std::string_view::npos; // 块结尾所处的模式在本块内进入时的位置
+        };
+
+        std::string_view input_;
+        unsigned threadCount_;
+        std::size_t chunkCount_;    // 最近一次分析使用的块数
+        Lexer whole_;               // 整个输入上的词法分析器，只用于换算行列号和报告未知字符
+        std::shared_ptr<StringInterner> symbols_;   // tokenize() 驻留标识符的驻留表
+
+        // 在换行符处切分输入，返回各块的起始偏移，末尾附加 input_.size()
+        std::vector<std::size_t> splitChunks() const;
+
+        // 分析 [begin, end) 一块，假定块开头处于模式 startMode 中
+        ChunkResult lexChunk(std::size_t begin, std::size_t end, int startMode) const;
+
+    public:
+        // 每块的最小字节数，过小的块线程调度开销大于收益
+        static constexpr std::size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+        // 每个线程平均分到的块数，块数多于线程数可以平衡各块耗时的差异
+        static constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+        // 借用 input；threadCount 为 0 时使用硬件线程数。input 必须比分析器及其令牌流存活得更久
+        explicit ParallelLexer(std::string_view input, unsigned threadCount = 0);
+
+        ParallelLexer(const ParallelLexer&) = delete;
+        ParallelLexer& operator=(const ParallelLexer&) = delete;
+
+        // 并行令牌化整个输入，结果与 Lexer::tokenizeStream 相同
+        TokenStream tokenizeStream();
+
+        // 并行令牌化整个输入，结果与 Lexer::tokenize 相同：拼接后按顺序补上令牌流不保存的负载，
+        // 标识符驻留到 getSymbols() 中（编号顺序与串行分析相同），不超过 32 位的数字放入数值
+        std::vector<Token> tokenize();
+
+        // 标识符的驻留表，tokenize() 填入
+        const std::shared_ptr<StringInterner>& getSymbols() const { return symbols_; }
+
+        unsigned getThreadCount() const { return threadCount_; }
+        std::size_t getChunkCount() const { return chunkCount_; }
+
+        // 获取整个输入的行首偏移索引
+        const LineIndex& getLineIndex() const { return whole_.getLineIndex(); }
+    };
+
+} // namespace Compiler
+
+#endif // PARALLEL_LEXER_HPP
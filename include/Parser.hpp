@@ -10,6 +10,7 @@
 #include <memory>
 #include <stack>
 #include "Lexer.hpp"
+#include "TokenStream.hpp"
 #include "LL1_Table.hpp"
 #include "AST.hpp"
 
@@ -43,6 +44,10 @@ namespace Compiler {
     class Parser {
     private:
         std::shared_ptr<Lexer> lexer_; // 词法分析器智能指针
+        std::shared_ptr<const TokenStream> tokens_; // 预先令牌化的令牌流（为空时按需调用词法分析器）
+        std::string_view input_; // 令牌所引用的输入，令牌值由偏移和长度在其中还原
+        std::shared_ptr<StringInterner> symbols_; // 符号驻留表（与词法分析器共享），AST 叶子节点的名称指向其中
+        TokenStream::const_iterator tokenIt_; // 令牌流中的下一个令牌
         Token currentToken_; // 当前token
         std::stack<std::pair<std::string, SymbolType>> parseStack; // 分析栈
         std::stack<std::shared_ptr<ASTNode>> astStack; // AST构造栈
@@ -52,16 +57,20 @@ namespace Compiler {
         // 获取下一个token
         void advance();
 
-        // 将Token转换为终结符字符串
-        std::string tokenToTerminal(const Token& token);
+        // 将Token转换为终结符（返回令牌值或字面量的视图，不分配内存）
+        std::string_view tokenToTerminal(const Token& token);
 
         // 初始化分析栈
         void initializeStack();
 
         // 获取产生式索引
-        int getProductionIndex(const std::string& nonTerminal, const std::string& terminal);
+        int getProductionIndex(const std::string& nonTerminal, std::string_view terminal);
+
+        // 当前标识符令牌的符号编号：词法分析器已驻留的直接返回，令牌流中的标识符在此驻留；非标识符令牌返回 NO_SYMBOL
+        SymbolId currentSymbol();
 
         // 获取当前token位置信息
+        SourceLocation getCurrentLocation() const;
         std::size_t getCurrentLine() const;
         std::size_t getCurrentColumn() const;
 
@@ -75,6 +84,9 @@ namespace Compiler {
         // 构造函数 - 从输入字符串创建
         Parser(const std::string& input);
 
+        // 构造函数 - 消费整个预先令牌化的令牌流，词法分析器仅用于计算位置信息
+        Parser(std::shared_ptr<Lexer> lexer, std::shared_ptr<const TokenStream> tokens);
+
         // 执行语法分析
         void parse();
 
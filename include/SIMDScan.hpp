@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef SIMD_SCAN_HPP
+#define SIMD_SCAN_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 字节扫描所用的指令集级别
+    enum class SIMDLevel {
+        SCALAR,     // 逐字节扫描
+        SSE2,       // 每次 16 字节
+        AVX2        // 每次 32 字节
+    };
+
+    // 通过 CPUID 检测当前处理器支持的最高级别
+    SIMDLevel detectSIMDLevel();
+
+    // 获取/设置扫描函数实际使用的级别（默认为检测结果，设置值会被限制在检测结果以内）
+    // 设置仅用于测试和性能对比，不是线程安全的
+    SIMDLevel getActiveSIMDLevel();
+    void setActiveSIMDLevel(SIMDLevel level);
+
+    // 从 position 开始跳过空白字符 (' ', '\t', '\n', '\v', '\f', '\r')，返回第一个非空白字节的位置（或输入结尾）
+    std::size_t scanWhitespace(std::string_view input, std::size_t position);
+
+    // 指定级别的版本，level 必须被当前处理器支持
+    std::size_t scanWhitespace(std::string_view input, std::size_t position, SIMDLevel level);
+
+    // 从 position 开始查找非空的终结符 terminator（词法模式的结束符，如注释的 "*/"，见 DFA_MODE_TERMINATORS），
+    // 返回其后的位置，没有找到时返回 std::string_view::npos
+    std::size_t scanTerminator(std::string_view input, std::size_t position, std::string_view terminator);
+
+    // 指定级别的版本：单字节终结符使用 memchr；标量级别使用 memchr 查找首字节再比较其余字节，
+    // 向量级别一次匹配 16/32 个位置的前两个字节
+    std::size_t scanTerminator(std::string_view input, std::size_t position, std::string_view terminator, SIMDLevel level);
+
+    // scanToAnyByte 一次最多查找的字节数
+    inline constexpr std::size_t MAX_SCAN_BYTES = 3;
+
+    // 从 position 开始查找 bytes[0..count) 中任一字节（1 <= count <= MAX_SCAN_BYTES），返回其位置，没有时返回输入结尾。
+    // 用于 DFA 加速：在除少数字节外都转移回自身的状态中一次跳过整段输入
+    std::size_t scanToAnyByte(std::string_view input, std::size_t position, const unsigned char* bytes, std::size_t count);
+
+    // 指定级别的版本：标量级别在 count 为 1 时使用 memchr，向量级别每次比较 16/32 个字节
+    std::size_t scanToAnyByte(std::string_view input, std::size_t position, const unsigned char* bytes, std::size_t count,
+        SIMDLevel level);
+
+    // 级别到字符串的转换
+    std::string simdLevelToString(SIMDLevel level);
+
+} // namespace Compiler
+
+#endif // SIMD_SCAN_HPP
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef SHUFFLE_DFA_HPP
+#define SHUFFLE_DFA_HPP
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "MaximalMunch.hpp"
+
+namespace Compiler {
+
+    // pshufb 驱动的 DFA 引擎
+    // 状态数不超过 16 时，生成器为每个字节等价类输出一个 16 字节向量 DFA_SHUFFLE_TABLE[类]，
+    // 第 s 个字节为状态 s 的目标状态。推进状态只需一条 pshufb（以当前状态为下标在向量中取字节），
+    // 状态始终留在向量寄存器中，转移的依赖链上没有访存延迟。
+
+    // 生成的规则能否使用 shuffle DFA 且处理器支持 SSSE3
+    bool isShuffleDFASupported();
+
+    // 以 pshufb 推进状态的最长匹配，结果与 MaximalMunch<GeneratedDFA> 相同；不支持时回退为查表
+    MunchResult matchShuffleDFA(std::string_view input, std::size_t start);
+
+    // 在一个寄存器中同时从全部 16 个状态出发运行 block，states[s] 为从状态 s 出发消费整个块后到达的状态
+    // （中途无转移时为 DFA_SHUFFLE_DEAD）。各块的状态映射互不依赖，可以并行计算后按顺序复合
+    void runShuffleDFABlock(std::string_view block, std::uint8_t states[16]);
+
+} // namespace Compiler
+
+#endif // SHUFFLE_DFA_HPP
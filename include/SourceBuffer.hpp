@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef SOURCE_BUFFER_HPP
+#define SOURCE_BUFFER_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 源程序加载方式
+    enum class SourceLoadMethod {
+        NONE,           // 尚未加载
+        MEMORY_MAP,     // 只读内存映射 (正则文件)
+        READ            // 一次预分配缓冲区的读取 (管道、标准输入或不支持映射的平台)
+    };
+
+    // 只读源程序缓冲区
+    // 正则文件通过 mmap 只读映射，不产生任何拷贝；管道和标准输入回退为读入一块预分配的缓冲区。
+    // 无论哪种方式，数据末尾之后都保证至少有一个 '\0' 哨兵字节，词法分析器可直接借用该缓冲区。
+    class SourceBuffer {
+    private:
+        const char* data_;          // 数据起始地址
+        std::size_t size_;          // 数据长度（不含哨兵）
+        void* mapping_;             // 内存映射起始地址 (仅 MEMORY_MAP)
+        std::size_t mappingSize_;   // 内存映射长度 (含哨兵页)
+        std::string storage_;       // 读取回退时持有的数据 (std::string 自带 '\0' 结尾)
+        SourceLoadMethod method_;
+        double loadSeconds_;        // 加载耗时（秒）
+
+        void release();
+#ifndef _WIN32
+        bool loadFromDescriptor(int fd);
+        bool readAll(int fd, std::size_t sizeHint);
+#endif
+
+    public:
+        SourceBuffer();
+        ~SourceBuffer();
+
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+        SourceBuffer(SourceBuffer&& other) noexcept;
+        SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+
+        // 加载文件，失败时返回 false
+        bool loadFile(const std::string& filePath);
+
+        // 从标准输入加载
+        bool loadStdin();
+
+        // 获取数据视图（不含哨兵）
+        std::string_view view() const { return std::string_view(data_, size_); }
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+
+        // 获取加载方式及耗时
+        SourceLoadMethod getLoadMethod() const { return method_; }
+        double getLoadSeconds() const { return loadSeconds_; }
+    };
+
+    // 加载方式到字符串的转换
+    std::string sourceLoadMethodToString(SourceLoadMethod method);
+
+} // namespace Compiler
+
+#endif // SOURCE_BUFFER_HPP
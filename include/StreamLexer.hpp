@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef STREAM_LEXER_HPP
+#define STREAM_LEXER_HPP
+
+#include <istream>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <optional>
+#include "Lexer.hpp"
+
+namespace Compiler {
+
+    // 流式词法分析器
+    // 从文件描述符或 std::istream 读入固定大小的可重复填充缓冲区，已分析完的数据随即丢弃，
+    // 内存占用为 O(缓冲区大小 + 最长令牌)，与输入总长度无关。令牌及词法模式（如注释）可以跨越填充边界：
+    // 填充时保留当前令牌起点之后的全部字节，最长匹配回退到的位置因此始终在缓冲区内；
+    // 单个令牌（含 DFA 向前查看的部分）比缓冲区还长时缓冲区按倍增扩容。
+    // 令牌位置为输入流中的绝对字节偏移（32 位偏移时输入流不能超过 4GB，见 LEXER_WIDE_TOKENS）；
+    // 令牌值由 text 从内部缓冲区取出，只在下一次 nextToken 之前有效。
+    // 不支持 LexerDiagnostics：第一个词法错误即抛出 LexerException，分析随之结束（已读出的数据被丢弃，无法从错误之后继续）；
+    // 未知字符不输出警告，以 UNKNOWN 令牌留给调用者检查。
+    class StreamLexer {
+    private:
+        int fd_;                        // 输入文件描述符（以 std::istream 构造时为 -1）
+        std::istream* stream_;          // 输入流（以文件描述符构造时为 nullptr）
+        std::vector<char> buffer_;      // 缓冲区，有效数据为 [0, filled_)
+        std::size_t base_;              // buffer_[0] 在输入流中的绝对偏移
+        std::size_t filled_;            // 缓冲区中的有效字节数
+        std::size_t position_;          // 当前绝对偏移
+        bool eof_;                      // 输入已读完
+        std::size_t baseLine_;          // base_ 所在的行号
+        std::size_t baseLineStart_;     // base_ 所在行的行首绝对偏移
+        std::size_t refillCount_;       // 填充次数
+        int mode_;                      // 当前词法模式（DFAMode），与 Lexer 相同由令牌动作切换
+        std::size_t modeStart_;         // 进入当前模式的绝对偏移
+        std::optional<SourceLocation> modeStartLocation_; // modeStart_ 被移出缓冲区之前换算出的行列号
+
+        // 缓冲区内有效数据的视图
+        std::string_view window() const { return std::string_view(buffer_.data(), filled_); }
+
+        // 缓冲区末尾对应的绝对偏移
+        std::size_t windowEnd() const { return base_ + filled_; }
+
+        // 丢弃 keepFrom 之前的数据并读入更多数据，输入已读完时返回 false
+        bool refill(std::size_t keepFrom);
+
+        // 从输入读取至多 size 字节
+        std::size_t readInput(char* data, std::size_t size);
+
+        // 从当前位置起进入 mode
+        void enterMode(int mode);
+
+        // 执行令牌动作（BEGIN(mode) 与 skip）：切换模式，返回令牌是否被丢弃
+        bool applyTokenAction(int actionKind);
+
+        // 在非初始模式中分析一步：返回得到的令牌，离开模式或令牌被丢弃时返回空；输入在模式中结束时报告错误
+        std::optional<Token> lexInMode();
+
+        // 使用当前模式的表做最长匹配；actionKind 为带令牌动作的词法单元种类，没有动作时为 DFA_TOKEN_NONE
+        Token runDFA(int& actionKind);
+
+        // 当前位置超出令牌偏移的表示范围时抛出异常
+        void checkOffset() const;
+
+    public:
+        // 默认缓冲区大小
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        // 从文件描述符读取（不接管其所有权）
+        explicit StreamLexer(int fd, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        // 从输入流读取，stream 必须比词法分析器存活得更久
+        explicit StreamLexer(std::istream& stream, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        StreamLexer(const StreamLexer&) = delete;
+        StreamLexer& operator=(const StreamLexer&) = delete;
+
+        // 获取下一个令牌，令牌序列与 Lexer::nextToken 相同
+        Token nextToken();
+
+        // 取出令牌值，token 必须是最近一次 nextToken 返回的令牌（之前的令牌可能已被移出缓冲区）
+        std::string_view text(const Token& token) const { return window().substr(token.offset - base_, token.length); }
+
+        // 获取当前位置信息
+        std::size_t getPosition() const { return position_; }
+
+        // 将字节偏移转换为行列号，position 必须仍在缓冲区内（不早于最近一个令牌的起点）
+        SourceLocation getLocation(std::size_t position) const;
+
+        // 当前缓冲区容量（即峰值缓冲区大小）与填充次数
+        std::size_t getBufferCapacity() const { return buffer_.size(); }
+        std::size_t getRefillCount() const { return refillCount_; }
+    };
+
+} // namespace Compiler
+
+#endif // STREAM_LEXER_HPP
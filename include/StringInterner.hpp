@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef STRING_INTERNER_HPP
+#define STRING_INTERNER_HPP
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace Compiler {
+
+    // 符号编号：同一个字符串在一次编译中总是得到同一个编号，比较两个标识符只需比较编号
+    using SymbolId = std::uint32_t;
+
+    // 表示"没有符号"的编号（非标识符令牌、未经驻留的令牌）
+    inline constexpr SymbolId NO_SYMBOL = UINT32_MAX;
+
+    // 字符串驻留表
+    // 每个不同的字符串只在内部的内存池中保存一份，按首次出现的顺序编号。
+    // 查找使用开放寻址（线性探测）的哈希表，槽中只存编号，哈希值另存一份，
+    // 扩容时无需重新计算哈希，探测时也先比较哈希值再比较字符串。
+    // 返回的名称视图指向内存池，在驻留表销毁之前一直有效。
+    class StringInterner {
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks_;   // 内存池的各个块
+        char* blockCursor_;                             // 当前块中的空闲位置
+        std::size_t blockRemaining_;                    // 当前块的剩余字节数
+        std::size_t arenaBytes_;                        // 内存池已分配的总字节数
+
+        std::vector<std::string_view> names_;   // 编号 -> 名称
+        std::vector<std::uint32_t> hashes_;     // 编号 -> 哈希值
+        std::vector<SymbolId> slots_;           // 哈希表，容量为 2 的幂，空槽为 NO_SYMBOL
+
+        // 把 name 拷贝进内存池
+        std::string_view store(std::string_view name);
+
+        // 容量加倍并重新放置所有编号
+        void grow();
+
+        // 查找 name 所在的槽，不存在时返回应插入的空槽
+        std::size_t findSlot(std::string_view name, std::uint32_t hash) const;
+
+        static std::uint32_t hash(std::string_view name);
+
+    public:
+        // 内存池每块的大小，更长的字符串单独分配一块
+        static constexpr std::size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+        // 哈希表的初始槽数
+        static constexpr std::size_t INITIAL_CAPACITY = 256;
+
+        StringInterner();
+
+        // 名称视图指向内部内存池，禁止拷贝
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+
+        // 驻留 name 并返回其编号，已存在时返回原有编号
+        SymbolId intern(std::string_view name);
+
+        // 查找 name 的编号，不存在时返回 NO_SYMBOL
+        SymbolId find(std::string_view name) const;
+
+        // 获取编号对应的名称
+        std::string_view name(SymbolId symbol) const { return names_[symbol]; }
+
+        // 不同字符串的个数
+        std::size_t size() const { return names_.size(); }
+
+        // 内存池与各数组已分配的总字节数
+        std::size_t memoryBytes() const;
+    };
+
+} // namespace Compiler
+
+#endif // STRING_INTERNER_HPP
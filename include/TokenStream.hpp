@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef TOKEN_STREAM_HPP
+#define TOKEN_STREAM_HPP
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include "Lexer.hpp"
+
+namespace Compiler {
+
+    // 结构数组 (SoA) 形式的令牌序列
+    // 种类、偏移、长度分别存放在三个连续数组中，每个令牌只占 9 字节（LEXER_WIDE_TOKENS 时 13 字节）；
+    // 令牌值由偏移和长度在输入缓冲区中还原，因此令牌流不能比输入缓冲区存活得更久
+    class TokenStream {
+    private:
+        std::string_view input_;                // 令牌所引用的输入
+        std::vector<std::uint8_t> kinds_;       // TokenType
+        std::vector<TokenOffset> offsets_;      // 令牌在输入中的字节偏移，与 Token::offset 同宽
+        std::vector<std::uint32_t> lengths_;    // 令牌长度，与 Token::length 同宽
+
+    public:
+        // 按经验估计的平均每个令牌对应的输入字节数（含空白），用于预分配容量
+        static constexpr std::size_t BYTES_PER_TOKEN = 3;
+
+        // 可容纳的最大输入长度，与令牌相同（见 LEXER_WIDE_TOKENS）
+        static constexpr std::size_t MAX_INPUT_SIZE = MAX_TOKEN_INPUT_SIZE;
+
+        // 只读前向迭代器，解引用得到按值构造的 Token
+        class const_iterator {
+        private:
+            const TokenStream* stream_;
+            std::size_t index_;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Token;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Token;
+
+            const_iterator() : stream_(nullptr), index_(0) {}
+            const_iterator(const TokenStream* stream, std::size_t index) : stream_(stream), index_(index) {}
+
+            Token operator*() const { return (*stream_)[index_]; }
+            const_iterator& operator++() { ++index_; return *this; }
+            const_iterator operator++(int) { const_iterator old = *this; ++index_; return old; }
+            bool operator==(const const_iterator& other) const { return index_ == other.index_ && stream_ == other.stream_; }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+            std::size_t index() const { return index_; }
+        };
+
+        TokenStream() = default;
+
+        // 创建引用 input 的空令牌流，并按输入长度预留容量
+        explicit TokenStream(std::string_view input);
+
+        // 追加一个令牌
+        void push(TokenType type, std::size_t position, std::size_t length) {
+            kinds_.push_back(static_cast<std::uint8_t>(type));
+            offsets_.push_back(static_cast<TokenOffset>(position));
+            lengths_.push_back(static_cast<std::uint32_t>(length));
+        }
+
+        // 按预计令牌数预留容量
+        void reserve(std::size_t tokenCount);
+
+        // 追加另一个令牌流的全部令牌（偏移须已是相对于本令牌流输入的偏移）
+        void append(const TokenStream& other);
+
+        // 访问第 index 个令牌
+        TokenType kind(std::size_t index) const { return static_cast<TokenType>(kinds_[index]); }
+        std::size_t offset(std::size_t index) const { return offsets_[index]; }
+        std::size_t length(std::size_t index) const { return lengths_[index]; }
+        std::string_view value(std::size_t index) const { return input_.substr(offsets_[index], lengths_[index]); }
+        // 令牌流不保存 payload，按值构造的令牌没有 payload（见 Token）
+        Token operator[](std::size_t index) const { return Token(kind(index), offsets_[index], lengths_[index]); }
+
+        std::size_t size() const { return kinds_.size(); }
+        bool empty() const { return kinds_.empty(); }
+        std::string_view input() const { return input_; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        // 三个数组已分配的总字节数
+        std::size_t memoryBytes() const;
+
+        // 转换为 std::vector<Token>
+        std::vector<Token> toVector() const;
+    };
+
+} // namespace Compiler
+
+#endif // TOKEN_STREAM_HPP
@@ -0,0 +1,382 @@
+#include "BatchLexer.hpp"
+#include "SIMDScan.hpp"
+#include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace Compiler {
+
+    namespace {
+
+        // 与 "C" 区域设置下的 std::isspace 一致
+        constexpr bool isWhitespaceByte(int byte) {
+            return byte == ' ' || (byte >= '\t' && byte <= '\r');
+        }
+
+        // 需要停下通道单独处理的令牌：带令牌动作的（如注释开始符）与孤立的注释结束符
+        constexpr bool stopsOnState(int state) {
+            return state < DFA_STATE_COUNT && STATE_TOKEN_TYPES.special[state];
+        }
+
+        // 令牌动作能否在停下的通道中处理：丢弃令牌，或进入一个有终结符（见 DFA_MODE_TERMINATORS）且随后回到初始模式的模式
+        constexpr bool isBatchAction(DFATokenKind kind) {
+            int mode = DFA_TOKEN_NEXT_MODE[kind];
+            return mode == DFA_MODE_KEEP || mode == DFA_MODE_INITIAL
+                || (DFA_MODE_TERMINATORS[mode].length > 0 && DFA_MODE_TERMINATORS[mode].nextMode == DFA_MODE_INITIAL);
+        }
+
+        // 批量转移表：在生成的 DFA 上增加两个状态，按 [状态][字节] 直接索引，省去字节等价类的查表。
+        // DFA 的起始状态表示"位于令牌之间"；某个令牌状态遇到死转移时令牌在此结束，
+        // 同一字节随即从起始状态开始下一个令牌（空白则停在起始状态）；连续的未知字节留在同一个 UNKNOWN 令牌中，
+        // 与设置了诊断收集器的 Lexer 相同。这样做等价于最长匹配的前提是
+        // 令牌结束时不需要回退，即除起始状态外的所有状态都是接受状态，且没有转移回到起始状态；
+        // 此外令牌动作进入的模式都要能由终结符一次跳过。
+        struct BatchTable {
+            static constexpr int UNKNOWN_STATE = DFA_STATE_COUNT;       // 刚消费了一个无法匹配的字节
+            static constexpr int STOPPED_STATE = DFA_STATE_COUNT + 1;   // 遇到带动作的令牌、注释结束符或 '\0' 后停下
+            static constexpr int STATE_COUNT = DFA_STATE_COUNT + 2;
+            static constexpr std::uint8_t STATE_MASK = 0x3F;
+            static constexpr std::uint8_t STARTS_TOKEN = 0x40;          // 本字节开始一个新令牌
+            static constexpr std::uint8_t ENDS_TOKEN = 0x80;            // 之前的令牌在本字节之前结束
+
+            std::uint8_t next[STATE_COUNT][256];
+            bool exact;     // 规则满足上述前提，批量转移表与最长匹配等价
+
+            constexpr BatchTable() : next(), exact(STATE_COUNT <= STATE_MASK + 1) {
+                for (int state = 0; state < DFA_STATE_COUNT; ++state) {
+                    if (state != DFA_START_STATE && DFA_ACCEPT_KIND[state] == DFA_TOKEN_NONE) {
+                        exact = false;
+                    }
+                    if (!isBatchAction(STATE_TOKEN_TYPES.actionKinds[state])) {
+                        exact = false;
+                    }
+                    for (int charClass = 0; charClass < DFA_CLASS_COUNT; ++charClass) {
+                        if (DFA_TRANSITION_TABLE[state][charClass] == DFA_START_STATE) {
+                            exact = false;
+                        }
+                    }
+                }
+                if (!exact) {
+                    return;
+                }
+
+                for (int state = 0; state < STATE_COUNT; ++state) {
+                    for (int byte = 0; byte < 256; ++byte) {
+                        next[state][byte] = transition(state, byte);
+                    }
+                }
+            }
+
+            constexpr std::uint8_t transition(int state, int byte) const {
+                if (state == STOPPED_STATE) {
+                    return STOPPED_STATE;
+                }
+
+                // 令牌继续
+                bool inToken = state != DFA_START_STATE;
+                bool inRule = inToken && state != UNKNOWN_STATE;
+                if (inRule) {
+                    int following = DFA_TRANSITION_TABLE[state][DFA_CHAR_CLASS[byte]];
+                    if (following != DFA_DEAD_STATE) {
+                        return static_cast<std::uint8_t>(following);
+                    }
+                }
+
+                // 令牌结束（或位于令牌之间）：未知字节之后的未知字节延续同一个令牌；需要单独处理的令牌和 '\0' 使通道停下，空白留在令牌之间，其余字节开始新令牌
+                std::uint8_t ends = inToken ? ENDS_TOKEN : 0;
+                if ((inRule && stopsOnState(state)) || byte == '\0') {
+                    return static_cast<std::uint8_t>(STOPPED_STATE | ends);
+                }
+                if (isWhitespaceByte(byte)) {
+                    return static_cast<std::uint8_t>(DFA_START_STATE | ends);
+                }
+                int first = DFA_TRANSITION_TABLE[DFA_START_STATE][DFA_CHAR_CLASS[byte]];
+                if (state == UNKNOWN_STATE && first == DFA_DEAD_STATE) {
+                    return UNKNOWN_STATE;
+                }
+                return static_cast<std::uint8_t>((first != DFA_DEAD_STATE ? first : UNKNOWN_STATE) | STARTS_TOKEN | ends);
+            }
+
+            static constexpr TokenType tokenType(int state) {
+                return state == UNKNOWN_STATE ? TokenType::UNKNOWN : STATE_TOKEN_TYPES.types[state];
+            }
+        };
+        constexpr BatchTable BATCH_TABLE;
+
+        // 空闲通道反复读取的全零块，停在 STOPPED_STATE 上不产生令牌
+        constexpr char IDLE_INPUT[64] = {};
+
+        // 无分支选择：condition 为真时取 ifTrue，否则取 ifFalse
+        template <typename T>
+        inline T choose(bool condition, T ifTrue, T ifFalse) {
+            using Bits = std::make_unsigned_t<T>;
+            Bits mask = Bits(0) - static_cast<Bits>(condition);
+            return static_cast<T>(static_cast<Bits>(ifFalse) ^ ((static_cast<Bits>(ifTrue) ^ static_cast<Bits>(ifFalse)) & mask));
+        }
+
+    } // namespace
+
+    static_assert(sizeof(IDLE_INPUT) >= 64, "idle lanes must be able to run a full round");
+
+    BatchLexer::BatchLexer(std::vector<std::string_view> inputs, std::size_t laneCount)
+        : inputs_(std::move(inputs)), laneCount_(std::clamp<std::size_t>(laneCount, 1, MAX_LANE_COUNT)) {}
+
+    std::optional<LexerException> BatchResult::getError() const {
+        if (!error || error->hasLocation() || error->getOffset() == std::string_view::npos) {
+            return error;
+        }
+        return error->located(LineIndex(tokens.input()).locate(error->getOffset()));
+    }
+
+    void BatchLexer::fail(const Lane& lane, LexerErrorKind kind, std::size_t position, std::size_t length,
+        std::vector<BatchResult>& results, int mode) const {
+        BatchResult& result = results[lane.input];
+        result.diagnostics.report(kind, position, length, static_cast<std::uint8_t>(mode));
+        if (!result.error && kind != LexerErrorKind::UNKNOWN_CHARACTERS) {
+            result.error.emplace(lexerErrorMessage(kind, {}, mode), position);
+        }
+    }
+
+    bool BatchLexer::startInput(Lane& lane, std::size_t& nextInput, std::vector<BatchResult>& results) const {
+        while (nextInput < inputs_.size()) {
+            lane.input = nextInput++;
+            std::string_view input = inputs_[lane.input];
+            results[lane.input].tokens = TokenStream(input);
+            if (input.size() > TokenStream::MAX_INPUT_SIZE) {
+                results[lane.input].error.emplace("Input too large for a token stream", 0, 0);
+                continue;
+            }
+            if (input.empty()) {
+                continue;
+            }
+
+            lane.data = input.data();
+            lane.size = input.size();
+            lane.base = 0;
+            lane.state = DFA_START_STATE;
+            lane.tokenStart = 0;
+            lane.eventCount = 0;
+            return true;
+        }
+        return false;
+    }
+
+    // 孤立的注释结束符是错误，记录后作为 UNKNOWN 令牌继续分析；其余令牌按生成的令牌动作处理：不被丢弃的令牌照常写入，进入的模式由其终结符
+    // 向量化跳过（结果与 Lexer 的 lexInMode 相同），找不到终结符时报告进入该模式的位置
+    bool BatchLexer::applyTokenAction(Lane& lane, int state, std::size_t start, std::size_t end,
+        std::vector<BatchResult>& results) const {
+        TokenType type = BatchTable::tokenType(state);
+        std::size_t resume = end;
+        if (type == TokenType::COMMENT_LAST) {
+            fail(lane, LexerErrorKind::ISOLATED_COMMENT_END, start, end - start, results);
+            results[lane.input].tokens.push(TokenType::UNKNOWN, start, end - start);
+        }
+        else {
+            DFATokenKind kind = STATE_TOKEN_TYPES.actionKinds[state];
+            if (!DFA_TOKEN_SKIP[kind]) {
+                emitToken(lane, type, start, end, results);
+            }
+
+            int mode = DFA_TOKEN_NEXT_MODE[kind];
+            if (mode != DFA_MODE_KEEP && mode != DFA_MODE_INITIAL) {
+                resume = scanTerminator(std::string_view(lane.data, lane.size), end, modeTerminator(mode));
+                if (resume == std::string_view::npos) {
+                    fail(lane, LexerErrorKind::UNTERMINATED_MODE, end, lane.size - end, results, mode);
+                    return false;
+                }
+            }
+        }
+        lane.base = resume;
+        lane.state = DFA_START_STATE;
+        lane.tokenStart = 0;
+        return lane.base < lane.size;
+    }
+
+    void BatchLexer::emitToken(Lane& lane, TokenType type, std::size_t start, std::size_t end,
+        std::vector<BatchResult>& results) const {
+        // 令牌流不保存数值，分类只用于识别关键字与检查数字范围，越界的数字与 Lexer 相同作为 UNKNOWN 令牌
+        std::optional<LexerErrorKind> error;
+        Token token = classifyToken(type, start, std::string_view(lane.data + start, end - start), error);
+        if (error) {
+            fail(lane, *error, start, end - start, results);
+        }
+        else if (token.type == TokenType::UNKNOWN) {
+            fail(lane, LexerErrorKind::UNKNOWN_CHARACTERS, start, end - start, results);
+        }
+
+        results[lane.input].tokens.push(token.type, start, token.length);
+    }
+
+    bool BatchLexer::finishRound(Lane& lane, std::size_t steps, std::vector<BatchResult>& results) const {
+        std::size_t base = lane.base;
+        std::size_t eventCount = lane.eventCount;
+        lane.eventCount = 0;
+
+        for (std::size_t index = 0; index < eventCount; ++index) {
+            const LaneEvent& event = lane.events[index];
+            std::size_t start = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(base) + event.start);
+            std::size_t end = base + static_cast<std::size_t>(event.end);
+            TokenType type = BatchTable::tokenType(event.state);
+
+            // 需要单独处理的令牌一定是通道停下前的最后一个令牌
+            if (stopsOnState(event.state)) {
+                return applyTokenAction(lane, event.state, start, end, results);
+            }
+
+            emitToken(lane, type, start, end, results);
+        }
+
+        // 没有需要单独处理的令牌时停下是因为遇到了 '\0'，与 Lexer 相同视为输入结尾
+        if (lane.state == BatchTable::STOPPED_STATE) {
+            return false;
+        }
+
+        lane.base = base + steps;
+        lane.tokenStart -= static_cast<std::ptrdiff_t>(steps);
+        if (lane.base < lane.size) {
+            return true;
+        }
+
+        // 输入结尾处的令牌
+        if (lane.state != DFA_START_STATE) {
+            std::size_t start = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(lane.base) + lane.tokenStart);
+            TokenType type = BatchTable::tokenType(lane.state);
+            if (stopsOnState(lane.state)) {
+                return applyTokenAction(lane, lane.state, start, lane.size, results);
+            }
+            emitToken(lane, type, start, lane.size, results);
+        }
+        return false;
+    }
+
+    // 每轮让所有通道前进相同的步数，步数不超过任何活动通道的剩余字节数，循环体因此无需检查边界。
+    // 每一步是一次 [状态][字节] 查表加几条无分支的算术：令牌边界总是写入缓冲区，只有表项标记令牌结束时
+    // 计数才加一。各通道的状态链互不依赖，处理器可以同时执行多条通道的查表。
+    // 通道状态放在局部数组中，通道循环由折叠表达式在编译期展开，数组下标都是常量，编译器可以把它们分配到寄存器
+    template <std::size_t LANES>
+    void BatchLexer::lexLanes(std::vector<BatchResult>& results) const {
+        auto idle = [](Lane& lane) {
+            lane.data = IDLE_INPUT;
+            lane.size = sizeof(IDLE_INPUT);
+            lane.base = 0;
+            lane.state = BatchTable::STOPPED_STATE;
+            lane.tokenStart = 0;
+            lane.eventCount = 0;
+        };
+
+        Lane lanes[LANES];
+        unsigned activeMask = 0;
+        std::size_t nextInput = 0;
+        for (std::size_t index = 0; index < LANES; ++index) {
+            if (startInput(lanes[index], nextInput, results)) {
+                activeMask |= 1u << index;
+            }
+            else {
+                idle(lanes[index]);
+            }
+        }
+
+        while (activeMask != 0) {
+            std::size_t steps = EVENT_CAPACITY;
+            for (std::size_t index = 0; index < LANES; ++index) {
+                if ((activeMask & (1u << index)) != 0) {
+                    steps = std::min(steps, lanes[index].size - lanes[index].base);
+                }
+                else {
+                    lanes[index].base = 0;
+                }
+            }
+
+            const char* cursor[LANES];
+            int state[LANES];
+            std::ptrdiff_t tokenStart[LANES];
+            std::size_t eventCount[LANES];
+            for (std::size_t index = 0; index < LANES; ++index) {
+                cursor[index] = lanes[index].data + lanes[index].base;
+                state[index] = lanes[index].state;
+                tokenStart[index] = lanes[index].tokenStart;
+                eventCount[index] = lanes[index].eventCount;
+            }
+
+            auto advance = [&](std::size_t index, std::size_t round) {
+                std::uint8_t entry = BATCH_TABLE.next[state[index]][static_cast<unsigned char>(cursor[index][round])];
+                LaneEvent& event = lanes[index].events[eventCount[index]];
+                event.start = tokenStart[index];
+                event.end = static_cast<std::int32_t>(round);
+                event.state = state[index];
+                eventCount[index] += entry >> 7;
+                tokenStart[index] = choose((entry & BatchTable::STARTS_TOKEN) != 0, static_cast<std::ptrdiff_t>(round), tokenStart[index]);
+                state[index] = entry & BatchTable::STATE_MASK;
+            };
+            [&]<std::size_t... INDEX>(std::index_sequence<INDEX...>) {
+                for (std::size_t round = 0; round < steps; ++round) {
+                    (advance(INDEX, round), ...);
+                }
+            }(std::make_index_sequence<LANES>());
+
+            for (std::size_t index = 0; index < LANES; ++index) {
+                lanes[index].state = state[index];
+                lanes[index].tokenStart = tokenStart[index];
+                lanes[index].eventCount = eventCount[index];
+            }
+
+            // 本输入分析完（或出错）后换下一个输入，没有剩余输入时通道停止
+            for (std::size_t index = 0; index < LANES; ++index) {
+                if ((activeMask & (1u << index)) == 0 || finishRound(lanes[index], steps, results)) {
+                    continue;
+                }
+                if (!startInput(lanes[index], nextInput, results)) {
+                    activeMask &= ~(1u << index);
+                    idle(lanes[index]);
+                }
+            }
+        }
+    }
+
+    void BatchLexer::lexSerial(std::vector<BatchResult>& results) const {
+        for (std::size_t index = 0; index < inputs_.size(); ++index) {
+            BatchResult& result = results[index];
+            result.tokens = TokenStream(inputs_[index]);
+            if (inputs_[index].size() > TokenStream::MAX_INPUT_SIZE) {
+                result.error.emplace("Input too large for a token stream", 0, 0);
+                continue;
+            }
+
+            // 诊断收集器记下全部错误，第一个不是未知字符的错误作为 BatchResult::error
+            Lexer lexer(inputs_[index], 0, false);
+            lexer.setDiagnostics(&result.diagnostics);
+            for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+                result.tokens.push(token.type, token.offset, token.length);
+            }
+            for (const LexerDiagnostic& diagnostic : result.diagnostics.entries()) {
+                if (diagnostic.kind != LexerErrorKind::UNKNOWN_CHARACTERS) {
+                    result.error.emplace(LexerDiagnostics::message(diagnostic, inputs_[index]), diagnostic.offset);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<BatchResult> BatchLexer::tokenizeStreams() const {
+        std::vector<BatchResult> results(inputs_.size());
+        if (!BATCH_TABLE.exact) {
+            lexSerial(results);
+            return results;
+        }
+
+        switch (laneCount_) {
+        case 1: lexLanes<1>(results); break;
+        case 2: lexLanes<2>(results); break;
+        case 3: lexLanes<3>(results); break;
+        case 4: lexLanes<4>(results); break;
+        case 5: lexLanes<5>(results); break;
+        case 6: lexLanes<6>(results); break;
+        case 7: lexLanes<7>(results); break;
+        default: lexLanes<8>(results); break;
+        }
+        return results;
+    }
+
+} // namespace Compiler
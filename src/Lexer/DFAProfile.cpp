@@ -0,0 +1,80 @@
+#include "DFAProfile.hpp"
+#include <algorithm>
+#include <fstream>
+#include <queue>
+
+namespace Compiler {
+
+    DFAProfile::DFAProfile(int start, std::size_t stateCount, std::size_t classCount,
+        const std::vector<int>& byteClass, const std::vector<int>& transitions)
+        : classCount_(classCount), canonicalId_(stateCount, -1), classByte_(classCount, -1),
+          stateVisits_(stateCount, 0), transitionVisits_(stateCount * classCount, 0) {
+        for (int byte = 255; byte >= 0; --byte) {
+            classByte_[byteClass[byte]] = byte;
+        }
+
+        // 与 DFAGenerator 的 DFA::canonicalOrder 相同：广度优先，每个状态的转移按字节从小到大访问
+        int nextId = 0;
+        std::queue<int> pending;
+        if (stateCount > 0) {
+            canonicalId_[start] = nextId++;
+            pending.push(start);
+        }
+        while (!pending.empty()) {
+            int state = pending.front();
+            pending.pop();
+            for (int byte = 0; byte < 256; ++byte) {
+                int target = transitions[static_cast<std::size_t>(state) * classCount + byteClass[byte]];
+                if (target >= 0 && canonicalId_[target] < 0) {
+                    canonicalId_[target] = nextId++;
+                    pending.push(target);
+                }
+            }
+        }
+
+        // 不可达的状态按ID追加在末尾
+        for (int& id : canonicalId_) {
+            if (id < 0) {
+                id = nextId++;
+            }
+        }
+    }
+
+    void DFAProfile::clear() {
+        std::fill(stateVisits_.begin(), stateVisits_.end(), 0);
+        std::fill(transitionVisits_.begin(), transitionVisits_.end(), 0);
+    }
+
+    bool DFAProfile::writeToFile(const std::string& filePath) const {
+        std::ofstream outFile(filePath);
+        if (!outFile.is_open()) {
+            return false;
+        }
+
+        // 按规范编号排列，使同一套规则的剖析文件便于比较
+        std::vector<int> stateOfCanonical(canonicalId_.size());
+        for (std::size_t state = 0; state < canonicalId_.size(); ++state) {
+            stateOfCanonical[canonicalId_[state]] = static_cast<int>(state);
+        }
+
+        outFile << "# DFA profile: visit counts by canonical state ID (breadth-first from the start state, bytes ascending)\n";
+        outFile << "dfa " << canonicalId_.size() << "\n";
+        for (std::size_t id = 0; id < stateOfCanonical.size(); ++id) {
+            int state = stateOfCanonical[id];
+            if (stateVisits_[state] != 0) {
+                outFile << "state " << id << " " << stateVisits_[state] << "\n";
+            }
+        }
+        for (std::size_t id = 0; id < stateOfCanonical.size(); ++id) {
+            int state = stateOfCanonical[id];
+            for (std::size_t charClass = 0; charClass < classCount_; ++charClass) {
+                std::uint64_t visits = transitionVisits_[static_cast<std::size_t>(state) * classCount_ + charClass];
+                if (visits != 0) {
+                    outFile << "transition " << id << " " << classByte_[charClass] << " " << visits << "\n";
+                }
+            }
+        }
+        return static_cast<bool>(outFile);
+    }
+
+} // namespace Compiler
@@ -0,0 +1,239 @@
+#include "IncrementalLexer.hpp"
+#include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Compiler {
+
+    IncrementalLexer::IncrementalLexer(std::string_view text)
+        : text_(text) {
+        checkInputSize(text_);
+        frontLines_.push_back(Checkpoint{ 0, 0, DFA_MODE_INITIAL });
+        relex();
+    }
+
+    void IncrementalLexer::checkInputSize(std::string_view text) {
+        if (text.size() > MAX_TOKEN_INPUT_SIZE) {
+            throw LexerException("Input too large for 32-bit token offsets (build with LEXER_WIDE_TOKENS)", 0, 0);
+        }
+    }
+
+    void IncrementalLexer::applyEdit(std::string_view text, std::size_t start, std::size_t removedLength,
+        std::size_t insertedLength) {
+        if (start > text_.size() || removedLength > text_.size() - start ||
+            text.size() != text_.size() - removedLength + insertedLength) {
+            throw std::invalid_argument("Edit range does not match the edited text");
+        }
+        checkInputSize(text);
+
+        // 编辑位置之前的行首状态不受编辑影响；间隙之后的元素按到结尾的距离保存，换成新文本后依然有效。
+        // 重新分析从间隙之前最后一个可恢复的检查点开始，没有时从文本开头开始
+        moveGap(start);
+        while (frontLines_.back().offset != 0 && !isResumableMode(frontLines_.back().mode)) {
+            moveGap(frontLines_.back().offset - 1);
+        }
+        text_ = text;
+        editEnd_ = start + insertedLength;
+        relex();
+    }
+
+    // 跨过间隙的元素在两种表示之间转换，转换使用移动时（旧文本）的长度和令牌数
+    void IncrementalLexer::moveGap(std::size_t offset) {
+        std::size_t textSize = text_.size();
+        std::size_t tokenCount = size();
+        auto flip = [&](Checkpoint line) {
+            line.offset = textSize - line.offset;
+            line.firstToken = tokenCount - line.firstToken;
+            return line;
+        };
+
+        while (frontLines_.size() > 1 && frontLines_.back().offset > offset) {
+            backLines_.push_back(flip(frontLines_.back()));
+            frontLines_.pop_back();
+        }
+        while (!backLines_.empty() && textSize - backLines_.back().offset <= offset) {
+            frontLines_.push_back(flip(backLines_.back()));
+            backLines_.pop_back();
+        }
+
+        std::size_t firstToken = frontLines_.back().firstToken;
+        while (frontTokens_.size() > firstToken) {
+            Token token = frontTokens_.back();
+            token.offset = static_cast<TokenOffset>(textSize - token.offset);
+            backTokens_.push_back(token);
+            frontTokens_.pop_back();
+        }
+        while (frontTokens_.size() < firstToken) {
+            Token token = backTokens_.back();
+            token.offset = static_cast<TokenOffset>(textSize - token.offset);
+            frontTokens_.push_back(token);
+            backTokens_.pop_back();
+        }
+    }
+
+    // 新行首与旧文本中同一位置的行首（到结尾的距离相同）处于同一个可恢复的模式时，之后的分析结果必然相同。
+    // 比较之前丢弃间隙之后位于该行首之前的旧令牌和旧检查点，它们已被重新分析的结果取代
+    bool IncrementalLexer::checkpoint(std::size_t offset, std::uint8_t mode) {
+        frontLines_.push_back(Checkpoint{ offset, frontTokens_.size(), mode });
+        if (offset < editEnd_) {
+            return false;
+        }
+
+        std::size_t fromEnd = text_.size() - offset;
+        while (!backTokens_.empty() && backTokens_.back().offset > fromEnd) {
+            backTokens_.pop_back();
+        }
+        while (!backLines_.empty() && backLines_.back().offset > fromEnd) {
+            backLines_.pop_back();
+        }
+        if (backLines_.empty() || backLines_.back().offset != fromEnd || backLines_.back().mode != mode || !isResumableMode(mode)) {
+            return false;
+        }
+
+        backLines_.pop_back();
+        relexEnd_ = offset;
+        return true;
+    }
+
+    // 模式切换记录的位置即新模式生效的位置，行首所处的模式是位置不超过行首的最后一条记录
+    bool IncrementalLexer::recordLines(std::size_t begin, std::size_t end, const std::vector<Lexer::ModeChange>& changes,
+        std::size_t& next, std::uint8_t& mode) {
+        for (const void* found = std::memchr(text_.data() + begin, '\n', end - begin); found != nullptr;) {
+            std::size_t lineStart = static_cast<std::size_t>(static_cast<const char*>(found) - text_.data()) + 1;
+            while (next < changes.size() && changes[next].offset <= lineStart) {
+                mode = static_cast<std::uint8_t>(changes[next].mode);
+                ++next;
+            }
+            if (checkpoint(lineStart, mode)) {
+                return true;
+            }
+            found = std::memchr(text_.data() + lineStart, '\n', end - lineStart);
+        }
+        return false;
+    }
+
+    void IncrementalLexer::relex() {
+        const Checkpoint start = frontLines_.back();
+        std::size_t firstNewToken = frontTokens_.size();
+        relexBegin_ = start.offset;
+
+        // 未重新同步时间隙之后的旧结果全部作废，错误状态由本次分析决定
+        auto finish = [&](bool synchronized, std::size_t end) {
+            relexTokens_ = frontTokens_.size() - firstNewToken;
+            if (!synchronized) {
+                relexEnd_ = end;
+                backTokens_.clear();
+                backLines_.clear();
+                tokenError_.reset();
+                unterminatedMode_ = DFA_MODE_INITIAL;
+            }
+        };
+
+        // 在行首删除整行时，起点本身就可能与旧检查点重新同步
+        frontLines_.pop_back();
+        if (checkpoint(start.offset, start.mode)) {
+            finish(true, start.offset);
+            return;
+        }
+
+        // 令牌之间的区间可能含有被丢弃的令牌（如注释），其中各行首所处的模式由分析器的模式切换记录给出
+        std::vector<Lexer::ModeChange> changes;
+        std::size_t nextChange = 0;
+        std::uint8_t mode = start.mode;
+        Lexer lexer(text_, start.offset, true, start.mode);
+        lexer.modeChanges_ = &changes;
+        std::size_t previousEnd = start.offset;
+        try {
+            while (true) {
+                Token token = lexer.nextToken();
+                if (recordLines(previousEnd, token.offset, changes, nextChange, mode)) {
+                    finish(true, token.offset);
+                    return;
+                }
+                if (token.type == TokenType::EOF_TOKEN) {
+                    finish(false, token.offset);
+                    unterminatedMode_ = static_cast<std::uint8_t>(lexer.mode_);
+                    return;
+                }
+                frontTokens_.push_back(token);
+                previousEnd = token.end();
+            }
+        }
+        catch (const LexerException& ex) {
+            // 令牌错误的位置即出错令牌的起点
+            std::size_t errorOffset = ex.getOffset();
+            if (recordLines(previousEnd, errorOffset, changes, nextChange, mode)) {
+                finish(true, errorOffset);
+                return;
+            }
+            finish(false, errorOffset);
+            tokenError_ = TokenError{ ex.what(), text_.size() - errorOffset };
+        }
+    }
+
+    Token IncrementalLexer::operator[](std::size_t index) const {
+        if (index < frontTokens_.size()) {
+            return frontTokens_[index];
+        }
+        Token token = backTokens_[backTokens_.size() - 1 - (index - frontTokens_.size())];
+        token.offset = static_cast<TokenOffset>(text_.size() - token.offset);
+        return token;
+    }
+
+    TokenStream IncrementalLexer::toStream() const {
+        TokenStream tokens(text_);
+        for (std::size_t index = 0; index < size(); ++index) {
+            Token token = (*this)[index];
+            tokens.push(token.type, token.offset, token.length);
+        }
+        return tokens;
+    }
+
+    // 检查点每行一个，第 i 个检查点（间隙之前与之后合起来按文本顺序计）即第 i + 1 行的行首
+    SourceLocation IncrementalLexer::locate(std::size_t offset) const {
+        // 间隙之后的检查点到结尾的距离随下标递增，第一个不小于 offset 到结尾距离的即 offset 所在行
+        std::size_t fromEnd = text_.size() - offset;
+        auto back = std::lower_bound(backLines_.begin(), backLines_.end(), fromEnd,
+            [](const Checkpoint& line, std::size_t distance) { return line.offset < distance; });
+        if (back != backLines_.end()) {
+            std::size_t line = frontLines_.size() + static_cast<std::size_t>(backLines_.end() - back);
+            return SourceLocation{ line, back->offset - fromEnd + 1 };
+        }
+
+        auto front = std::upper_bound(frontLines_.begin(), frontLines_.end(), offset,
+            [](std::size_t position, const Checkpoint& line) { return position < line.offset; });
+        std::size_t line = static_cast<std::size_t>(front - frontLines_.begin());
+        return SourceLocation{ line, offset - frontLines_[line - 1].offset + 1 };
+    }
+
+    std::optional<LexerException> IncrementalLexer::getError() const {
+        if (tokenError_) {
+            std::size_t offset = text_.size() - tokenError_->fromEnd;
+            return LexerException(tokenError_->message, offset, locate(offset));
+        }
+        if (unterminatedMode_ == DFA_MODE_INITIAL) {
+            return std::nullopt;
+        }
+
+        // 未结束的模式报告进入该模式的位置（注释为 "/*" 之后）：从最后一个处于初始模式的行首重新分析找到该位置
+        std::size_t lineStart = 0;
+        auto outside = [](const Checkpoint& line) { return line.mode == DFA_MODE_INITIAL; };
+        auto back = std::find_if(backLines_.begin(), backLines_.end(), outside);
+        if (back != backLines_.end()) {
+            lineStart = text_.size() - back->offset;
+        }
+        else {
+            auto front = std::find_if(frontLines_.rbegin(), frontLines_.rend(), outside);
+            lineStart = front != frontLines_.rend() ? front->offset : 0;
+        }
+
+        Lexer lexer(text_, lineStart, true);
+        while (lexer.nextToken().type != TokenType::EOF_TOKEN) {
+        }
+        return LexerException(lexerErrorMessage(LexerErrorKind::UNTERMINATED_MODE, {}, unterminatedMode_), lexer.modeStart_,
+            locate(lexer.modeStart_));
+    }
+
+} // namespace Compiler
@@ -1,17 +1,23 @@
 #include "Lexer.hpp"
+#include "SourceBuffer.hpp"
+#include "TokenStream.hpp"
+#include "SIMDScan.hpp"
 #include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+#include "MaximalMunch.hpp"
+#include "DFAProfile.hpp"
+#include "DFA_DirectCoded.hpp"
+#include "ShuffleDFA.hpp"
+#include "Keyword_Table.hpp"
+#include "NumberParser.hpp"
+#include <array>
 #include <cctype>
-#include <unordered_set>
+#include <stdexcept>
+#include <utility>
 #include <iomanip>  // std::setw, std::left
 
 namespace Compiler {
 
-    // 关键字集合
-    static const std::unordered_set<std::string> keywords = {
-        "if", "else", "while", "for", "return", "int", "float", "char", "string",
-        "bool", "true", "false","read","write"
-    };
-
     std::string tokenTypeToString(TokenType type) {
         switch (type) {
         case TokenType::IDENTIFIER: return "IDENTIFIER";
@@ -29,27 +35,103 @@ namespace Compiler {
         }
     }
 
-    // 将 DFA 的 token 名称映射到 TokenType 枚举
-    TokenType Lexer::mapTokenName(const std::string& tokenName) {
-        if (tokenName == "<identifier>") return TokenType::IDENTIFIER;
-        if (tokenName == "<number>") return TokenType::NUMBER;
-        if (tokenName == "<singleword>") return TokenType::SINGLEWORD;
-        if (tokenName == "<comparison_double>") return TokenType::COMPARISON_DOUBLE;
-        if (tokenName == "<comparison_single>") return TokenType::COMPARISON_SINGLE;
-        if (tokenName == "<division>") return TokenType::DIVISION;
-        if (tokenName == "<commentfirst>") return TokenType::COMMENT_FIRST;
-        if (tokenName == "<commentlast>") return TokenType::COMMENT_LAST;
-        return TokenType::UNKNOWN;
+    // 不记录失败的最长匹配：定义 LEXER_DIRECT_CODED 时使用生成的直接编码函数；
+    // 否则规则不超过 16 个状态且处理器支持 SSSE3 时使用 shuffle DFA，其余情况查转移表
+    static MunchResult matchLongest(std::string_view input, std::size_t start) {
+#ifdef LEXER_DIRECT_CODED
+        std::size_t end = start;
+        int acceptState = matchDirectCoded(input, start, end);
+        return MunchResult{ acceptState, end };
+#else
+        static const bool useShuffle = isShuffleDFASupported();
+        if (useShuffle) {
+            return matchShuffleDFA(input, start);
+        }
+        return MaximalMunch<GeneratedDFA>::match(input, start, nullptr);
+#endif
+    }
+
+    // 各词法模式的最长匹配函数，按模式编号索引
+    using ModeMatcher = MunchResult (*)(std::string_view, std::size_t, MunchMemo*);
+
+    template <std::size_t... Modes>
+    static constexpr std::array<ModeMatcher, sizeof...(Modes)> makeModeMatchers(std::index_sequence<Modes...>) {
+        return { &MaximalMunch<GeneratedModeDFA<static_cast<int>(Modes)>>::match... };
     }
 
-    bool isKeyword(const std::string& identifier) {
-        return keywords.find(identifier) != keywords.end();
+    static constexpr std::array<ModeMatcher, DFA_MODE_COUNT> MODE_MATCHERS =
+        makeModeMatchers(std::make_index_sequence<DFA_MODE_COUNT>());
+
+    // 令牌偏移为 32 位时输入不能超过 4GB
+    static void checkTokenInputSize(std::string_view input) {
+        if (input.size() > MAX_TOKEN_INPUT_SIZE) {
+            throw LexerException("Input too large for 32-bit token offsets (build with LEXER_WIDE_TOKENS)", 0, 0);
+        }
+    }
+
+    // 关键字由生成的完美哈希表识别（见 input/keywords.txt 与 Keyword_Table.hpp）
+    bool isKeyword(std::string_view identifier) {
+        return lookupKeyword(identifier) != KeywordId::NONE;
+    }
+
+    std::int64_t numberValue(const Token& token, std::string_view input) {
+        if (token.hasPayload) {
+            return token.payload;
+        }
+        std::int64_t value = 0;
+        parseDecimal(token.text(input), value);
+        return value;
+    }
+
+    Token classifyToken(TokenType type, std::size_t offset, std::string_view value,
+        std::optional<LexerErrorKind>& error) {
+        if constexpr (MAX_TOKEN_INPUT_SIZE > UINT32_MAX) {
+            // 令牌长度放不进 32 位，返回的 UNKNOWN 令牌长度记为 0，诊断中保留完整长度
+            if (value.size() > UINT32_MAX) {
+                error = LexerErrorKind::TOKEN_TOO_LONG;
+                return Token(TokenType::UNKNOWN, offset, 0);
+            }
+        }
+
+        if (type == TokenType::IDENTIFIER && isKeyword(value)) {
+            return Token(TokenType::KEYWORD, offset, value.size());
+        }
+
+        // 超出 64 位有符号整数范围的数字是词法错误；不超过 32 位的数值直接放入令牌
+        if (type == TokenType::NUMBER) {
+            std::int64_t number = 0;
+            if (!parseDecimal(value, number)) {
+                error = LexerErrorKind::NUMBER_OUT_OF_RANGE;
+                return Token(TokenType::UNKNOWN, offset, value.size());
+            }
+            if (number <= UINT32_MAX) {
+                return Token(type, offset, value.size(), static_cast<std::uint32_t>(number));
+            }
+        }
+
+        return Token(type, offset, value.size());
     }
 
     // 词法分析器类实现
     // 构造函数
-    Lexer::Lexer(const std::string& input)
-        : input_(input), position_(0), line_(1), column_(1) {}
+    Lexer::Lexer(std::string input)
+        : storage_(std::move(input)), input_(storage_), position_(0), symbols_(std::make_shared<StringInterner>()) {
+        checkTokenInputSize(input_);
+        setLookaheadDepth(DEFAULT_LOOKAHEAD_DEPTH);
+    }
+
+    Lexer::Lexer(const SourceBuffer& source)
+        : input_(source.view()), position_(0), symbols_(std::make_shared<StringInterner>()) {
+        checkTokenInputSize(input_);
+        setLookaheadDepth(DEFAULT_LOOKAHEAD_DEPTH);
+    }
+
+    Lexer::Lexer(std::string_view input, std::size_t begin, bool chunked, int mode)
+        : input_(input), position_(begin), mode_(mode), modeStart_(mode == DFA_MODE_INITIAL ? 0 : std::string_view::npos),
+          chunked_(chunked) {
+        checkTokenInputSize(input_);
+        setLookaheadDepth(DEFAULT_LOOKAHEAD_DEPTH);
+    }
 
     // 获取当前字符
     char Lexer::currentChar() {
@@ -71,218 +153,357 @@ namespace Compiler {
     // 向前移动一个字符
     void Lexer::advance() {
         if (position_ < input_.size()) {
-            if (currentChar() == '\n') {
-                line_++;
-                column_ = 1;
-            }
-            else {
-                column_++;
-            }
             position_++;
         }
     }
 
-    // 跳过空白字符（包括换行符）
+    // 跳过空白字符（包括换行符），整段空白由向量化扫描一次跳过
     void Lexer::skipWhitespace() {
-        while (std::isspace(currentChar())) {
-            advance();
-        }
+        position_ = scanWhitespace(input_, position_);
     }
 
-    // 跳过注释
-    void Lexer::skipComment() {
-        std::size_t commentStartLine = line_;
-        std::size_t commentStartColumn = column_;
-
-        // 当遇到 /* 时，继续读取直到遇到 */
-        while (currentChar() != '\0') {
-            if (currentChar() == '*' && peekChar(1) == '/') {
-                // 找到注释结束符 */
-                advance(); // 跳过 *
-                advance(); // 跳过 /
-                return;
-            }
-            advance();
+    void Lexer::endInsideMode() {
+        // 分块模式下模式可能在后续块中结束，保留模式与进入的位置，由调用者拼接时判断
+        if (chunked_) {
+            return;
         }
 
-        // 如果到达这里，说明注释没有结束
-        throw LexerException("Unterminated comment", commentStartLine, commentStartColumn);
+        // 构造没有结束，报告进入该模式的位置（注释为 "/*" 之后）；继续分析时回到初始模式，之后只返回 EOF
+        hasError_ = true;
+        if (!diagnostics_) {
+            throw errorAt(lexerErrorMessage(LexerErrorKind::UNTERMINATED_MODE, {}, mode_), modeStart_);
+        }
+        diagnostics_->report(LexerErrorKind::UNTERMINATED_MODE, modeStart_, input_.size() - modeStart_,
+            static_cast<std::uint8_t>(mode_));
+        mode_ = DFA_MODE_INITIAL;
     }
 
-    // 获取下一个令牌
-    Token Lexer::nextToken() {
-        // 跳过空白字符（包括换行符）
-        skipWhitespace();
-
-        // 获取当前字符
-        char c = currentChar();
+    void Lexer::lexError(LexerErrorKind kind, std::size_t offset, std::size_t length) {
+        hasError_ = true;
+        if (diagnostics_) {
+            diagnostics_->report(kind, offset, length);
+            return;
+        }
+        LexerDiagnostic diagnostic{ kind, static_cast<std::uint8_t>(mode_), offset, length };
+        throw errorAt(LexerDiagnostics::message(diagnostic, input_), offset);
+    }
 
-        // EOF 处理
-        if (c == '\0') {
-            return Token(TokenType::EOF_TOKEN, "", line_, column_, position_);
+    LexerException Lexer::errorAt(const std::string& message, std::size_t offset) const {
+        if (chunked_) {
+            return LexerException(message, offset);
         }
+        return LexerException(message, offset, getLocation(offset));
+    }
 
-        // 使用 DFA 表驱动词法分析
-        Token token = runDFA();
+    void Lexer::enterMode(int mode) {
+        mode_ = mode;
+        modeStart_ = position_;
+        if (modeChanges_) {
+            modeChanges_->push_back(ModeChange{ position_, mode });
+        }
+    }
 
-        // 特殊处理：遇到注释开始符 /* 时，跳过整个注释
-        if (token.type == TokenType::COMMENT_FIRST) {
-            skipComment();
-            // 递归调用获取下一个有效 token
-            return nextToken();
+    bool Lexer::applyTokenAction(int actionKind) {
+        if (DFA_TOKEN_NEXT_MODE[actionKind] != DFA_MODE_KEEP) {
+            enterMode(DFA_TOKEN_NEXT_MODE[actionKind]);
         }
+        return DFA_TOKEN_SKIP[actionKind];
+    }
 
-        // 特殊处理: 遇到*/时, 检查是否是孤立的注释结束符
-        if (token.type == TokenType::COMMENT_LAST) {
-            throw LexerException("Isolated comment end '*/' found", token.line, token.column);
+    // 非初始模式中分析：生成器为注释这样的模式推导出终结符（见 DFA_MODE_TERMINATORS）时，已证明对所有输入
+    // 查该模式的表与查找终结符结果相同，一次向量化扫描即可跳过整个模式；其余模式查该模式的表，其中的空白由模式的规则匹配
+    std::optional<Token> Lexer::lexInMode() {
+        std::string_view terminator = modeTerminator(mode_);
+        if (!terminator.empty()) {
+            std::size_t end = scanTerminator(input_, position_, terminator);
+            if (end != std::string_view::npos) {
+                position_ = end;
+                enterMode(DFA_MODE_TERMINATORS[mode_].nextMode);
+                return std::nullopt;
+            }
+            position_ = input_.size();
+        }
+        if (position_ >= input_.size()) {
+            endInsideMode();
+            return Token(TokenType::EOF_TOKEN, position_, 0);
         }
 
+        int actionKind = DFA_TOKEN_NONE;
+        Token token = runDFA(actionKind);
+        if (actionKind != DFA_TOKEN_NONE && applyTokenAction(actionKind)) {
+            return std::nullopt;
+        }
         return token;
     }
 
+    // 分析下一个令牌
+    // 令牌动作由生成的表决定：BEGIN(mode) 切换之后使用的 DFA 表，skip 的令牌（注释的各部分）被丢弃后继续循环，
+    // 连续大量注释时栈深度保持不变。初始模式之外的分析见 lexInMode。
+    // 初始模式下接受的令牌不是 special 状态（见 StateTokenTypes）时立即输出，不再经过 acceptMatch 中
+    // 对模式、令牌动作与孤立 "*/" 的判断；未启用剖析与表格化最长匹配时也不经过 matchAt 的分派
+    Token Lexer::lexToken() {
+        while (true) {
+            if (mode_ != DFA_MODE_INITIAL) [[unlikely]] {
+                std::optional<Token> token = lexInMode();
+                if (token) {
+                    return *token;
+                }
+                continue;
+            }
+
+            // 跳过空白字符（包括换行符）
+            skipWhitespace();
+
+            // EOF 处理
+            if (currentChar() == '\0') {
+                return Token(TokenType::EOF_TOKEN, position_, 0);
+            }
+
+            // 使用 DFA 表驱动词法分析
+            std::size_t startPos = position_;
+            MunchResult match = profile_ || munchMemo_ ? matchAt(startPos) : matchLongest(input_, startPos);
+            if (match.acceptState >= 0 && !STATE_TOKEN_TYPES.special[match.acceptState]) [[likely]] {
+                ++dfaRuns_;
+                position_ = match.end;
+                return makeToken(STATE_TOKEN_TYPES.types[match.acceptState], startPos, match.end);
+            }
+
+            int actionKind = DFA_TOKEN_NONE;
+            Token token = acceptMatch(match, startPos, actionKind);
+            if (actionKind != DFA_TOKEN_NONE && applyTokenAction(actionKind)) {
+                continue;
+            }
+
+            // 特殊处理: 遇到*/时, 检查是否是孤立的注释结束符
+            if (token.type == TokenType::COMMENT_LAST) {
+                lexError(LexerErrorKind::ISOLATED_COMMENT_END, token.offset, token.length);
+                return Token(TokenType::UNKNOWN, token.offset, token.length);
+            }
+
+            return token;
+        }
+    }
+
     // 重置词法分析器
     void Lexer::reset() {
         position_ = 0;
-        line_ = 1;
-        column_ = 1;
+        mode_ = DFA_MODE_INITIAL;
+        modeStart_ = 0;
+        lookaheadHead_ = 0;
+        lookaheadCount_ = 0;
+        hasError_ = false;
+    }
+
+    // 行首偏移索引只在需要行列号时建立一次
+    const LineIndex& Lexer::getLineIndex() const {
+        if (!lineIndex_) {
+            lineIndex_.emplace(input_);
+        }
+        return *lineIndex_;
     }
 
     // DFA 驱动的词法分析核心方法
-    Token Lexer::runDFA() {
+    // 最长匹配：直接索引转移表，遇到死状态或输入结尾时停止，回退到最后一次接受的位置；
+    // 启用表格化最长匹配时跳过已知失败的 (状态, 位置)，启用剖析时记录访问次数。二者都按初始模式的状态编号，只用于初始模式
+    MunchResult Lexer::matchAt(std::size_t startPos) {
+        if (mode_ != DFA_MODE_INITIAL) {
+            return MODE_MATCHERS[mode_](input_, startPos, nullptr);
+        }
+        if (profile_) {
+            return profile_->match<GeneratedDFA>(input_, startPos);
+        }
+        if (munchMemo_) {
+            return MaximalMunch<GeneratedDFA>::match(input_, startPos, &*munchMemo_);
+        }
+        return matchLongest(input_, startPos);
+    }
+
+    Token Lexer::runDFA(int& actionKind) {
         std::size_t startPos = position_;
-        std::size_t startLine = line_;
-        std::size_t startColumn = column_;
-        std::string value;
-
-        int currentState = DFA_START_STATE;
-        int lastAcceptState = -1;
-        std::size_t lastAcceptPos = position_;
-        std::size_t lastAcceptLine = line_;
-        std::size_t lastAcceptColumn = column_;
-        std::string lastAcceptValue;
-
-        // DFA 主循环：不断读取字符并转移状态
-        while (currentChar() != '\0') {
-            char c = currentChar();
-
-            // 检查当前状态是否为接受状态
-            if (DFA_ACCEPT_STATES.find(currentState) != DFA_ACCEPT_STATES.end()) {
-                lastAcceptState = currentState;
-                lastAcceptPos = position_;
-                lastAcceptLine = line_;
-                lastAcceptColumn = column_;
-                lastAcceptValue = value;
-            }
+        return acceptMatch(matchAt(startPos), startPos, actionKind);
+    }
 
-            // 查找状态转移
-            auto stateIt = DFA_TRANSITION_TABLE.find(currentState);
-            if (stateIt == DFA_TRANSITION_TABLE.end()) {
-                // 当前状态没有转移表，结束
-                break;
-            }
+    Token Lexer::acceptMatch(const MunchResult& match, std::size_t startPos, int& actionKind) {
+        ++dfaRuns_;
+        int lastAcceptState = match.acceptState;
+        std::size_t lastAcceptPos = match.end;
 
-            auto transIt = stateIt->second.find(c);
-            if (transIt == stateIt->second.end()) {
-                // 当前字符无法转移，结束
-                break;
-            }
+        // 如果找到了接受状态，前进到最后的接受位置
+        if (lastAcceptState >= 0) {
+            position_ = lastAcceptPos;
 
-            // 执行状态转移
-            currentState = transIt->second;
-            value += c;
-            advance();
+            // 获取 token 类型与令牌动作；被丢弃的令牌不需要进一步处理
+            TokenType type;
+            if (mode_ == DFA_MODE_INITIAL) {
+                type = STATE_TOKEN_TYPES.types[lastAcceptState];
+                actionKind = STATE_TOKEN_TYPES.actionKinds[lastAcceptState];
+            }
+            else {
+                DFATokenKind kind = DFA_MODE_TABLES[mode_].acceptKind[lastAcceptState];
+                type = tokenTypeOfKind(kind);
+                actionKind = hasTokenAction(kind) ? kind : DFA_TOKEN_NONE;
+            }
+            if (actionKind != DFA_TOKEN_NONE && DFA_TOKEN_SKIP[actionKind]) {
+                return Token(type, startPos, lastAcceptPos - startPos);
+            }
+            return makeToken(type, startPos, lastAcceptPos);
         }
 
-        // 检查最终状态是否为接受状态
-        if (DFA_ACCEPT_STATES.find(currentState) != DFA_ACCEPT_STATES.end()) {
-            lastAcceptState = currentState;
-            lastAcceptPos = position_;
-            lastAcceptLine = line_;
-            lastAcceptColumn = column_;
-            lastAcceptValue = value;
+        // 没有找到接受状态，消费一个字符作为未知 token，保证词法分析继续前进
+        advance();
+        hasError_ = true;
+        if (diagnostics_) {
+            // 初始模式中连续的未知字符（之间没有空白）合并为一个令牌，只记录一条诊断
+            while (mode_ == DFA_MODE_INITIAL && position_ < input_.size() && input_[position_] != '\0'
+                && scanWhitespace(input_, position_) == position_ && matchLongest(input_, position_).acceptState < 0) {
+                ++position_;
+            }
+            diagnostics_->report(LexerErrorKind::UNKNOWN_CHARACTERS, startPos, position_ - startPos);
         }
+        return Token(TokenType::UNKNOWN, startPos, position_ - startPos);
+    }
 
-        // 如果找到了接受状态，回退到最后的接受位置
-        if (lastAcceptState != -1) {
-            // 回退到最后接受位置
-            position_ = lastAcceptPos;
-            line_ = lastAcceptLine;
-            column_ = lastAcceptColumn;
+    Token Lexer::makeToken(TokenType type, std::size_t startPos, std::size_t end) {
+        std::string_view value = input_.substr(startPos, end - startPos);
+        std::optional<LexerErrorKind> error;
+        Token token = classifyToken(type, startPos, value, error);
+        if (error) {
+            lexError(*error, startPos, value.size());
+            return token;
+        }
 
-            // 获取 token 类型
-            std::string tokenName = DFA_ACCEPT_STATES.at(lastAcceptState);
-            TokenType type = mapTokenName(tokenName);
+        // 不是关键字的标识符驻留为符号编号
+        if (token.type == TokenType::IDENTIFIER && symbols_) {
+            return Token(token.type, startPos, value.size(), symbols_->intern(value));
+        }
+        return token;
+    }
 
-            // 特殊处理：标识符可能是关键字
-            if (type == TokenType::IDENTIFIER && isKeyword(lastAcceptValue)) {
-                type = TokenType::KEYWORD;
-            }
+    void Lexer::setTabulatingMunch(bool enabled) {
+        if (!enabled) {
+            munchMemo_.reset();
+        }
+        else if (!munchMemo_) {
+            munchMemo_.emplace(DFA_STATE_COUNT, input_.size());
+        }
+    }
 
-            return Token(type, lastAcceptValue, startLine, startColumn, startPos);
+    void Lexer::setLookaheadDepth(std::size_t depth) {
+        if (lookaheadCount_ != 0) {
+            throw std::logic_error("Cannot change lookahead depth while tokens are buffered");
         }
+        lookaheadDepth_ = depth > 0 ? depth : 1;
 
-        // 没有找到接受状态，返回错误
-        return Token(TokenType::UNKNOWN, value, startLine, startColumn, startPos);
+        // 容量取 2 的幂，环形下标用掩码回绕
+        std::size_t capacity = 1;
+        while (capacity < lookaheadDepth_) {
+            capacity *= 2;
+        }
+        lookahead_.assign(capacity, LookaheadSlot{ Token(TokenType::EOF_TOKEN, 0, 0), 0 });
+        lookaheadHead_ = 0;
     }
 
-    // 查看下一个令牌但不消费它
-    Token Lexer::peekToken() {
-        // 保存当前状态
-        std::size_t savedPosition = position_;
-        std::size_t savedLine = line_;
-        std::size_t savedColumn = column_;
+    // 查看第 index 个令牌：已在缓冲区中时直接返回（旧的 peekToken 在此处会重新分析一次），
+    // 否则依次分析并追加到缓冲区尾部
+    const Token& Lexer::peek(std::size_t index) {
+        if (index >= lookaheadDepth_) {
+            throw std::out_of_range("Lookahead index exceeds lookahead depth");
+        }
 
-        // 获取下一个token
-        Token token = nextToken();
+        std::size_t mask = lookahead_.size() - 1;
+        if (index < lookaheadCount_) {
+            LookaheadSlot& slot = lookahead_[(lookaheadHead_ + index) & mask];
+            dfaRunsSaved_ += slot.dfaRuns;
+            return slot.token;
+        }
 
-        // 恢复状态
-        position_ = savedPosition;
-        line_ = savedLine;
-        column_ = savedColumn;
+        while (lookaheadCount_ <= index) {
+            std::size_t runsBefore = dfaRuns_;
+            Token token = lexToken();
+            lookahead_[(lookaheadHead_ + lookaheadCount_) & mask] = LookaheadSlot{ token, dfaRuns_ - runsBefore };
+            ++lookaheadCount_;
+        }
+        return lookahead_[(lookaheadHead_ + index) & mask].token;
+    }
 
-        return token;
+    // 消费下一个令牌：取自缓冲区的令牌已被查看过，省去了一次重新分析
+    Token Lexer::consume() {
+        if (lookaheadCount_ == 0) {
+            return lexToken();
+        }
+
+        LookaheadSlot& slot = lookahead_[lookaheadHead_];
+        dfaRunsSaved_ += slot.dfaRuns;
+        lookaheadHead_ = (lookaheadHead_ + 1) & (lookahead_.size() - 1);
+        --lookaheadCount_;
+        return slot.token;
     }
 
     // 检查是否到达输入结尾
     bool Lexer::isAtEnd() const {
-        return position_ >= input_.size();
+        return lookaheadCount_ == 0 && position_ >= input_.size();
     }
 
     // 令牌化整个输入
     std::vector<Token> Lexer::tokenize() {
         std::vector<Token> tokens;
 
-        try {
-            while (currentChar() != '\0') {
-                Token token = nextToken();
-
-                // 如果遇到EOF token，结束循环
-                if (token.type == TokenType::EOF_TOKEN) {
-                    break;
-                }
+        // 词法错误抛出的 LexerException 直接交给调用者；设置了诊断收集器时错误已被记录，不再输出警告。
+        // 循环以 EOF 令牌结束，向前查看缓冲区中已分析的令牌同样被取出
+        while (true) {
+            Token token = nextToken();
+            if (token.type == TokenType::EOF_TOKEN) {
+                break;
+            }
 
-                tokens.push_back(token);
+            tokens.push_back(token);
 
-                // 如果遇到未知 token，可以选择报错或继续
-                if (token.type == TokenType::UNKNOWN && !token.value.empty()) {
-                    // 这里可以记录错误，但继续分析
-                    std::cerr << "Warning: Unknown character '" << token.value
-                        << "' at line " << token.line
-                        << ", column " << token.column << std::endl;
-                }
+            // 未知字符输出警告后继续分析
+            if (token.type == TokenType::UNKNOWN && token.length != 0 && !diagnostics_) {
+                warnUnknownToken(token);
             }
         }
-        catch (const LexerException& ex) {
-            throw ex; // 重新抛出异常以便上层处理
+
+        return tokens;
+    }
+
+    // 令牌化整个输入，结果以结构数组形式存放，容量按输入长度一次预留
+    TokenStream Lexer::tokenizeStream() {
+        if (input_.size() > TokenStream::MAX_INPUT_SIZE) {
+            throw LexerException("Input too large for a token stream", 0, 0);
         }
 
+        TokenStream tokens(input_);
+        while (true) {
+            Token token = nextToken();
+            if (token.type == TokenType::EOF_TOKEN) {
+                break;
+            }
+
+            tokens.push(token.type, token.offset, token.length);
+
+            if (token.type == TokenType::UNKNOWN && token.length != 0 && !diagnostics_) {
+                warnUnknownToken(token);
+            }
+        }
         return tokens;
     }
 
+    // 报告未知字符，词法分析继续进行
+    void Lexer::warnUnknownToken(const Token& token) const {
+        SourceLocation location = getLocation(token.offset);
+        std::cerr << "Warning: Unknown character '" << text(token)
+            << "' at line " << location.line
+            << ", column " << location.column << std::endl;
+    }
+
 } // namespace Compiler
 
 // 输出词法分析结果，格式适合语法分析器使用
-void outputLexerResults(const std::vector<Compiler::Token>& tokens, std::ostream& out) {
+void outputLexerResults(const std::vector<Compiler::Token>& tokens, const Compiler::Lexer& lexer,
+    std::ostream& out) {
+    const Compiler::LineIndex& lines = lexer.getLineIndex();
+
     // 输出文件头注释
     out << "# Lexical Analysis Results" << std::endl;
     out << "# Format: TokenType TokenValue Line Column" << std::endl;
@@ -292,7 +513,7 @@ void outputLexerResults(const std::vector<Compiler::Token>& tokens, std::ostream
     // 输出每个 token，格式：类型 值 行号 列号
     for (const auto& token : tokens) {
         std::string typeStr = Compiler::tokenTypeToString(token.type);
-        std::string valueStr = token.value;
+        std::string valueStr(lexer.text(token));
 
         // 处理特殊字符：在值中包含空格或特殊字符时用引号包围
         bool needQuotes = false;
@@ -334,8 +555,9 @@ void outputLexerResults(const std::vector<Compiler::Token>& tokens, std::ostream
         }
 
         // 输出格式：类型 值 行号 列号
+        Compiler::SourceLocation location = lines.locate(token.offset);
         out << typeStr << " " << valueStr << " "
-            << token.line << " " << token.column << std::endl;
+            << location.line << " " << location.column << std::endl;
     }
 
     out << std::endl;
@@ -0,0 +1,57 @@
+#include "LexerDiagnostics.hpp"
+#include "DFA_Tables.hpp"
+#include <algorithm>
+
+namespace Compiler {
+
+    // 说明中最多引用的出错文本长度
+    static constexpr std::size_t MAX_QUOTED_BYTES = 32;
+
+    LexerDiagnostics::LexerDiagnostics(std::size_t capacity)
+        : capacity_(capacity) {
+        entries_.reserve(capacity);
+    }
+
+    void LexerDiagnostics::clear() {
+        entries_.clear();
+        dropped_ = 0;
+    }
+
+    std::string lexerErrorMessage(LexerErrorKind kind, std::string_view text, int mode) {
+        switch (kind) {
+        case LexerErrorKind::UNKNOWN_CHARACTERS:
+            return std::string(text.size() == 1 ? "Unknown character '" : "Unknown characters '")
+                + std::string(text.substr(0, MAX_QUOTED_BYTES)) + (text.size() > MAX_QUOTED_BYTES ? "...'" : "'");
+        case LexerErrorKind::UNTERMINATED_MODE:
+            return std::string("Unterminated ") + DFA_MODE_NAMES[mode];
+        case LexerErrorKind::ISOLATED_COMMENT_END:
+            return "Isolated comment end '*/' found";
+        case LexerErrorKind::NUMBER_OUT_OF_RANGE:
+            return "Number literal out of range";
+        case LexerErrorKind::TOKEN_TOO_LONG:
+            return "Token too long";
+        }
+        return "Unknown lexical error";
+    }
+
+    std::string LexerDiagnostics::message(const LexerDiagnostic& diagnostic, std::string_view input) {
+        std::string_view text;
+        if (diagnostic.kind == LexerErrorKind::UNKNOWN_CHARACTERS) {
+            text = input.substr(diagnostic.offset, diagnostic.length);
+        }
+        return lexerErrorMessage(diagnostic.kind, text, diagnostic.mode);
+    }
+
+    void LexerDiagnostics::print(std::ostream& out, std::string_view input, const LineIndex& lineIndex) const {
+        for (const LexerDiagnostic& diagnostic : entries_) {
+            SourceLocation location = lineIndex.locate(diagnostic.offset);
+            out << "LexError (in line:" << location.line << ", in column:" << location.column << "): "
+                << message(diagnostic, input) << '\n';
+        }
+        if (dropped_ > 0) {
+            out << "... " << dropped_ << " more lexical errors not shown\n";
+        }
+        out.flush();
+    }
+
+} // namespace Compiler
@@ -0,0 +1,35 @@
+#include "LineIndex.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Compiler {
+
+    LineIndex::LineIndex()
+        : lineStarts_{ 0 } {}
+
+    LineIndex::LineIndex(std::string_view input)
+        : lineStarts_{ 0 } {
+        // 按平均每行 32 字节预留，避免多次扩容
+        lineStarts_.reserve(input.size() / 32 + 1);
+
+        const char* data = input.data();
+        const char* end = data + input.size();
+        const char* cursor = data;
+        while (cursor < end) {
+            const void* found = std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor));
+            if (found == nullptr) {
+                break;
+            }
+            cursor = static_cast<const char*>(found) + 1;
+            lineStarts_.push_back(static_cast<std::size_t>(cursor - data));
+        }
+    }
+
+    SourceLocation LineIndex::locate(std::size_t offset) const {
+        // 第一个大于 offset 的行首的前一行即为 offset 所在行
+        auto it = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+        std::size_t line = static_cast<std::size_t>(it - lineStarts_.begin());
+        return SourceLocation{ line, offset - lineStarts_[line - 1] + 1 };
+    }
+
+} // namespace Compiler
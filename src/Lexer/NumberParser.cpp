@@ -0,0 +1,50 @@
+#include "NumberParser.hpp"
+#include <bit>
+#include <cstring>
+#include <limits>
+
+namespace Compiler {
+
+    namespace {
+
+        // 合并 8 个 ASCII 数字（小端序下第一个数字位于最低字节）：
+        // 先减去 '0' 得到每字节一位，再依次把相邻的 1 位、2 位、4 位合并成 2 位、4 位、8 位数
+        inline std::uint64_t parseEightDigits(const char* digits) {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, digits, sizeof(chunk));
+            chunk -= 0x3030303030303030ULL;
+            chunk = chunk * 10 + (chunk >> 8);
+            return (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        }
+
+    } // namespace
+
+    bool parseDecimal(std::string_view digits, std::int64_t& value) {
+        std::size_t index = 0;
+        while (index < digits.size() && digits[index] == '0') {
+            ++index;
+        }
+        if (digits.size() - index > MAX_DECIMAL_DIGITS) {
+            return false;
+        }
+
+        // 至多 19 位有效数字，累加过程中不会溢出 64 位无符号整数
+        std::uint64_t result = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; digits.size() - index >= 8; index += 8) {
+                result = result * 100000000 + parseEightDigits(digits.data() + index);
+            }
+        }
+        for (; index < digits.size(); ++index) {
+            result = result * 10 + static_cast<std::uint64_t>(digits[index] - '0');
+        }
+
+        if (result > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            return false;
+        }
+        value = static_cast<std::int64_t>(result);
+        return true;
+    }
+
+} // namespace Compiler
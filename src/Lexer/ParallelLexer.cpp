@@ -0,0 +1,167 @@
+#include "ParallelLexer.hpp"
+#include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+#include "NumberParser.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace Compiler {
+
+    ParallelLexer::ParallelLexer(std::string_view input, unsigned threadCount)
+        : input_(input), threadCount_(threadCount), chunkCount_(0), whole_(input, 0, false),
+          symbols_(std::make_shared<StringInterner>()) {
+        if (threadCount_ == 0) {
+            threadCount_ = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    // 按线程数均分输入，再把每个切分点推迟到其后的第一个换行符之后
+    std::vector<std::size_t> ParallelLexer::splitChunks() const {
+        // 单线程时不切分，避免推测分析带来的重复工作；有模式不能从行首恢复时也不切分
+        std::size_t size = input_.size();
+        std::size_t target = threadCount_ == 1 || !allModesResumable() ? 1 : std::max<std::size_t>(1, std::min<std::size_t>(
+            static_cast<std::size_t>(threadCount_) * CHUNKS_PER_THREAD, size / MIN_CHUNK_SIZE));
+
+        std::vector<std::size_t> starts{ 0 };
+        for (std::size_t index = 1; index < target; ++index) {
+            std::size_t split = std::max(size / target * index, starts.back());
+            const void* found = std::memchr(input_.data() + split, '\n', size - split);
+            if (found == nullptr) {
+                break;
+            }
+            std::size_t start = static_cast<std::size_t>(static_cast<const char*>(found) - input_.data()) + 1;
+            if (start >= size) {
+                break;
+            }
+            if (start > starts.back()) {
+                starts.push_back(start);
+            }
+        }
+        starts.push_back(size);
+        return starts;
+    }
+
+    // 块内的分析器只看到输入前缀 [0, end)，令牌偏移因此直接是整个输入中的偏移；
+    // 由于初始模式的令牌不含换行符，最长匹配不会越过块结尾，结果与串行分析该段时相同。
+    // 起始模式不是初始模式时，分析器从块开头直接进入该模式（有终结符的模式先查找终结符）
+    ParallelLexer::ChunkResult ParallelLexer::lexChunk(std::size_t begin, std::size_t end, int startMode) const {
+        ChunkResult result;
+        std::string_view prefix = input_.substr(0, end);
+
+        result.tokens.reserve((end - begin) / TokenStream::BYTES_PER_TOKEN + 16);
+        Lexer lexer(prefix, begin, true, startMode);
+        try {
+            while (true) {
+                Token token = lexer.nextToken();
+                if (token.type == TokenType::EOF_TOKEN) {
+                    break;
+                }
+                result.tokens.push(token.type, token.offset, token.length);
+            }
+        }
+        catch (const LexerException& ex) {
+            result.error = ex;
+            return result;
+        }
+
+        result.endMode = lexer.mode_;
+        result.modeStart = lexer.mode_ != DFA_MODE_INITIAL ? lexer.modeStart_ : std::string_view::npos;
+        result.stopped = lexer.position_ < end;
+        return result;
+    }
+
+    TokenStream ParallelLexer::tokenizeStream() {
+        if (input_.size() > TokenStream::MAX_INPUT_SIZE) {
+            throw LexerException("Input too large for a token stream", 0, 0);
+        }
+
+        std::vector<std::size_t> starts = splitChunks();
+        chunkCount_ = starts.size() - 1;
+
+        // 工作线程按块号领取任务，每块按每种起始模式各分析一次（第一块一定从初始模式开始）；
+        // 块 index 以模式 mode 开始的结果位于 variants[index * DFA_MODE_COUNT + mode]
+        std::vector<ChunkResult> variants(chunkCount_ * DFA_MODE_COUNT);
+        std::atomic<std::size_t> nextChunk{ 0 };
+        auto work = [&]() {
+            for (std::size_t index = nextChunk.fetch_add(1); index < chunkCount_; index = nextChunk.fetch_add(1)) {
+                int modeCount = index > 0 ? DFA_MODE_COUNT : 1;
+                for (int mode = 0; mode < modeCount; ++mode) {
+                    variants[index * DFA_MODE_COUNT + mode] = lexChunk(starts[index], starts[index + 1], mode);
+                }
+            }
+        };
+
+        std::size_t workerCount = std::min<std::size_t>(threadCount_, chunkCount_);
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (std::size_t index = 1; index < workerCount; ++index) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        // 按顺序拼接：根据前一块结尾所处的模式选取本块的推测结果
+        TokenStream tokens(input_);
+        int mode = DFA_MODE_INITIAL;
+        std::size_t modeStart = std::string_view::npos;
+        for (std::size_t index = 0; index < chunkCount_; ++index) {
+            const ChunkResult& chunk = variants[index * DFA_MODE_COUNT + mode];
+
+            std::size_t first = tokens.size();
+            tokens.append(chunk.tokens);
+            for (std::size_t token = first; token < tokens.size(); ++token) {
+                if (tokens.kind(token) == TokenType::UNKNOWN) {
+                    whole_.warnUnknownToken(tokens[token]);
+                }
+            }
+
+            // 块内错误只记录了偏移，选定变体之后才换算行列号
+            if (chunk.error) {
+                throw chunk.error->located(whole_.getLocation(chunk.error->getOffset()));
+            }
+            if (chunk.stopped) {
+                return tokens;
+            }
+
+            // 整块都在同一模式中时沿用之前记录的进入位置
+            if (chunk.modeStart != std::string_view::npos) {
+                modeStart = chunk.modeStart;
+            }
+            mode = chunk.endMode;
+        }
+
+        // 输入结尾仍处于非初始模式中，与串行分析相同地报告进入该模式的位置（注释为 "/*" 之后）
+        if (mode != DFA_MODE_INITIAL) {
+            throw LexerException(lexerErrorMessage(LexerErrorKind::UNTERMINATED_MODE, {}, mode), modeStart, whole_.getLocation(modeStart));
+        }
+
+        return tokens;
+    }
+
+    // 令牌流不保存负载，拼接之后按令牌顺序补上：驻留顺序因此与串行分析相同；
+    // 超出 64 位范围的数字在分析时已报错，这里的转换总是成功
+    std::vector<Token> ParallelLexer::tokenize() {
+        TokenStream stream = tokenizeStream();
+        std::vector<Token> tokens;
+        tokens.reserve(stream.size());
+        for (std::size_t index = 0; index < stream.size(); ++index) {
+            Token token = stream[index];
+            if (token.type == TokenType::IDENTIFIER) {
+                token = Token(token.type, token.offset, token.length, symbols_->intern(stream.value(index)));
+            }
+            else if (token.type == TokenType::NUMBER) {
+                std::int64_t number = 0;
+                if (parseDecimal(stream.value(index), number) && number <= UINT32_MAX) {
+                    token = Token(token.type, token.offset, token.length, static_cast<std::uint32_t>(number));
+                }
+            }
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+
+} // namespace Compiler
@@ -0,0 +1,348 @@
+#include "SIMDScan.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_SCAN_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要为单个函数启用 AVX2，MSVC 可直接使用内建函数
+#if defined(SIMD_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_AVX2
+#endif
+
+namespace Compiler {
+
+    namespace {
+
+        // 与 "C" 区域设置下的 std::isspace 一致
+        inline bool isWhitespaceByte(unsigned char c) {
+            return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+        }
+
+        // 计算 32 位掩码中最低置位的下标
+        inline unsigned countTrailingZeros32(unsigned mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        // 标量跳过 [pos, size) 中的空白，也用作向量版本的尾部处理
+        std::size_t skipWhitespaceScalar(const char* data, std::size_t size, std::size_t pos) {
+            while (pos < size && isWhitespaceByte(static_cast<unsigned char>(data[pos]))) {
+                pos++;
+            }
+            return pos;
+        }
+
+        // 标量查找终结符：memchr 定位首字节，再比较其余字节
+        std::size_t findTerminatorScalar(const char* data, std::size_t size, std::size_t pos,
+            const char* text, std::size_t length) {
+            while (pos + length <= size) {
+                const void* first = std::memchr(data + pos, text[0], size - length + 1 - pos);
+                if (first == nullptr) {
+                    break;
+                }
+                pos = static_cast<std::size_t>(static_cast<const char*>(first) - data);
+                if (std::memcmp(data + pos + 1, text + 1, length - 1) == 0) {
+                    return pos + length;
+                }
+                pos++;
+            }
+            return std::string_view::npos;
+        }
+
+        // 标量查找 bytes 中任一字节：只有一个时用 memchr
+        std::size_t findAnyByteScalar(const char* data, std::size_t size, std::size_t pos,
+            const unsigned char* bytes, std::size_t count) {
+            if (count == 1) {
+                const void* found = pos < size ? std::memchr(data + pos, bytes[0], size - pos) : nullptr;
+                return found != nullptr ? static_cast<std::size_t>(static_cast<const char*>(found) - data) : size;
+            }
+            for (; pos < size; pos++) {
+                unsigned char c = static_cast<unsigned char>(data[pos]);
+                for (std::size_t index = 0; index < count; index++) {
+                    if (c == bytes[index]) {
+                        return pos;
+                    }
+                }
+            }
+            return size;
+        }
+
+#ifdef SIMD_SCAN_X86
+
+        std::size_t findAnyByteSSE2(const char* data, std::size_t size, std::size_t pos,
+            const unsigned char* bytes, std::size_t count) {
+            __m128i targets[MAX_SCAN_BYTES];
+            for (std::size_t index = 0; index < count; index++) {
+                targets[index] = _mm_set1_epi8(static_cast<char>(bytes[index]));
+            }
+
+            while (pos + 16 <= size) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+                __m128i match = _mm_cmpeq_epi8(block, targets[0]);
+                for (std::size_t index = 1; index < count; index++) {
+                    match = _mm_or_si128(match, _mm_cmpeq_epi8(block, targets[index]));
+                }
+                unsigned matchMask = static_cast<unsigned>(_mm_movemask_epi8(match));
+                if (matchMask != 0) {
+                    return pos + countTrailingZeros32(matchMask);
+                }
+                pos += 16;
+            }
+            return findAnyByteScalar(data, size, pos, bytes, count);
+        }
+
+        SIMD_TARGET_AVX2
+        std::size_t findAnyByteAVX2(const char* data, std::size_t size, std::size_t pos,
+            const unsigned char* bytes, std::size_t count) {
+            __m256i targets[MAX_SCAN_BYTES];
+            for (std::size_t index = 0; index < count; index++) {
+                targets[index] = _mm256_set1_epi8(static_cast<char>(bytes[index]));
+            }
+
+            while (pos + 32 <= size) {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+                __m256i match = _mm256_cmpeq_epi8(block, targets[0]);
+                for (std::size_t index = 1; index < count; index++) {
+                    match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, targets[index]));
+                }
+                unsigned matchMask = static_cast<unsigned>(_mm256_movemask_epi8(match));
+                if (matchMask != 0) {
+                    return pos + countTrailingZeros32(matchMask);
+                }
+                pos += 32;
+            }
+            return findAnyByteSSE2(data, size, pos, bytes, count);
+        }
+
+        std::size_t skipWhitespaceSSE2(const char* data, std::size_t size, std::size_t pos) {
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i lowBound = _mm_set1_epi8('\t' - 1);
+            const __m128i highBound = _mm_set1_epi8('\r' + 1);
+
+            while (pos + 16 <= size) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+                // '\t'..'\r' 用有符号比较判断区间，>= 0x80 的字节为负数，不会落入区间
+                __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, lowBound), _mm_cmplt_epi8(block, highBound));
+                __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(block, space), inRange);
+                unsigned stopMask = ~static_cast<unsigned>(_mm_movemask_epi8(isSpace)) & 0xFFFFu;
+                if (stopMask != 0) {
+                    return pos + countTrailingZeros32(stopMask);
+                }
+                pos += 16;
+            }
+            return skipWhitespaceScalar(data, size, pos);
+        }
+
+        SIMD_TARGET_AVX2
+        std::size_t skipWhitespaceAVX2(const char* data, std::size_t size, std::size_t pos) {
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i lowBound = _mm256_set1_epi8('\t' - 1);
+            const __m256i highBound = _mm256_set1_epi8('\r' + 1);
+
+            while (pos + 32 <= size) {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+                __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi8(block, lowBound), _mm256_cmpgt_epi8(highBound, block));
+                __m256i isSpace = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), inRange);
+                unsigned stopMask = ~static_cast<unsigned>(_mm256_movemask_epi8(isSpace));
+                if (stopMask != 0) {
+                    return pos + countTrailingZeros32(stopMask);
+                }
+                pos += 32;
+            }
+            // 剩余不足 32 字节时交给 SSE2 和标量处理
+            return skipWhitespaceSSE2(data, size, pos);
+        }
+
+        // 同时加载 pos 与 pos + 1 处的块，二者分别与终结符的前两个字节比较后相与，即得候选的起始位置，
+        // 再逐个比较候选处其余的字节（如注释结束符 "*/" 只有两个字节，候选即为匹配）
+        std::size_t findTerminatorSSE2(const char* data, std::size_t size, std::size_t pos,
+            const char* text, std::size_t length) {
+            const __m128i first = _mm_set1_epi8(text[0]);
+            const __m128i second = _mm_set1_epi8(text[1]);
+
+            while (pos + 15 + length <= size) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+                __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+                __m128i pair = _mm_and_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(next, second));
+                for (unsigned pairMask = static_cast<unsigned>(_mm_movemask_epi8(pair)); pairMask != 0; pairMask &= pairMask - 1) {
+                    std::size_t candidate = pos + countTrailingZeros32(pairMask);
+                    if (std::memcmp(data + candidate + 2, text + 2, length - 2) == 0) {
+                        return candidate + length;
+                    }
+                }
+                pos += 16;
+            }
+            return findTerminatorScalar(data, size, pos, text, length);
+        }
+
+        SIMD_TARGET_AVX2
+        std::size_t findTerminatorAVX2(const char* data, std::size_t size, std::size_t pos,
+            const char* text, std::size_t length) {
+            const __m256i first = _mm256_set1_epi8(text[0]);
+            const __m256i second = _mm256_set1_epi8(text[1]);
+
+            while (pos + 31 + length <= size) {
+                __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+                __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + 1));
+                __m256i pair = _mm256_and_si256(_mm256_cmpeq_epi8(block, first), _mm256_cmpeq_epi8(next, second));
+                for (unsigned pairMask = static_cast<unsigned>(_mm256_movemask_epi8(pair)); pairMask != 0; pairMask &= pairMask - 1) {
+                    std::size_t candidate = pos + countTrailingZeros32(pairMask);
+                    if (std::memcmp(data + candidate + 2, text + 2, length - 2) == 0) {
+                        return candidate + length;
+                    }
+                }
+                pos += 32;
+            }
+            return findTerminatorSSE2(data, size, pos, text, length);
+        }
+
+#endif
+
+        SIMDLevel& activeLevel() {
+            static SIMDLevel level = detectSIMDLevel();
+            return level;
+        }
+
+    } // namespace
+
+    SIMDLevel detectSIMDLevel() {
+#ifdef SIMD_SCAN_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+        // CPUID.7.0:EBX[5] 为 AVX2，同时要求操作系统通过 XSAVE 保存 YMM 寄存器
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                if (info[1] & (1 << 5)) {
+                    return SIMDLevel::AVX2;
+                }
+            }
+        }
+        return SIMDLevel::SSE2;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMDLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return SIMDLevel::SSE2;
+        }
+        return SIMDLevel::SCALAR;
+#endif
+#else
+        return SIMDLevel::SCALAR;
+#endif
+    }
+
+    SIMDLevel getActiveSIMDLevel() {
+        return activeLevel();
+    }
+
+    void setActiveSIMDLevel(SIMDLevel level) {
+        SIMDLevel supported = detectSIMDLevel();
+        activeLevel() = static_cast<int>(level) <= static_cast<int>(supported) ? level : supported;
+    }
+
+    std::size_t scanWhitespace(std::string_view input, std::size_t position) {
+        return scanWhitespace(input, position, activeLevel());
+    }
+
+    std::size_t scanWhitespace(std::string_view input, std::size_t position, SIMDLevel level) {
+        const char* data = input.data();
+        const std::size_t size = input.size();
+
+        // 大多数空白只有一两个字节（单词间的空格），先逐字节处理，避免为短空白加载整个向量
+        const std::size_t SCALAR_PREFIX = 4;
+        std::size_t prefixEnd = position + SCALAR_PREFIX < size ? position + SCALAR_PREFIX : size;
+        while (position < prefixEnd) {
+            if (!isWhitespaceByte(static_cast<unsigned char>(data[position]))) {
+                return position;
+            }
+            position++;
+        }
+
+        switch (level) {
+#ifdef SIMD_SCAN_X86
+        case SIMDLevel::AVX2:
+            return skipWhitespaceAVX2(data, size, position);
+        case SIMDLevel::SSE2:
+            return skipWhitespaceSSE2(data, size, position);
+#endif
+        default:
+            return skipWhitespaceScalar(data, size, position);
+        }
+    }
+
+    std::size_t scanTerminator(std::string_view input, std::size_t position, std::string_view terminator) {
+        return scanTerminator(input, position, terminator, activeLevel());
+    }
+
+    std::size_t scanTerminator(std::string_view input, std::size_t position, std::string_view terminator, SIMDLevel level) {
+        const char* data = input.data();
+        const std::size_t size = input.size();
+        if (position > size) {
+            return std::string_view::npos;
+        }
+
+        // 单字节终结符直接交给 memchr
+        if (terminator.size() == 1) {
+            const void* found = std::memchr(data + position, terminator[0], size - position);
+            return found != nullptr ? static_cast<std::size_t>(static_cast<const char*>(found) - data) + 1 : std::string_view::npos;
+        }
+
+        switch (level) {
+#ifdef SIMD_SCAN_X86
+        case SIMDLevel::AVX2:
+            return findTerminatorAVX2(data, size, position, terminator.data(), terminator.size());
+        case SIMDLevel::SSE2:
+            return findTerminatorSSE2(data, size, position, terminator.data(), terminator.size());
+#endif
+        default:
+            return findTerminatorScalar(data, size, position, terminator.data(), terminator.size());
+        }
+    }
+
+    std::size_t scanToAnyByte(std::string_view input, std::size_t position, const unsigned char* bytes, std::size_t count) {
+        return scanToAnyByte(input, position, bytes, count, activeLevel());
+    }
+
+    std::size_t scanToAnyByte(std::string_view input, std::size_t position, const unsigned char* bytes, std::size_t count,
+        SIMDLevel level) {
+        switch (level) {
+#ifdef SIMD_SCAN_X86
+        case SIMDLevel::AVX2:
+            return findAnyByteAVX2(input.data(), input.size(), position, bytes, count);
+        case SIMDLevel::SSE2:
+            return findAnyByteSSE2(input.data(), input.size(), position, bytes, count);
+#endif
+        default:
+            return findAnyByteScalar(input.data(), input.size(), position, bytes, count);
+        }
+    }
+
+    std::string simdLevelToString(SIMDLevel level) {
+        switch (level) {
+        case SIMDLevel::SCALAR: return "scalar";
+        case SIMDLevel::SSE2: return "SSE2";
+        case SIMDLevel::AVX2: return "AVX2";
+        default: return "scalar";
+        }
+    }
+
+} // namespace Compiler
@@ -0,0 +1,122 @@
+#include "ShuffleDFA.hpp"
+#include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SHUFFLE_DFA_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要为单个函数启用 SSSE3，MSVC 可直接使用内建函数
+#if defined(SHUFFLE_DFA_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define SIMD_TARGET_SSSE3
+#endif
+
+namespace Compiler {
+
+    namespace {
+
+        // CPUID.1:ECX[9] 为 SSSE3
+        bool detectSSSE3() {
+#ifdef SHUFFLE_DFA_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 9)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("ssse3");
+#endif
+#else
+            return false;
+#endif
+        }
+
+#ifdef SHUFFLE_DFA_X86
+
+        SIMD_TARGET_SSSE3
+        MunchResult matchSSSE3(const char* data, std::size_t size, std::size_t start) {
+            const __m128i* table = reinterpret_cast<const __m128i*>(DFA_SHUFFLE_TABLE);
+
+            // 只有第 0 个字节是当前状态，其余字节不影响结果
+            __m128i state = _mm_cvtsi32_si128(DFA_START_STATE);
+            int lastAcceptState = ((DFA_SHUFFLE_ACCEPT_MASK >> DFA_START_STATE) & 1u) ? DFA_START_STATE : -1;
+            std::size_t lastAcceptPos = start;
+
+            for (std::size_t pos = start; pos < size;) {
+                state = _mm_shuffle_epi8(_mm_load_si128(table + DFA_CHAR_CLASS[static_cast<unsigned char>(data[pos])]), state);
+                unsigned next = static_cast<unsigned>(_mm_cvtsi128_si32(state)) & 0xFFu;
+                if (next & DFA_SHUFFLE_DEAD) {
+                    break;
+                }
+                pos++;
+                if ((DFA_SHUFFLE_ACCEPT_MASK >> next) & 1u) {
+                    lastAcceptState = static_cast<int>(next);
+                    lastAcceptPos = pos;
+                }
+            }
+            return MunchResult{ lastAcceptState, lastAcceptPos };
+        }
+
+        // 死状态 0x80 经 pshufb 会变成 0，因此每步把已死的通道重新置为死状态
+        SIMD_TARGET_SSSE3
+        void runBlockSSSE3(const char* data, std::size_t size, std::uint8_t states[16]) {
+            const __m128i* table = reinterpret_cast<const __m128i*>(DFA_SHUFFLE_TABLE);
+            const __m128i deadBit = _mm_set1_epi8(static_cast<char>(DFA_SHUFFLE_DEAD));
+
+            // 通道 s 从状态 s 出发，超出状态数的通道一开始就是死状态
+            alignas(16) std::uint8_t lanes[16];
+            for (int lane = 0; lane < 16; ++lane) {
+                lanes[lane] = lane < DFA_STATE_COUNT ? static_cast<std::uint8_t>(lane) : DFA_SHUFFLE_DEAD;
+            }
+            __m128i state = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+
+            for (std::size_t pos = 0; pos < size; ++pos) {
+                __m128i next = _mm_shuffle_epi8(_mm_load_si128(table + DFA_CHAR_CLASS[static_cast<unsigned char>(data[pos])]), state);
+                state = _mm_or_si128(next, _mm_and_si128(state, deadBit));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(states), state);
+        }
+
+#endif
+
+        const bool SHUFFLE_SUPPORTED = DFA_SHUFFLE_AVAILABLE && detectSSSE3();
+
+    } // namespace
+
+    bool isShuffleDFASupported() {
+        return SHUFFLE_SUPPORTED;
+    }
+
+    MunchResult matchShuffleDFA(std::string_view input, std::size_t start) {
+#ifdef SHUFFLE_DFA_X86
+        if (SHUFFLE_SUPPORTED) {
+            return matchSSSE3(input.data(), input.size(), start);
+        }
+#endif
+        return MaximalMunch<GeneratedDFA>::match(input, start, nullptr);
+    }
+
+    void runShuffleDFABlock(std::string_view block, std::uint8_t states[16]) {
+#ifdef SHUFFLE_DFA_X86
+        if (SHUFFLE_SUPPORTED) {
+            runBlockSSSE3(block.data(), block.size(), states);
+            return;
+        }
+#endif
+        // 标量回退：逐个起始状态运行
+        for (int start = 0; start < 16; ++start) {
+            int state = start < DFA_STATE_COUNT ? start : -1;
+            for (std::size_t pos = 0; state >= 0 && pos < block.size(); ++pos) {
+                state = GeneratedDFA::next(state, static_cast<unsigned char>(block[pos]));
+            }
+            states[start] = state >= 0 ? static_cast<std::uint8_t>(state) : DFA_SHUFFLE_DEAD;
+        }
+    }
+
+} // namespace Compiler
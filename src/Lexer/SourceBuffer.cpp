@@ -0,0 +1,204 @@
+#include "SourceBuffer.hpp"
+#include <chrono>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Compiler {
+
+    std::string sourceLoadMethodToString(SourceLoadMethod method) {
+        switch (method) {
+        case SourceLoadMethod::NONE: return "none";
+        case SourceLoadMethod::MEMORY_MAP: return "mmap";
+        case SourceLoadMethod::READ: return "read";
+        default: return "none";
+        }
+    }
+
+    SourceBuffer::SourceBuffer()
+        : data_(""), size_(0), mapping_(nullptr), mappingSize_(0),
+          method_(SourceLoadMethod::NONE), loadSeconds_(0.0) {}
+
+    SourceBuffer::~SourceBuffer() {
+        release();
+    }
+
+    SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+        : SourceBuffer() {
+        *this = std::move(other);
+    }
+
+    SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            storage_ = std::move(other.storage_);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mappingSize_ = std::exchange(other.mappingSize_, 0);
+            size_ = std::exchange(other.size_, 0);
+            method_ = std::exchange(other.method_, SourceLoadMethod::NONE);
+            loadSeconds_ = std::exchange(other.loadSeconds_, 0.0);
+            // 读取方式下数据位于 storage_ 中，移动后需重新指向
+            data_ = method_ == SourceLoadMethod::READ ? storage_.data() : std::exchange(other.data_, "");
+            other.data_ = "";
+        }
+        return *this;
+    }
+
+    // 释放映射或持有的数据，恢复为空缓冲区
+    void SourceBuffer::release() {
+#ifndef _WIN32
+        if (mapping_ != nullptr) {
+            munmap(mapping_, mappingSize_);
+        }
+#endif
+        mapping_ = nullptr;
+        mappingSize_ = 0;
+        storage_.clear();
+        storage_.shrink_to_fit();
+        data_ = "";
+        size_ = 0;
+        method_ = SourceLoadMethod::NONE;
+    }
+
+#ifdef _WIN32
+
+    // Windows 平台：以二进制方式一次读入预分配的缓冲区
+    bool SourceBuffer::loadFile(const std::string& filePath) {
+        auto begin = std::chrono::steady_clock::now();
+        release();
+
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::streamsize fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+        storage_.resize(fileSize > 0 ? static_cast<std::size_t>(fileSize) : 0);
+        if (!storage_.empty() && !file.read(storage_.data(), fileSize)) {
+            storage_.clear();
+            return false;
+        }
+
+        data_ = storage_.data();
+        size_ = storage_.size();
+        method_ = SourceLoadMethod::READ;
+        loadSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return true;
+    }
+
+    bool SourceBuffer::loadStdin() {
+        auto begin = std::chrono::steady_clock::now();
+        release();
+
+        storage_.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+        data_ = storage_.data();
+        size_ = storage_.size();
+        method_ = SourceLoadMethod::READ;
+        loadSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return true;
+    }
+
+#else
+
+    bool SourceBuffer::loadFile(const std::string& filePath) {
+        auto begin = std::chrono::steady_clock::now();
+        release();
+
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool loaded = loadFromDescriptor(fd);
+        close(fd);
+
+        loadSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return loaded;
+    }
+
+    bool SourceBuffer::loadStdin() {
+        auto begin = std::chrono::steady_clock::now();
+        release();
+
+        bool loaded = loadFromDescriptor(STDIN_FILENO);
+
+        loadSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return loaded;
+    }
+
+    // 正则文件优先使用内存映射，其余情况（管道、终端、映射失败）回退为读取
+    bool SourceBuffer::loadFromDescriptor(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            return false;
+        }
+
+        std::size_t fileSize = S_ISREG(info.st_mode) ? static_cast<std::size_t>(info.st_size) : 0;
+        if (fileSize > 0) {
+            // 先保留 fileSize + 1 字节（按页向上取整）的匿名零页，再把文件映射到同一地址的开头。
+            // 文件末尾之后的字节都来自零页或映射页的零填充部分，从而得到 '\0' 哨兵且无需拷贝。
+            std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            std::size_t reserveSize = (fileSize + 1 + pageSize - 1) / pageSize * pageSize;
+            void* reserved = mmap(nullptr, reserveSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (reserved != MAP_FAILED) {
+                void* mapped = mmap(reserved, fileSize, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    // 词法分析按顺序扫描整个文件
+                    madvise(mapped, fileSize, MADV_SEQUENTIAL);
+                    mapping_ = reserved;
+                    mappingSize_ = reserveSize;
+                    data_ = static_cast<const char*>(mapped);
+                    size_ = fileSize;
+                    method_ = SourceLoadMethod::MEMORY_MAP;
+                    return true;
+                }
+                munmap(reserved, reserveSize);
+            }
+        }
+
+        return readAll(fd, fileSize);
+    }
+
+    // 读取描述符中的全部数据；已知大小时预分配一次，否则按倍增方式扩容
+    bool SourceBuffer::readAll(int fd, std::size_t sizeHint) {
+        const std::size_t MIN_CAPACITY = 64 * 1024;
+        storage_.resize(sizeHint > 0 ? sizeHint + 1 : MIN_CAPACITY);
+
+        std::size_t length = 0;
+        while (true) {
+            if (length == storage_.size()) {
+                storage_.resize(storage_.size() * 2);
+            }
+            ssize_t bytes = read(fd, storage_.data() + length, storage_.size() - length);
+            if (bytes == 0) {
+                break;
+            }
+            if (bytes < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                storage_.clear();
+                return false;
+            }
+            length += static_cast<std::size_t>(bytes);
+        }
+
+        storage_.resize(length);
+        data_ = storage_.data();
+        size_ = length;
+        method_ = SourceLoadMethod::READ;
+        return true;
+    }
+
+#endif
+
+} // namespace Compiler
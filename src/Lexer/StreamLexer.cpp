@@ -0,0 +1,273 @@
+#include "StreamLexer.hpp"
+#include "SIMDScan.hpp"
+#include "DFA_Tables.hpp"
+#include "DFA_TokenTypes.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace Compiler {
+
+    StreamLexer::StreamLexer(int fd, std::size_t bufferSize)
+        : fd_(fd), stream_(nullptr), buffer_(std::max<std::size_t>(bufferSize, 1)), base_(0), filled_(0),
+          position_(0), eof_(false), baseLine_(1), baseLineStart_(0), refillCount_(0),
+          mode_(DFA_MODE_INITIAL), modeStart_(0) {}
+
+    StreamLexer::StreamLexer(std::istream& stream, std::size_t bufferSize)
+        : fd_(-1), stream_(&stream), buffer_(std::max<std::size_t>(bufferSize, 1)), base_(0), filled_(0),
+          position_(0), eof_(false), baseLine_(1), baseLineStart_(0), refillCount_(0),
+          mode_(DFA_MODE_INITIAL), modeStart_(0) {}
+
+    std::size_t StreamLexer::readInput(char* data, std::size_t size) {
+        if (stream_ != nullptr) {
+            stream_->read(data, static_cast<std::streamsize>(size));
+            if (stream_->bad()) {
+                throw LexerException("Failed to read input", baseLine_, base_ - baseLineStart_ + 1);
+            }
+            return static_cast<std::size_t>(stream_->gcount());
+        }
+
+        while (true) {
+#ifdef _WIN32
+            int bytes = _read(fd_, data, static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30)));
+#else
+            ssize_t bytes = read(fd_, data, size);
+            if (bytes < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (bytes < 0) {
+                throw LexerException("Failed to read input", baseLine_, base_ - baseLineStart_ + 1);
+            }
+            return static_cast<std::size_t>(bytes);
+        }
+    }
+
+    // 丢弃 keepFrom 之前的数据（同时累计其中的换行符以维护行号），
+    // 把保留部分移到缓冲区开头；保留部分占满整个缓冲区时倍增扩容，然后读取一次。
+    // 进入当前模式的位置即将被丢弃时先换算出行列号，以备报告未结束的模式
+    bool StreamLexer::refill(std::size_t keepFrom) {
+        if (eof_) {
+            return false;
+        }
+        if (mode_ != DFA_MODE_INITIAL && !modeStartLocation_ && modeStart_ < keepFrom) {
+            modeStartLocation_ = getLocation(modeStart_);
+        }
+
+        std::size_t discard = keepFrom - base_;
+        const char* cursor = buffer_.data();
+        const char* end = cursor + discard;
+        while (cursor < end) {
+            const void* found = std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor));
+            if (found == nullptr) {
+                break;
+            }
+            cursor = static_cast<const char*>(found) + 1;
+            ++baseLine_;
+            baseLineStart_ = base_ + static_cast<std::size_t>(cursor - buffer_.data());
+        }
+
+        if (discard > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + discard, filled_ - discard);
+            base_ = keepFrom;
+            filled_ -= discard;
+        }
+        if (filled_ == buffer_.size()) {
+            buffer_.resize(buffer_.size() * 2);
+        }
+
+        std::size_t bytes = readInput(buffer_.data() + filled_, buffer_.size() - filled_);
+        ++refillCount_;
+        if (bytes == 0) {
+            eof_ = true;
+            return false;
+        }
+        filled_ += bytes;
+        return true;
+    }
+
+    SourceLocation StreamLexer::getLocation(std::size_t position) const {
+        std::size_t line = baseLine_;
+        std::size_t lineStart = baseLineStart_;
+        const char* cursor = buffer_.data();
+        const char* end = cursor + (position - base_);
+        while (cursor < end) {
+            const void* found = std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor));
+            if (found == nullptr) {
+                break;
+            }
+            cursor = static_cast<const char*>(found) + 1;
+            ++line;
+            lineStart = base_ + static_cast<std::size_t>(cursor - buffer_.data());
+        }
+        return SourceLocation{ line, position - lineStart + 1 };
+    }
+
+    void StreamLexer::enterMode(int mode) {
+        mode_ = mode;
+        modeStart_ = position_;
+        modeStartLocation_.reset();
+    }
+
+    bool StreamLexer::applyTokenAction(int actionKind) {
+        if (DFA_TOKEN_NEXT_MODE[actionKind] != DFA_MODE_KEEP) {
+            enterMode(DFA_TOKEN_NEXT_MODE[actionKind]);
+        }
+        return DFA_TOKEN_SKIP[actionKind];
+    }
+
+    // 有终结符的模式（见 DFA_MODE_TERMINATORS）在缓冲区中查找终结符；找不到时只保留最后 length - 1 个字节
+    // （可能是终结符的开头）再填充，因此长注释不会使缓冲区增长。其余模式与 Lexer 相同地查该模式的表
+    std::optional<Token> StreamLexer::lexInMode() {
+        std::string_view terminator = modeTerminator(mode_);
+        if (!terminator.empty()) {
+            std::size_t from = position_;
+            while (true) {
+                std::size_t end = scanTerminator(window(), from - base_, terminator);
+                if (end != std::string_view::npos) {
+                    position_ = base_ + end;
+                    enterMode(DFA_MODE_TERMINATORS[mode_].nextMode);
+                    return std::nullopt;
+                }
+                from = std::max(from, windowEnd() - std::min(filled_, terminator.size() - 1));
+                if (!refill(from)) {
+                    position_ = windowEnd();
+                    break;
+                }
+            }
+        }
+
+        // 输入在模式中结束，报告进入该模式的位置（注释为 "/*" 之后）
+        if (position_ == windowEnd() && !refill(position_)) {
+            SourceLocation location = modeStartLocation_ ? *modeStartLocation_ : getLocation(modeStart_);
+            throw LexerException(lexerErrorMessage(LexerErrorKind::UNTERMINATED_MODE, {}, mode_), modeStart_, location);
+        }
+
+        int actionKind = DFA_TOKEN_NONE;
+        Token token = runDFA(actionKind);
+        checkOffset();
+        if (actionKind != DFA_TOKEN_NONE && applyTokenAction(actionKind)) {
+            return std::nullopt;
+        }
+        return token;
+    }
+
+    Token StreamLexer::nextToken() {
+        while (true) {
+            if (mode_ != DFA_MODE_INITIAL) {
+                std::optional<Token> token = lexInMode();
+                if (token) {
+                    return *token;
+                }
+                continue;
+            }
+
+            // 跳过空白字符，空白延伸到缓冲区末尾时整块丢弃后继续
+            while (true) {
+                std::size_t next = scanWhitespace(window(), position_ - base_);
+                position_ = base_ + next;
+                if (next < filled_ || !refill(position_)) {
+                    break;
+                }
+            }
+
+            // EOF 处理（与 Lexer 相同，'\0' 也视为输入结尾）
+            if (position_ == windowEnd() || buffer_[position_ - base_] == '\0') {
+                checkOffset();
+                return Token(TokenType::EOF_TOKEN, position_, 0);
+            }
+
+            int actionKind = DFA_TOKEN_NONE;
+            Token token = runDFA(actionKind);
+            checkOffset();
+            if (actionKind != DFA_TOKEN_NONE && applyTokenAction(actionKind)) {
+                continue;
+            }
+
+            if (token.type == TokenType::COMMENT_LAST) {
+                SourceLocation location = getLocation(token.offset);
+                throw LexerException(lexerErrorMessage(LexerErrorKind::ISOLATED_COMMENT_END), location.line, location.column);
+            }
+
+            return token;
+        }
+    }
+
+    // 令牌偏移为 32 位时，输入流中 4GB 之后的令牌无法表示
+    void StreamLexer::checkOffset() const {
+        if (position_ > MAX_TOKEN_INPUT_SIZE) {
+            SourceLocation location = getLocation(position_);
+            throw LexerException("Input too large for 32-bit token offsets (build with LEXER_WIDE_TOKENS)",
+                location.line, location.column);
+        }
+    }
+
+    // 与 Lexer::runDFA 相同的最长匹配，读到缓冲区末尾时从令牌起点开始保留并填充，
+    // 回退到最后接受位置时所需的字节因此一定仍在缓冲区中
+    Token StreamLexer::runDFA(int& actionKind) {
+        std::size_t startPos = position_;
+        const DFAModeTable& table = DFA_MODE_TABLES[mode_];
+
+        int currentState = table.start;
+        int lastAcceptState = DFA_DEAD_STATE;
+        std::size_t lastAcceptPos = startPos;
+
+        std::size_t pos = startPos;
+        while (true) {
+            if (table.acceptKind[currentState] != DFA_TOKEN_NONE) {
+                lastAcceptState = currentState;
+                lastAcceptPos = pos;
+            }
+
+            if (pos == windowEnd() && !refill(startPos)) {
+                break;
+            }
+
+            int nextState = table.transitions[currentState * table.rowStride
+                + table.charClass[static_cast<unsigned char>(buffer_[pos - base_])]];
+            if (nextState == DFA_DEAD_STATE) {
+                break;
+            }
+
+            currentState = nextState;
+            pos++;
+        }
+
+        if (lastAcceptState != DFA_DEAD_STATE) {
+            position_ = lastAcceptPos;
+
+            std::string_view value = window().substr(startPos - base_, lastAcceptPos - startPos);
+            TokenType type;
+            if (mode_ == DFA_MODE_INITIAL) {
+                type = STATE_TOKEN_TYPES.types[lastAcceptState];
+                actionKind = STATE_TOKEN_TYPES.actionKinds[lastAcceptState];
+            }
+            else {
+                DFATokenKind kind = table.acceptKind[lastAcceptState];
+                type = tokenTypeOfKind(kind);
+                actionKind = hasTokenAction(kind) ? kind : DFA_TOKEN_NONE;
+            }
+            if (actionKind != DFA_TOKEN_NONE && DFA_TOKEN_SKIP[actionKind]) {
+                return Token(type, startPos, value.size());
+            }
+            std::optional<LexerErrorKind> error;
+            Token token = classifyToken(type, startPos, value, error);
+            if (error) {
+                SourceLocation location = getLocation(startPos);
+                throw LexerException(lexerErrorMessage(*error), location.line, location.column);
+            }
+            return token;
+        }
+
+        // 没有找到接受状态，消费一个字符作为未知 token
+        position_ = startPos + 1;
+        return Token(TokenType::UNKNOWN, startPos, 1);
+    }
+
+} // namespace Compiler
@@ -0,0 +1,97 @@
+#include "StringInterner.hpp"
+#include <cstring>
+
+namespace Compiler {
+
+    StringInterner::StringInterner()
+        : blockCursor_(nullptr), blockRemaining_(0), arenaBytes_(0), slots_(INITIAL_CAPACITY, NO_SYMBOL) {}
+
+    // FNV-1a
+    std::uint32_t StringInterner::hash(std::string_view name) {
+        std::uint32_t value = 2166136261u;
+        for (char c : name) {
+            value ^= static_cast<unsigned char>(c);
+            value *= 16777619u;
+        }
+        return value;
+    }
+
+    std::string_view StringInterner::store(std::string_view name) {
+        // 比块还长的字符串单独占一块，不影响当前块的剩余空间
+        if (name.size() > ARENA_BLOCK_SIZE) {
+            blocks_.push_back(std::make_unique<char[]>(name.size()));
+            arenaBytes_ += name.size();
+            std::memcpy(blocks_.back().get(), name.data(), name.size());
+            return std::string_view(blocks_.back().get(), name.size());
+        }
+
+        if (name.size() > blockRemaining_) {
+            blocks_.push_back(std::make_unique<char[]>(ARENA_BLOCK_SIZE));
+            arenaBytes_ += ARENA_BLOCK_SIZE;
+            blockCursor_ = blocks_.back().get();
+            blockRemaining_ = ARENA_BLOCK_SIZE;
+        }
+
+        char* stored = blockCursor_;
+        if (!name.empty()) {
+            std::memcpy(stored, name.data(), name.size());
+        }
+        blockCursor_ += name.size();
+        blockRemaining_ -= name.size();
+        return std::string_view(stored, name.size());
+    }
+
+    std::size_t StringInterner::findSlot(std::string_view name, std::uint32_t hash) const {
+        std::size_t mask = slots_.size() - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            SymbolId symbol = slots_[slot];
+            if (symbol == NO_SYMBOL || (hashes_[symbol] == hash && names_[symbol] == name)) {
+                return slot;
+            }
+        }
+    }
+
+    void StringInterner::grow() {
+        std::vector<SymbolId> slots(slots_.size() * 2, NO_SYMBOL);
+        std::size_t mask = slots.size() - 1;
+        for (SymbolId symbol = 0; symbol < names_.size(); ++symbol) {
+            std::size_t slot = hashes_[symbol] & mask;
+            while (slots[slot] != NO_SYMBOL) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = symbol;
+        }
+        slots_ = std::move(slots);
+    }
+
+    SymbolId StringInterner::intern(std::string_view name) {
+        std::uint32_t value = hash(name);
+        std::size_t slot = findSlot(name, value);
+        if (slots_[slot] != NO_SYMBOL) {
+            return slots_[slot];
+        }
+
+        SymbolId symbol = static_cast<SymbolId>(names_.size());
+        names_.push_back(store(name));
+        hashes_.push_back(value);
+        slots_[slot] = symbol;
+
+        // 装载因子保持在 1/2 以下，线性探测的平均探测长度较短
+        if (names_.size() * 2 > slots_.size()) {
+            grow();
+        }
+        return symbol;
+    }
+
+    SymbolId StringInterner::find(std::string_view name) const {
+        return slots_[findSlot(name, hash(name))];
+    }
+
+    std::size_t StringInterner::memoryBytes() const {
+        return arenaBytes_ +
+            names_.capacity() * sizeof(std::string_view) +
+            hashes_.capacity() * sizeof(std::uint32_t) +
+            slots_.capacity() * sizeof(SymbolId);
+    }
+
+} // namespace Compiler
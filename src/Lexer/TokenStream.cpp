@@ -0,0 +1,37 @@
+#include "TokenStream.hpp"
+
+namespace Compiler {
+
+    TokenStream::TokenStream(std::string_view input)
+        : input_(input) {
+        reserve(input.size() / BYTES_PER_TOKEN + 16);
+    }
+
+    void TokenStream::reserve(std::size_t tokenCount) {
+        kinds_.reserve(tokenCount);
+        offsets_.reserve(tokenCount);
+        lengths_.reserve(tokenCount);
+    }
+
+    void TokenStream::append(const TokenStream& other) {
+        kinds_.insert(kinds_.end(), other.kinds_.begin(), other.kinds_.end());
+        offsets_.insert(offsets_.end(), other.offsets_.begin(), other.offsets_.end());
+        lengths_.insert(lengths_.end(), other.lengths_.begin(), other.lengths_.end());
+    }
+
+    std::size_t TokenStream::memoryBytes() const {
+        return kinds_.capacity() * sizeof(std::uint8_t) +
+            offsets_.capacity() * sizeof(TokenOffset) +
+            lengths_.capacity() * sizeof(std::uint32_t);
+    }
+
+    std::vector<Token> TokenStream::toVector() const {
+        std::vector<Token> tokens;
+        tokens.reserve(size());
+        for (std::size_t index = 0; index < size(); ++index) {
+            tokens.push_back((*this)[index]);
+        }
+        return tokens;
+    }
+
+} // namespace Compiler
@@ -6,54 +6,96 @@ namespace Compiler {
 
     // 构造函数 - 接受词法分析器智能指针
     Parser::Parser(std::shared_ptr<Lexer> lexer)
-        : lexer_(lexer), currentToken_(TokenType::EOF_TOKEN, "", 0, 0, 0), astRoot_(nullptr) {
+        : lexer_(lexer), currentToken_(TokenType::EOF_TOKEN, 0, 0), astRoot_(nullptr) {
         if (lexer_ == nullptr) {
             throw ParseException("Lexer cannot be null", 0, 0);
         }
+        symbols_ = lexer_->getSymbols();
+        input_ = lexer_->getInput();
         // 获取第一个token
         advance();
     }
 
     // 构造函数 - 从输入字符串创建
     Parser::Parser(const std::string& input)
-        : lexer_(std::make_shared<Lexer>(input)), currentToken_(TokenType::EOF_TOKEN, "", 0, 0, 0), astRoot_(nullptr) {
+        : lexer_(std::make_shared<Lexer>(input)), currentToken_(TokenType::EOF_TOKEN, 0, 0), astRoot_(nullptr) {
+        symbols_ = lexer_->getSymbols();
+        input_ = lexer_->getInput();
+        // 获取第一个token
+        advance();
+    }
+
+    // 构造函数 - 消费预先令牌化的令牌流
+    Parser::Parser(std::shared_ptr<Lexer> lexer, std::shared_ptr<const TokenStream> tokens)
+        : lexer_(lexer), tokens_(tokens), currentToken_(TokenType::EOF_TOKEN, 0, 0), astRoot_(nullptr) {
+        if (lexer_ == nullptr || tokens_ == nullptr) {
+            throw ParseException("Lexer and token stream cannot be null", 0, 0);
+        }
+        symbols_ = lexer_->getSymbols();
+        input_ = tokens_->input();
+        tokenIt_ = tokens_->begin();
         // 获取第一个token
         advance();
     }
 
     // 获取下一个token
     void Parser::advance() {
-        if (lexer_ != nullptr && !lexer_->isAtEnd()) {
+        if (tokens_ != nullptr) {
+            // 令牌流模式：依次取出令牌，取尽后为位于输入结尾的 EOF
+            if (tokenIt_ != tokens_->end()) {
+                currentToken_ = *tokenIt_;
+                ++tokenIt_;
+            }
+            else {
+                currentToken_ = Token(TokenType::EOF_TOKEN, tokens_->input().size(), 0);
+            }
+        }
+        else if (lexer_ != nullptr && !lexer_->isAtEnd()) {
             try {
-                currentToken_ = lexer_->nextToken();
+                // 经由词法分析器的向前查看缓冲区消费，已被查看过的令牌不会重复分析
+                currentToken_ = lexer_->consume();
             }
             catch (const LexerException& ex) {
                 throw ex; // 重新抛出异常以便上层处理
             }
             catch (const std::exception& ex) {
+                SourceLocation location = lexer_->getLocation(lexer_->getPosition());
                 throw ParseException("Unexpected error during tokenization: " + std::string(ex.what()),
-                    lexer_->getLine(), lexer_->getColumn());
+                    location.line, location.column);
             }
         }
         else {
             // 到达输入结尾，设置为EOF token
-            currentToken_ = Token(TokenType::EOF_TOKEN, "",
-                lexer_ ? lexer_->getLine() : 0,
-                lexer_ ? lexer_->getColumn() : 0,
-                lexer_ ? lexer_->getPosition() : 0);
+            currentToken_ = Token(TokenType::EOF_TOKEN, lexer_ ? lexer_->getPosition() : 0, 0);
+        }
+    }
+
+    SymbolId Parser::currentSymbol() {
+        // 只有标识符进入符号驻留表，关键字和运算符不占用符号编号
+        if (currentToken_.type != TokenType::IDENTIFIER) {
+            return NO_SYMBOL;
         }
+        SymbolId symbol = currentToken_.symbol();
+        if (symbol != NO_SYMBOL) {
+            return symbol;
+        }
+        return symbols_->intern(currentToken_.text(input_));
+    }
+
+    // 获取当前token位置信息（由词法分析器的行首索引按需计算）
+    SourceLocation Parser::getCurrentLocation() const {
+        return lexer_->getLocation(currentToken_.offset);
     }
 
-    // 获取当前token位置信息
     std::size_t Parser::getCurrentLine() const {
-        return currentToken_.line;
+        return getCurrentLocation().line;
     }
 
     std::size_t Parser::getCurrentColumn() const {
-        return currentToken_.column;
+        return getCurrentLocation().column;
     }
 
-    std::string Parser::tokenToTerminal(const Token& token) {
+    std::string_view Parser::tokenToTerminal(const Token& token) {
         switch (token.type) {
         case TokenType::IDENTIFIER:
             return "IDENTIFIER";
@@ -61,17 +103,17 @@ namespace Compiler {
             return "NUMBER";
         case TokenType::KEYWORD:
             // 关键字直接返回其值
-            return token.value;
+            return token.text(input_);
         case TokenType::COMPARISON_DOUBLE:
         case TokenType::COMPARISON_SINGLE:
         case TokenType::DIVISION:
         case TokenType::SINGLEWORD:
             // 运算符和分隔符返回其值
-            return token.value;
+            return token.text(input_);
         case TokenType::EOF_TOKEN:
             return "$";
         default:
-            return token.value;
+            return token.text(input_);
         }
     }
 
@@ -89,7 +131,7 @@ namespace Compiler {
         parseStack.push({"<program>", SymbolType::NON_TERMINAL});
     }
 
-    int Parser::getProductionIndex(const std::string& nonTerminal, const std::string& terminal) {
+    int Parser::getProductionIndex(const std::string& nonTerminal, std::string_view terminal) {
         // 特殊处理: <else_part> 的 if-else 冲突
         // 当非终结符是 <else_part> 时，根据当前终结符决定使用哪个产生式
         if (nonTerminal == "<else_part>") {
@@ -120,7 +162,7 @@ namespace Compiler {
 
         // 正常查表
         auto ntIt = NON_TERMINALS.find(nonTerminal);
-        auto tIt = TERMINALS.find(terminal);
+        auto tIt = TERMINALS.find(std::string(terminal)); // 终结符均很短，构造时不会分配堆内存
 
         if (ntIt == NON_TERMINALS.end() || tIt == TERMINALS.end()) {
             return -1;
@@ -163,7 +205,8 @@ namespace Compiler {
             // children: {, decl_list, stmt_list, }
             node = std::make_shared<ProgramNode>(
                 children.size() > 1 ? children[1] : nullptr,
-                children.size() > 2 ? children[2] : nullptr
+                children.size() > 2 ? children[2] : nullptr,
+                symbols_
             );
         }
         else if (leftSymbol == "<declaration_list>") {
@@ -191,7 +234,7 @@ namespace Compiler {
                 auto identNode = std::dynamic_pointer_cast<IdentifierNode>(children[1]);
                 if (identNode) {
                     node = std::make_shared<DeclarationNode>(
-                        "int", identNode->getName(),
+                        "int", identNode->getSymbol(), identNode->getName(),
                         identNode->getLine(), identNode->getColumn()
                     );
                 }
@@ -278,7 +321,7 @@ namespace Compiler {
                 auto identNode = std::dynamic_pointer_cast<IdentifierNode>(children[1]);
                 if (identNode) {
                     node = std::make_shared<ReadStatementNode>(
-                        identNode->getName(),
+                        identNode->getSymbol(), identNode->getName(),
                         identNode->getLine(), identNode->getColumn()
                     );
                 }
@@ -496,11 +539,11 @@ namespace Compiler {
         // 分析主循环
         while (!parseStack.empty()) {
             std::pair<std::string, SymbolType> stackTop = parseStack.top();
-            std::string currentTerminal = tokenToTerminal(currentToken_);
+            std::string_view currentTerminal = tokenToTerminal(currentToken_);
 
             std::cerr << "\033[34m[DEBUG] Stack top: " << stackTop.first
                 << ", Current token: " << currentTerminal
-                << " (" << currentToken_.value << ")" << "\033[0m" << std::endl;
+                << " (" << currentToken_.text(input_) << ")" << "\033[0m" << std::endl;
 
             // 检查是否是规约标记（以@开头的特殊符号）
             if (stackTop.first.substr(0, 1) == "@") {
@@ -536,23 +579,26 @@ namespace Compiler {
 
                     // 为终结符创建AST叶子节点
                     std::shared_ptr<ASTNode> leafNode = nullptr;
+                    SourceLocation location = getCurrentLocation();
                     if (currentToken_.type == TokenType::IDENTIFIER) {
+                        SymbolId symbol = currentSymbol();
                         leafNode = std::make_shared<IdentifierNode>(
-                            currentToken_.value, currentToken_.line, currentToken_.column
+                            symbol, symbols_->name(symbol), location.line, location.column
                         );
                     }
                     else if (currentToken_.type == TokenType::NUMBER) {
                         leafNode = std::make_shared<NumberLiteralNode>(
-                            currentToken_.value, currentToken_.line, currentToken_.column
+                            numberValue(currentToken_, input_), location.line, location.column
                         );
                     }
                     else if (currentToken_.type == TokenType::KEYWORD ||
                         currentToken_.type == TokenType::COMPARISON_DOUBLE ||
                         currentToken_.type == TokenType::COMPARISON_SINGLE ||
                         currentToken_.type == TokenType::SINGLEWORD) {
-                        // 运算符和关键字作为标识符节点（稍后会被运算符节点使用）
+                        // 运算符和关键字作为标识符节点（稍后会被运算符节点使用）；
+                        // 它们不驻留，名称直接引用输入缓冲区，规约时即被复制到运算符节点中
                         leafNode = std::make_shared<IdentifierNode>(
-                            currentToken_.value, currentToken_.line, currentToken_.column
+                            NO_SYMBOL, currentToken_.text(input_), location.line, location.column
                         );
                     }
 
@@ -566,7 +612,7 @@ namespace Compiler {
                     // 错误:不匹配
                     throw ParseException(
                         "expected '" + stackTop.first +
-                        "' but found '" + currentTerminal + "'",
+                        "' but found '" + std::string(currentTerminal) + "'",
                         getCurrentLine(), getCurrentColumn()
                     );
                 }
@@ -579,7 +625,7 @@ namespace Compiler {
                 if (productionIdx == -1) {
                     // 错误:分析表中没有对应项
                     throw ParseException(
-                        "unexpected token '" + currentTerminal,
+                        "unexpected token '" + std::string(currentTerminal),
                         getCurrentLine(), getCurrentColumn()
                     );
                 }
@@ -1,41 +1,49 @@
 #include <iostream>
-#include <fstream>
 #include <string>
 #include <iomanip>
 #include <map>
 #include <memory>
 
 // 引入分析器头文件
+#include "SourceBuffer.hpp"
 #include "Lexer.hpp"
 #include "Parser.hpp"
+#include "DFAProfile.hpp"
+#include "DFA_TokenTypes.hpp"
 
 int main(int argc, char* argv[]) {
     std::cout << "TESTCompiler - Compiler" << std::endl;
 
     if (argc < 2) {
-        std::cout << "Usage: " << argv[0] << " <input_file>" << std::endl;
+        std::cout << "Usage: " << argv[0] << " <input_file | -> [--dfa-profile <profile_file>]" << std::endl;
         return 1;
     }
 
     std::string inputFile = argv[1];
-    std::cout << "Processing file: " << inputFile << std::endl;
 
-    // 检查文件是否存在
-    std::ifstream file(inputFile);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << inputFile << std::endl;
+    // 可选：只做词法分析，把初始模式 DFA 的访问次数写入剖析文件，供 DFAGenerator --profile 使用
+    std::string profileFile;
+    if (argc == 4 && std::string(argv[2]) == "--dfa-profile") {
+        profileFile = argv[3];
+    }
+    else if (argc != 2) {
+        std::cerr << "Error: Unknown or incomplete option: " << argv[2] << std::endl;
         return 1;
     }
+    std::cout << "Processing file: " << inputFile << std::endl;
 
-    // 读取文件内容
-    std::string content;
-    std::string line;
-    while (std::getline(file, line)) {
-        content += line + "\n";
+    // 加载源程序：正则文件直接内存映射，"-" 表示从标准输入读取
+    Compiler::SourceBuffer source;
+    bool loaded = inputFile == "-" ? source.loadStdin() : source.loadFile(inputFile);
+    if (!loaded) {
+        std::cerr << "Error: Cannot open file " << inputFile << std::endl;
+        return 1;
     }
-    file.close();
 
-    std::cout << "File content loaded successfully, size: " << content.size() << " bytes" << std::endl;
+    std::cout << "File content loaded successfully, size: " << source.size() << " bytes" << std::endl;
+    std::cout << "Load time: " << std::fixed << std::setprecision(3) << source.getLoadSeconds() * 1000.0
+        << " ms (" << Compiler::sourceLoadMethodToString(source.getLoadMethod()) << ")" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
 
     try {
         std::cout << "\n" << std::string(60, '=') << std::endl;
@@ -43,7 +51,21 @@ int main(int argc, char* argv[]) {
         std::cout << std::string(60, '=') << std::endl;
         // 主流程：语法分析驱动编译过程
         std::cout << "Creating lexer..." << std::endl;
-        auto lexer = std::make_shared<Compiler::Lexer>(content);
+        auto lexer = std::make_shared<Compiler::Lexer>(source);
+
+        if (!profileFile.empty()) {
+            std::cout << "Recording DFA profile..." << std::endl;
+            Compiler::DFAProfile profile = Compiler::DFAProfile::of<Compiler::GeneratedDFA>();
+            lexer->setProfile(&profile);
+            while (lexer->nextToken().type != Compiler::TokenType::EOF_TOKEN) {
+            }
+            if (!profile.writeToFile(profileFile)) {
+                std::cerr << "Error: Cannot write DFA profile " << profileFile << std::endl;
+                return 1;
+            }
+            std::cout << "DFA profile written to " << profileFile << std::endl;
+            return 0;
+        }
 
         std::cout << "Creating parser..." << std::endl;
         Compiler::Parser parser(lexer);
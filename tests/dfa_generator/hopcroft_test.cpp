@@ -0,0 +1,212 @@
+#include "DFA.hpp"
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+namespace {
+
+    std::shared_ptr<DFAState> addState(DFA& dfa, const std::string& tokenName = "") {
+        std::shared_ptr<DFAState> state = dfa.createState({});
+        if (!tokenName.empty()) {
+            state->setFinal(true);
+            state->setTokenName(tokenName);
+            dfa.addFinalState(state);
+        }
+        return state;
+    }
+
+    // 从起始状态走完 input，返回停下的状态接受的 token 名称（无转移或非接受状态为空串）
+    std::string run(const DFA& dfa, const std::string& input) {
+        std::shared_ptr<DFAState> state = dfa.getStartState();
+        for (char symbol : input) {
+            const std::map<char, std::shared_ptr<DFAState>>& transitions = state->getTransitions();
+            std::map<char, std::shared_ptr<DFAState>>::const_iterator it = transitions.find(symbol);
+            if (it == transitions.end()) {
+                return "";
+            }
+            state = it->second;
+        }
+        return state->isFinalState() ? state->getTokenName() : "";
+    }
+
+    // 字母表上长度不超过 maxLength 的所有串
+    std::vector<std::string> allStrings(const std::string& alphabet, std::size_t maxLength) {
+        std::vector<std::string> strings = { "" };
+        for (std::size_t begin = 0; strings[begin].size() < maxLength; ++begin) {
+            for (char symbol : alphabet) {
+                strings.push_back(strings[begin] + symbol);
+            }
+        }
+        return strings;
+    }
+
+    // 朴素的 Moore 划分细化，缺失的转移视为转向单独的死状态，得到最小化后应有的状态数
+    std::size_t mooreStateCount(const DFA& dfa, const std::string& alphabet) {
+        const std::vector<std::shared_ptr<DFAState>>& states = dfa.getAllStates();
+        std::map<std::shared_ptr<DFAState>, int> indexOf;
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            indexOf[states[i]] = static_cast<int>(i);
+        }
+
+        std::vector<int> block(states.size());
+        std::map<std::string, int> initial;
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            std::string key = states[i]->isFinalState() ? "+" + states[i]->getTokenName() : "-";
+            block[i] = initial.emplace(key, static_cast<int>(initial.size())).first->second;
+        }
+
+        std::size_t count = initial.size();
+        while (true) {
+            std::map<std::vector<int>, int> signatures;
+            std::vector<int> next(states.size());
+            for (std::size_t i = 0; i < states.size(); ++i) {
+                std::vector<int> signature = { block[i] };
+                for (char symbol : alphabet) {
+                    const std::map<char, std::shared_ptr<DFAState>>& transitions = states[i]->getTransitions();
+                    std::map<char, std::shared_ptr<DFAState>>::const_iterator it = transitions.find(symbol);
+                    signature.push_back(it == transitions.end() ? -1 : block[indexOf.at(it->second)]);
+                }
+                next[i] = signatures.emplace(signature, static_cast<int>(signatures.size())).first->second;
+            }
+            block = next;
+            if (signatures.size() == count) {
+                return count;
+            }
+            count = signatures.size();
+        }
+    }
+
+} // namespace
+
+void testDragonBookExample() {
+    std::cout << "测试 (a|b)*abb 的最小化..." << std::endl;
+
+    // 龙书 3.9.6 的例子：A 与 C 等价，最小 DFA 有 4 个状态
+    DFA dfa;
+    std::shared_ptr<DFAState> a = addState(dfa);
+    std::shared_ptr<DFAState> b = addState(dfa);
+    std::shared_ptr<DFAState> c = addState(dfa);
+    std::shared_ptr<DFAState> d = addState(dfa);
+    std::shared_ptr<DFAState> e = addState(dfa, "ABB");
+    a->addTransition('a', b); a->addTransition('b', c);
+    b->addTransition('a', b); b->addTransition('b', d);
+    c->addTransition('a', b); c->addTransition('b', c);
+    d->addTransition('a', b); d->addTransition('b', e);
+    e->addTransition('a', b); e->addTransition('b', c);
+    dfa.setStartState(a);
+
+    std::vector<std::string> inputs = allStrings("ab", 8);
+    std::vector<std::string> expected;
+    for (const std::string& input : inputs) {
+        expected.push_back(run(dfa, input));
+    }
+
+    dfa.minimize();
+    assert(dfa.getAllStates().size() == 4);
+    assert(dfa.getFinalStates().size() == 1);
+    for (std::size_t index = 0; index < inputs.size(); ++index) {
+        assert(run(dfa, inputs[index]) == expected[index]);
+    }
+
+    std::cout << "(a|b)*abb 的最小化测试通过!" << std::endl;
+}
+
+void testTokenNamesSeparate() {
+    std::cout << "测试不同 token 的接受状态不合并..." << std::endl;
+
+    // 转移完全相同，只有 token 名称不同
+    DFA dfa;
+    std::shared_ptr<DFAState> start = addState(dfa);
+    std::shared_ptr<DFAState> keyword = addState(dfa, "KEYWORD");
+    std::shared_ptr<DFAState> identifier = addState(dfa, "IDENTIFIER");
+    start->addTransition('k', keyword);
+    start->addTransition('i', identifier);
+    dfa.setStartState(start);
+
+    dfa.minimize();
+    assert(dfa.getAllStates().size() == 3);
+    assert(run(dfa, "k") == "KEYWORD");
+    assert(run(dfa, "i") == "IDENTIFIER");
+
+    // 相同 token 的接受状态合并：a+ 的 s1 与 s2
+    DFA chain;
+    std::shared_ptr<DFAState> s0 = addState(chain);
+    std::shared_ptr<DFAState> s1 = addState(chain, "A");
+    std::shared_ptr<DFAState> s2 = addState(chain, "A");
+    s0->addTransition('a', s1);
+    s1->addTransition('a', s2);
+    s2->addTransition('a', s2);
+    chain.setStartState(s0);
+
+    chain.minimize();
+    assert(chain.getAllStates().size() == 2);
+    assert(run(chain, "") == "" && run(chain, "a") == "A" && run(chain, "aaaa") == "A");
+
+    std::cout << "不同 token 的接受状态不合并测试通过!" << std::endl;
+}
+
+void testRandomAgainstMoore() {
+    std::cout << "测试随机 DFA 与朴素划分细化的状态数一致..." << std::endl;
+
+    const std::string alphabet = "abc";
+    const std::vector<std::string> inputs = allStrings(alphabet, 6);
+    std::mt19937 random(20240601);
+
+    for (int round = 0; round < 300; ++round) {
+        DFA dfa;
+        std::size_t stateCount = 1 + random() % 12;
+        std::vector<std::shared_ptr<DFAState>> states;
+        for (std::size_t i = 0; i < stateCount; ++i) {
+            int kind = random() % 4;
+            states.push_back(addState(dfa, kind == 0 ? "X" : kind == 1 ? "Y" : ""));
+        }
+        // 部分转移缺失，覆盖隐含死状态的情况
+        for (const std::shared_ptr<DFAState>& state : states) {
+            for (char symbol : alphabet) {
+                if (random() % 5 != 0) {
+                    state->addTransition(symbol, states[random() % stateCount]);
+                }
+            }
+        }
+        dfa.setStartState(states[0]);
+
+        std::size_t expectedCount = mooreStateCount(dfa, alphabet);
+        std::vector<std::string> expected;
+        for (const std::string& input : inputs) {
+            expected.push_back(run(dfa, input));
+        }
+
+        dfa.minimize();
+        assert(dfa.getAllStates().size() == expectedCount);
+        for (std::size_t index = 0; index < inputs.size(); ++index) {
+            assert(run(dfa, inputs[index]) == expected[index]);
+        }
+    }
+
+    std::cout << "随机 DFA 与朴素划分细化的状态数一致测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始 DFA 最小化测试..." << std::endl;
+
+    try {
+        testDragonBookExample();
+        testTokenNamesSeparate();
+        testRandomAgainstMoore();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
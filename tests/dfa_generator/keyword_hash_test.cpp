@@ -0,0 +1,68 @@
+#include "KeywordHash.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+namespace {
+
+    // 把关键字逐行写入临时文件后加载
+    bool loadKeywords(const std::vector<std::string>& keywords) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "keyword_hash_test.txt";
+        {
+            std::ofstream file(path);
+            for (const std::string& keyword : keywords) {
+                file << keyword << "\n";
+            }
+        }
+        KeywordHash hash;
+        bool loaded = hash.loadFromFile(path.string());
+        std::filesystem::remove(path);
+        return loaded;
+    }
+
+    std::vector<std::string> numberedKeywords(std::size_t count) {
+        std::vector<std::string> keywords;
+        for (std::size_t index = 0; index < count; ++index) {
+            keywords.push_back("k" + std::to_string(index));
+        }
+        return keywords;
+    }
+
+} // namespace
+
+void testRejectsUnrepresentableSets() {
+    std::cout << "测试拒绝无法输出的关键字集合..." << std::endl;
+
+    assert(loadKeywords({ "if", "else", "while" }));
+
+    // 大小写不同的关键字得到同一个枚举名 KW_IF
+    assert(!loadKeywords({ "if", "else", "IF" }));
+    assert(!loadKeywords({ "While", "wHILE" }));
+
+    // KeywordId 为 std::uint8_t，0 是 NONE
+    assert(loadKeywords(numberedKeywords(KeywordHash::MAX_KEYWORD_COUNT)));
+    assert(!loadKeywords(numberedKeywords(KeywordHash::MAX_KEYWORD_COUNT + 1)));
+
+    std::cout << "拒绝无法输出的关键字集合测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始关键字哈希测试..." << std::endl;
+
+    try {
+        testRejectsUnrepresentableSets();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "DFA.hpp"
+#include "NFA.hpp"
+#include "RegexEngine.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Compiler;
+
+namespace {
+
+    // 把规则写入临时文件，按生成器的流程为每个模式构建最小化的 DFA 并导出，返回生成的头文件内容
+    std::string generate(const std::string& rules) {
+        std::filesystem::path directory = std::filesystem::temp_directory_path();
+        std::filesystem::path rulesPath = directory / "mode_terminator_test_rules.txt";
+        std::filesystem::path headerPath = directory / "mode_terminator_test_tables.hpp";
+        {
+            std::ofstream file(rulesPath);
+            file << rules;
+        }
+
+        RegexEngine engine;
+        bool loaded = engine.loadRulesFromFile(rulesPath.string());
+        assert(loaded);
+
+        std::shared_ptr<DFA> dfa;
+        LexerModes modes;
+        for (const std::string& mode : engine.getModes()) {
+            std::shared_ptr<DFA> modeDFA = engine.buildCombinedNFA(mode)->toDFA();
+            modeDFA->minimize();
+            if (!dfa) {
+                dfa = modeDFA;
+                modes.initialName = mode;
+            }
+            else {
+                modes.others.push_back({ mode, modeDFA });
+            }
+        }
+        modes.nextModes = engine.getNextModes();
+        modes.skippedTokens = engine.getSkippedTokens();
+        bool exported = dfa->exportToHeaderFile(headerPath.string(), engine.getTokenNames(), "", modes);
+        assert(exported);
+
+        std::ifstream header(headerPath);
+        std::stringstream content;
+        content << header.rdbuf();
+        std::filesystem::remove(rulesPath);
+        std::filesystem::remove(headerPath);
+        return content.str();
+    }
+
+    // 初始模式中 "/*" 进入 comment 模式，comment 模式的规则由 modeRules 给出
+    std::string commentRules(const std::string& modeRules) {
+        return "<identifier>            (a|b|x)+        4\n"
+            "<commentfirst>          /\\*     10      skip BEGIN(comment)\n"
+            "\n"
+            "%mode comment\n" + modeRules;
+    }
+
+    bool hasTerminator(const std::string& header, const std::string& entry) {
+        return header.find(entry + " // comment (proved over ") != std::string::npos;
+    }
+
+    bool lexedWithTables(const std::string& header) {
+        return header.find("{ nullptr, 0, DFA_MODE_KEEP } // comment") != std::string::npos;
+    }
+
+} // namespace
+
+void testCommentTerminator() {
+    std::cout << "测试注释模式的终结符..." << std::endl;
+
+    // 与 input/lex_rules.txt 相同的注释模式：分析 "**/" 这样的输入需要回退，等价性仍然成立
+    std::string header = generate(commentRules(
+        "<commenttext>           ([^*]|\\*+[^*/])+|\\*+     10      skip\n"
+        "<commentend>            \\*+/    10      skip BEGIN(initial)\n"));
+    assert(hasTerminator(header, "{ \"*/\", 2, DFA_MODE_INITIAL }"));
+
+    std::cout << "注释模式的终结符测试通过!" << std::endl;
+}
+
+void testLongCounterexample() {
+    std::cout << "测试只在长输入上不等价的模式..." << std::endl;
+
+    // 20 个 a 也离开模式：只有长度超过 20 的输入能区分两者，穷举短输入无法发现
+    std::string header = generate(commentRules(
+        "<commenttext>           [^*]|\\*     5      skip\n"
+        "<commentend>            \\*/    10      skip BEGIN(initial)\n"
+        "<commentlate>           aaaaaaaaaaaaaaaaaaaa    10      skip BEGIN(initial)\n"));
+    assert(lexedWithTables(header));
+
+    std::cout << "只在长输入上不等价的模式测试通过!" << std::endl;
+}
+
+void testStuckMode() {
+    std::cout << "测试会匹配失败的模式..." << std::endl;
+
+    // 单独的 "*" 后接其他字节时匹配失败，而查找 "*/" 会继续跳过
+    std::string header = generate(commentRules(
+        "<commenttext>           [^*]     5      skip\n"
+        "<commentend>            \\*/    10      skip BEGIN(initial)\n"));
+    assert(lexedWithTables(header));
+
+    std::cout << "会匹配失败的模式测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始模式终结符测试..." << std::endl;
+
+    try {
+        testCommentTerminator();
+        testLongCounterexample();
+        testStuckMode();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
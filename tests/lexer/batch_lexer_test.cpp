@@ -0,0 +1,177 @@
+#include "Lexer.hpp"
+#include "BatchLexer.hpp"
+#include "LexerDiagnostics.hpp"
+#include "TokenStream.hpp"
+#include <iostream>
+#include <cassert>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Compiler;
+
+namespace {
+
+    // 长短不一、有的含错误的一批输入，使各通道在不同的轮次换下一个输入
+    std::vector<std::string> makeInputs() {
+        std::vector<std::string> inputs = {
+            "",
+            "x",
+            "int main() { return 0; }",
+            "a /* comment\n spanning */ b >= 12;",
+            "a /* never closed",
+            "a */ b",
+            "n = 123456789012345678901234567890;",
+            "if (x <= 3) { y = y / 2; } else { z = @ # 1; }",
+        };
+        for (int index = 0; index < 40; ++index) {
+            std::string input;
+            for (int line = 0; line < index * 7; ++line) {
+                input += "v" + std::to_string(line) + " = v" + std::to_string(index) + " + " + std::to_string(line) + ";";
+                input += line % 9 == 0 ? " /* c */\n" : "\n";
+            }
+            inputs.push_back(input);
+        }
+        return inputs;
+    }
+
+    // 用设置了诊断收集器的 Lexer 串行分析一个输入，得到令牌流与诊断
+    void lexSerial(const std::string& input, TokenStream& tokens, LexerDiagnostics& diagnostics) {
+        Lexer lexer(input);
+        lexer.setDiagnostics(&diagnostics);
+        tokens = TokenStream(lexer.getInput());
+        for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+            tokens.push(token.type, token.offset, token.length);
+        }
+    }
+
+    // 不设置诊断收集器时串行分析抛出的第一个错误
+    std::optional<LexerException> serialError(const std::string& input) {
+        try {
+            Lexer(input).tokenizeStream();
+        }
+        catch (const LexerException& ex) {
+            return ex;
+        }
+        return std::nullopt;
+    }
+
+    void assertSameDiagnostics(const LexerDiagnostics& actual, const LexerDiagnostics& expected) {
+        assert(actual.entries().size() == expected.entries().size());
+        for (std::size_t index = 0; index < expected.entries().size(); ++index) {
+            const LexerDiagnostic& left = actual.entries()[index];
+            const LexerDiagnostic& right = expected.entries()[index];
+            assert(left.kind == right.kind);
+            assert(left.offset == right.offset);
+            assert(left.length == right.length);
+            assert(left.mode == right.mode);
+        }
+    }
+
+} // namespace
+
+void testLanesMatchSerial() {
+    std::cout << "测试各通道数的结果与串行分析一致..." << std::endl;
+
+    std::vector<std::string> inputs = makeInputs();
+    std::vector<std::string_view> views(inputs.begin(), inputs.end());
+
+    for (std::size_t laneCount = 1; laneCount <= BatchLexer::MAX_LANE_COUNT; ++laneCount) {
+        BatchLexer batch(views, laneCount);
+        assert(batch.getLaneCount() == laneCount);
+        std::vector<BatchResult> results = batch.tokenizeStreams();
+        assert(results.size() == inputs.size());
+
+        for (std::size_t index = 0; index < inputs.size(); ++index) {
+            TokenStream expected;
+            LexerDiagnostics expectedDiagnostics;
+            lexSerial(inputs[index], expected, expectedDiagnostics);
+            std::optional<LexerException> expectedError = serialError(inputs[index]);
+
+            const TokenStream& tokens = results[index].tokens;
+            assert(tokens.size() == expected.size());
+            for (std::size_t token = 0; token < expected.size(); ++token) {
+                assert(tokens.kind(token) == expected.kind(token));
+                assert(tokens.offset(token) == expected.offset(token));
+                assert(tokens.length(token) == expected.length(token));
+            }
+
+            assertSameDiagnostics(results[index].diagnostics, expectedDiagnostics);
+
+            // 错误只记录偏移，getError 补上的行列号与串行分析抛出的第一个错误相同
+            std::optional<LexerException> error = results[index].getError();
+            assert(error.has_value() == expectedError.has_value());
+            if (error) {
+                assert(std::string(error->what()) == expectedError->what());
+                assert(error->getLine() == expectedError->getLine());
+                assert(error->getColumn() == expectedError->getColumn());
+            }
+        }
+    }
+
+    std::cout << "各通道数的结果与串行分析一致测试通过!" << std::endl;
+}
+
+void testSeveralErrors() {
+    std::cout << "测试一个输入中的多个错误..." << std::endl;
+
+    std::string input = "a @#$ b */ c 99999999999999999999 d\n~ e /* open";
+    std::vector<std::string_view> views = { input, "ok = 1;" };
+    std::vector<BatchResult> results = BatchLexer(views, 2).tokenizeStreams();
+
+    // 出错后继续分析：连续的未知字符合并，孤立的 "*/" 与越界的数字作为 UNKNOWN 令牌
+    const BatchResult& result = results[0];
+    assert(result.tokens.size() == 9);
+    assert(result.tokens.kind(1) == TokenType::UNKNOWN && result.tokens.value(1) == "@#$");
+    assert(result.tokens.kind(3) == TokenType::UNKNOWN && result.tokens.value(3) == "*/");
+    assert(result.tokens.kind(5) == TokenType::UNKNOWN);
+    assert(result.tokens.value(6) == "d");
+    assert(result.tokens.value(8) == "e");
+
+    const std::vector<LexerDiagnostic>& entries = result.diagnostics.entries();
+    assert(entries.size() == 5);
+    assert(entries[0].kind == LexerErrorKind::UNKNOWN_CHARACTERS && entries[0].length == 3);
+    assert(entries[1].kind == LexerErrorKind::ISOLATED_COMMENT_END);
+    assert(entries[2].kind == LexerErrorKind::NUMBER_OUT_OF_RANGE);
+    assert(entries[3].kind == LexerErrorKind::UNKNOWN_CHARACTERS);
+    assert(entries[4].kind == LexerErrorKind::UNTERMINATED_MODE);
+    assert(LexerDiagnostics::message(entries[4], input) == "Unterminated comment");
+
+    // 第一个错误是孤立的注释结束符，未知字符不算在内
+    std::optional<LexerException> error = result.getError();
+    assert(error && std::string(error->what()) == "Isolated comment end '*/' found");
+    assert(error->getLine() == 1 && error->getColumn() == 9);
+
+    assert(results[1].diagnostics.empty() && !results[1].error);
+
+    std::cout << "一个输入中的多个错误测试通过!" << std::endl;
+}
+
+void testLaneCountClamped() {
+    std::cout << "测试通道数截断..." << std::endl;
+
+    std::vector<std::string_view> inputs = { "a", "b" };
+    assert(BatchLexer(inputs, 0).getLaneCount() == 1);
+    assert(BatchLexer(inputs, 100).getLaneCount() == BatchLexer::MAX_LANE_COUNT);
+
+    std::cout << "通道数截断测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始批量词法分析器测试..." << std::endl;
+
+    try {
+        testLanesMatchSerial();
+        testSeveralErrors();
+        testLaneCountClamped();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "Lexer.hpp"
+#include "LexerDiagnostics.hpp"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+void testCoalescedUnknownBytes() {
+    std::cout << "测试连续未知字符合并..." << std::endl;
+
+    std::string input = "a @#$ b ~ c@d";
+    Lexer lexer(input);
+    LexerDiagnostics diagnostics;
+    lexer.setDiagnostics(&diagnostics);
+    std::vector<Token> tokens = lexer.tokenize();
+
+    // "@#$" 合并为一个令牌和一条诊断；空白与可以开始令牌的字节把未知字符分开
+    assert(tokens.size() == 7);
+    assert(tokens[1].type == TokenType::UNKNOWN && lexer.text(tokens[1]) == "@#$");
+    assert(tokens[3].type == TokenType::UNKNOWN && lexer.text(tokens[3]) == "~");
+    assert(tokens[5].type == TokenType::UNKNOWN && lexer.text(tokens[5]) == "@");
+    assert(lexer.text(tokens[6]) == "d");
+    assert(lexer.hasError());
+
+    const std::vector<LexerDiagnostic>& entries = diagnostics.entries();
+    assert(entries.size() == 3);
+    assert(entries[0].kind == LexerErrorKind::UNKNOWN_CHARACTERS);
+    assert(entries[0].offset == 2 && entries[0].length == 3);
+    assert(LexerDiagnostics::message(entries[0], input) == "Unknown characters '@#$'");
+    assert(LexerDiagnostics::message(entries[1], input) == "Unknown character '~'");
+
+    std::cout << "连续未知字符合并测试通过!" << std::endl;
+}
+
+void testErrorsContinue() {
+    std::cout << "测试出错后继续分析..." << std::endl;
+
+    std::string input = "x */ y 99999999999999999999 z\n  /* open";
+    Lexer lexer(input);
+    LexerDiagnostics diagnostics;
+    lexer.setDiagnostics(&diagnostics);
+    std::vector<Token> tokens = lexer.tokenize();
+
+    // 出错的文本作为 UNKNOWN 令牌返回，之后的令牌照常分析
+    assert(tokens.size() == 5);
+    assert(tokens[1].type == TokenType::UNKNOWN && lexer.text(tokens[1]) == "*/");
+    assert(tokens[3].type == TokenType::UNKNOWN);
+    assert(lexer.text(tokens[4]) == "z");
+
+    const std::vector<LexerDiagnostic>& entries = diagnostics.entries();
+    assert(entries.size() == 3);
+    assert(entries[0].kind == LexerErrorKind::ISOLATED_COMMENT_END);
+    assert(entries[1].kind == LexerErrorKind::NUMBER_OUT_OF_RANGE);
+    assert(entries[2].kind == LexerErrorKind::UNTERMINATED_MODE);
+    assert(LexerDiagnostics::message(entries[2], input) == "Unterminated comment");
+
+    // 输出格式与 LexerException::getFullMessage 相同
+    std::ostringstream out;
+    diagnostics.print(out, input, lexer.getLineIndex());
+    assert(out.str().find("LexError (in line:2, in column:5): Unterminated comment\n") != std::string::npos);
+
+    std::cout << "出错后继续分析测试通过!" << std::endl;
+}
+
+void testCapacity() {
+    std::cout << "测试诊断容量..." << std::endl;
+
+    std::string input;
+    for (int index = 0; index < 10; ++index) {
+        input += "@ ";
+    }
+    Lexer lexer(input);
+    LexerDiagnostics diagnostics(4);
+    lexer.setDiagnostics(&diagnostics);
+    lexer.tokenize();
+
+    // 记满后只计数
+    assert(diagnostics.entries().size() == 4);
+    assert(diagnostics.dropped() == 6);
+    assert(diagnostics.total() == 10);
+
+    std::ostringstream out;
+    diagnostics.print(out, input, lexer.getLineIndex());
+    assert(out.str().find("... 6 more lexical errors not shown") != std::string::npos);
+
+    diagnostics.clear();
+    assert(diagnostics.empty());
+
+    std::cout << "诊断容量测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始词法诊断测试..." << std::endl;
+
+    try {
+        testCoalescedUnknownBytes();
+        testErrorsContinue();
+        testCapacity();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "Lexer.hpp"
+#include "IncrementalLexer.hpp"
+#include "TokenStream.hpp"
+#include <iostream>
+#include <cassert>
+#include <optional>
+#include <string>
+
+using namespace Compiler;
+
+namespace {
+
+    // 完整重新分析 text 的结果与增量结果比较：令牌序列、错误及其行列号
+    void assertMatchesFullLex(const IncrementalLexer& incremental, const std::string& text) {
+        Lexer lexer(text);
+        TokenStream expected(lexer.getInput());
+        std::optional<LexerException> expectedError;
+        try {
+            for (Token token = lexer.nextToken(); token.type != TokenType::EOF_TOKEN; token = lexer.nextToken()) {
+                expected.push(token.type, token.offset, token.length);
+            }
+        }
+        catch (const LexerException& ex) {
+            expectedError = ex;
+        }
+
+        assert(incremental.size() == expected.size());
+        for (std::size_t index = 0; index < expected.size(); ++index) {
+            Token token = incremental[index];
+            assert(token.type == expected.kind(index));
+            assert(token.offset == expected.offset(index));
+            assert(token.length == expected.length(index));
+        }
+
+        std::optional<LexerException> error = incremental.getError();
+        assert(error.has_value() == expectedError.has_value());
+        if (error) {
+            assert(std::string(error->what()) == expectedError->what());
+            assert(error->getLine() == expectedError->getLine());
+            assert(error->getColumn() == expectedError->getColumn());
+        }
+    }
+
+    // 把 text 的 [start, start + removed) 替换为 inserted 并通知增量分析器
+    void edit(IncrementalLexer& incremental, std::string& text, std::size_t start, std::size_t removed,
+        const std::string& inserted) {
+        text.replace(start, removed, inserted);
+        incremental.applyEdit(text, start, removed, inserted.size());
+    }
+
+    std::string makeProgram(std::size_t lines) {
+        std::string text;
+        for (std::size_t line = 0; line < lines; ++line) {
+            text += "value" + std::to_string(line) + " = value" + std::to_string(line) + " + 1;\n";
+        }
+        return text;
+    }
+
+} // namespace
+
+void testLocalEdit() {
+    std::cout << "测试局部编辑只重新分析附近的行..." << std::endl;
+
+    std::string text = makeProgram(1000);
+    IncrementalLexer incremental(text);
+    assertMatchesFullLex(incremental, text);
+    assert(incremental.getLineCount() == 1001);
+
+    // 在中间一行内修改标识符：重新分析在下一行行首与旧令牌流重新同步
+    std::size_t start = text.find("value500");
+    edit(incremental, text, start, 8, "renamed");
+    assertMatchesFullLex(incremental, text);
+    assert(incremental.getRelexedBegin() <= start);
+    assert(incremental.getRelexedEnd() - incremental.getRelexedBegin() < 200);
+
+    // 删除整行与插入多行
+    std::size_t line = text.find("value700");
+    edit(incremental, text, line, text.find('\n', line) + 1 - line, "");
+    assertMatchesFullLex(incremental, text);
+    edit(incremental, text, text.find("value100"), 0, "a = 1;\nb = 2;\n");
+    assertMatchesFullLex(incremental, text);
+    assert(incremental.getLineCount() == 1002);
+
+    std::cout << "局部编辑只重新分析附近的行测试通过!" << std::endl;
+}
+
+void testCommentEdits() {
+    std::cout << "测试打开和关闭注释..." << std::endl;
+
+    std::string text = makeProgram(200);
+    IncrementalLexer incremental(text);
+
+    // 打开注释后之后的行首都处于注释模式，未闭合注释报告在 "/*" 之后
+    std::size_t open = text.find("value50 ");
+    edit(incremental, text, open, 0, "/* ");
+    assertMatchesFullLex(incremental, text);
+    assert(incremental.getError().has_value());
+
+    // 关闭注释后恢复为正常令牌
+    std::size_t close = text.find("value120 ");
+    edit(incremental, text, close, 0, "*/ ");
+    assertMatchesFullLex(incremental, text);
+    assert(!incremental.getError().has_value());
+
+    // 在注释内部编辑：从注释中的行首检查点恢复
+    edit(incremental, text, text.find("value80 "), 8, "/ * x");
+    assertMatchesFullLex(incremental, text);
+
+    // 删除注释开始符
+    edit(incremental, text, open, 3, "");
+    assertMatchesFullLex(incremental, text);
+    assert(incremental.getError().has_value());
+
+    std::cout << "打开和关闭注释测试通过!" << std::endl;
+}
+
+void testTokenErrors() {
+    std::cout << "测试令牌错误..." << std::endl;
+
+    std::string text = makeProgram(100);
+    IncrementalLexer incremental(text);
+
+    // 孤立的注释结束符之后的令牌不再产生，错误之前的编辑不影响错误的位置
+    edit(incremental, text, text.find("value60 "), 0, "*/ ");
+    assertMatchesFullLex(incremental, text);
+    edit(incremental, text, text.find("value10 "), 7, "x");
+    assertMatchesFullLex(incremental, text);
+
+    // 修正错误
+    edit(incremental, text, text.find("*/ "), 3, "");
+    assertMatchesFullLex(incremental, text);
+    assert(!incremental.getError().has_value());
+
+    std::cout << "令牌错误测试通过!" << std::endl;
+}
+
+void testGrowFromEmpty() {
+    std::cout << "测试从空文本开始逐字符输入..." << std::endl;
+
+    // 模拟逐字符键入：每次在末尾追加一个字节，令牌在追加过程中反复变长、拆分
+    const std::string typed = "if (a1 >= 10) { b = a1 / 2; }\n/* c */ d = 3;\n";
+    std::string text;
+    IncrementalLexer incremental(text);
+    assert(incremental.size() == 0);
+    for (char c : typed) {
+        edit(incremental, text, text.size(), 0, std::string(1, c));
+        assertMatchesFullLex(incremental, text);
+    }
+
+    // 再从中间逐字符删除
+    while (text.size() > 10) {
+        edit(incremental, text, text.size() / 2, 1, "");
+        assertMatchesFullLex(incremental, text);
+    }
+
+    std::cout << "从空文本开始逐字符输入测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始增量词法分析器测试..." << std::endl;
+
+    try {
+        testLocalEdit();
+        testCommentEdits();
+        testTokenErrors();
+        testGrowFromEmpty();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -14,13 +14,15 @@ void testBasicTokenization() {
 
     std::cout << "找到 " << tokens.size() << " 个令牌:" << std::endl;
     for (const auto& token : tokens) {
-        std::cout << tokenTypeToString(token.type) << ": \"" << token.value
-            << "\" (行:" << token.line << ", 列:" << token.column << ")" << std::endl;
+        SourceLocation location = lexer.getLocation(token.offset);
+        std::cout << tokenTypeToString(token.type) << ": \"" << lexer.text(token)
+            << "\" (行:" << location.line << ", 列:" << location.column << ")" << std::endl;
     }
 
-    // 基本断言
-    assert(!tokens.empty());
-    assert(tokens.back().type == TokenType::EOF_TOKEN);
+    // 基本断言：tokenize 的结果不含 EOF 令牌，之后再取令牌得到 EOF
+    assert(tokens.size() == 9);
+    assert(lexer.text(tokens.back()) == "}");
+    assert(lexer.nextToken().type == TokenType::EOF_TOKEN);
 
     std::cout << "基本令牌化测试通过!" << std::endl;
 }
@@ -35,11 +37,11 @@ void testIdentifiersAndKeywords() {
 
     // 检查第一个token是关键字 "int"
     assert(tokens[0].type == TokenType::KEYWORD);
-    assert(tokens[0].value == "int");
+    assert(lexer.text(tokens[0]) == "int");
 
     // 检查第二个token是标识符 "variable"
     assert(tokens[1].type == TokenType::IDENTIFIER);
-    assert(tokens[1].value == "variable");
+    assert(lexer.text(tokens[1]) == "variable");
 
     std::cout << "标识符和关键字测试通过!" << std::endl;
 }
@@ -47,35 +49,55 @@ void testIdentifiersAndKeywords() {
 void testNumbers() {
     std::cout << "测试数字..." << std::endl;
 
-    std::string input = "123 456.789";
+    std::string input = "123 9876543210";
     Lexer lexer(input);
 
     auto tokens = lexer.tokenize();
 
     assert(tokens[0].type == TokenType::NUMBER);
-    assert(tokens[0].value == "123");
+    assert(lexer.text(tokens[0]) == "123");
+    assert(numberValue(tokens[0], lexer.getInput()) == 123);
 
+    // 超过 32 位的数值不放入令牌，由令牌值转换
     assert(tokens[1].type == TokenType::NUMBER);
-    assert(tokens[1].value == "456.789");
+    assert(lexer.text(tokens[1]) == "9876543210");
+    assert(numberValue(tokens[1], lexer.getInput()) == 9876543210);
 
     std::cout << "数字测试通过!" << std::endl;
 }
 
-void testStrings() {
-    std::cout << "测试字符串..." << std::endl;
+void testComments() {
+    std::cout << "测试注释..." << std::endl;
 
-    std::string input = "\"hello world\" 'c'";
+    std::string input = "a /* x * y\n ** */ b/**/c";
     Lexer lexer(input);
 
     auto tokens = lexer.tokenize();
 
-    assert(tokens[0].type == TokenType::STRING);
-    assert(tokens[0].value == "hello world");
+    // 注释被跳过，令牌偏移仍是在整个输入中的偏移
+    assert(tokens.size() == 3);
+    assert(lexer.text(tokens[1]) == "b");
+    assert(tokens[1].offset == input.find('b'));
+    assert(lexer.text(tokens[2]) == "c");
 
-    assert(tokens[1].type == TokenType::STRING);
-    assert(tokens[1].value == "c");
+    std::cout << "注释测试通过!" << std::endl;
+}
+
+void testPeekThenTokenize() {
+    std::cout << "测试向前查看后令牌化..." << std::endl;
+
+    std::string input = "a b c";
+    Lexer lexer(input);
+
+    // 向前查看的令牌已在缓冲区中，输入位置已到结尾，tokenize 仍应返回它们
+    assert(lexer.text(lexer.peek(2)) == "c");
+    auto tokens = lexer.tokenize();
+
+    assert(tokens.size() == 3);
+    assert(lexer.text(tokens[0]) == "a");
+    assert(lexer.text(tokens[2]) == "c");
 
-    std::cout << "字符串测试通过!" << std::endl;
+    std::cout << "向前查看后令牌化测试通过!" << std::endl;
 }
 
 int main() {
@@ -85,7 +107,8 @@ int main() {
         testBasicTokenization();
         testIdentifiersAndKeywords();
         testNumbers();
-        testStrings();
+        testComments();
+        testPeekThenTokenize();
 
         std::cout << "所有测试通过!" << std::endl;
     }
@@ -0,0 +1,110 @@
+#include "Lexer.hpp"
+#include "NumberParser.hpp"
+#include <iostream>
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+namespace {
+
+    // 与 std::from_chars 比较：二者都接受时数值相同，都拒绝时 value 保持不变
+    void assertMatchesFromChars(const std::string& digits) {
+        std::int64_t expected = 0;
+        auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), expected);
+        bool expectedOk = error == std::errc() && end == digits.data() + digits.size();
+
+        std::int64_t value = -1;
+        bool ok = parseDecimal(digits, value);
+        assert(ok == expectedOk);
+        assert(ok ? value == expected : value == -1);
+    }
+
+} // namespace
+
+void testBounds() {
+    std::cout << "测试 INT64_MAX 附近的边界..." << std::endl;
+
+    std::vector<std::string> cases = {
+        "0", "7", "00000000", "12345678", "123456789",
+        "4294967295", "4294967296",
+        "999999999999999999", "1000000000000000000",
+        "9223372036854775806", "9223372036854775807", "9223372036854775808",
+        "9999999999999999999", "18446744073709551615", "18446744073709551616",
+        "99999999999999999999999",
+        // 前导零不计入有效数字
+        "0000000000000000000009223372036854775807", "0000000000000000000009223372036854775808",
+    };
+    for (const std::string& digits : cases) {
+        assertMatchesFromChars(digits);
+    }
+
+    std::int64_t value = 0;
+    assert(parseDecimal("9223372036854775807", value) && value == INT64_MAX);
+    assert(!parseDecimal("9223372036854775808", value) && value == INT64_MAX);
+
+    std::cout << "INT64_MAX 附近的边界测试通过!" << std::endl;
+}
+
+void testEveryLength() {
+    std::cout << "测试各种长度..." << std::endl;
+
+    // 覆盖 8 位一组的合并与剩余的逐位处理的各种组合
+    for (std::size_t length = 1; length <= 24; ++length) {
+        for (char digit = '0'; digit <= '9'; ++digit) {
+            std::string digits(length, digit);
+            assertMatchesFromChars(digits);
+            digits.front() = '1';
+            assertMatchesFromChars(digits);
+        }
+    }
+
+    std::cout << "各种长度测试通过!" << std::endl;
+}
+
+void testLexerNumbers() {
+    std::cout << "测试词法分析器的数字令牌..." << std::endl;
+
+    std::string input = "4294967295 4294967296 9223372036854775807";
+    Lexer lexer(input);
+    std::vector<Token> tokens = lexer.tokenize();
+    assert(tokens.size() == 3);
+
+    // 不超过 32 位的数值放入令牌，更大的从令牌值转换
+    assert(tokens[0].hasPayload && numberValue(tokens[0], input) == 4294967295LL);
+    assert(!tokens[1].hasPayload && numberValue(tokens[1], input) == 4294967296LL);
+    assert(numberValue(tokens[2], input) == INT64_MAX);
+
+    // 超出范围是词法错误
+    bool threw = false;
+    try {
+        Lexer("9223372036854775808").tokenize();
+    }
+    catch (const LexerException& ex) {
+        threw = std::string(ex.what()) == "Number literal out of range";
+    }
+    assert(threw);
+
+    std::cout << "词法分析器的数字令牌测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始数字转换测试..." << std::endl;
+
+    try {
+        testBounds();
+        testEveryLength();
+        testLexerNumbers();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "Lexer.hpp"
+#include "ParallelLexer.hpp"
+#include "TokenStream.hpp"
+#include <iostream>
+#include <cassert>
+#include <optional>
+#include <string>
+
+using namespace Compiler;
+
+namespace {
+
+    // 足够切成多块的输入：普通代码行之间夹着跨越多行的长注释，使若干切分点落在注释中间
+    std::string makeInput(std::size_t lines) {
+        std::string input;
+        for (std::size_t line = 0; line < lines; ++line) {
+            input += "int x" + std::to_string(line) + " = " + std::to_string(line * 7) + ";\n";
+            if (line % 5000 == 0) {
+                input += "/* long comment";
+                for (int inner = 0; inner < 20000; ++inner) {
+                    input += " * text / more\n";
+                }
+                input += "*/\n";
+            }
+        }
+        return input;
+    }
+
+    void assertSameStream(const TokenStream& actual, const TokenStream& expected) {
+        assert(actual.size() == expected.size());
+        for (std::size_t index = 0; index < expected.size(); ++index) {
+            assert(actual.kind(index) == expected.kind(index));
+            assert(actual.offset(index) == expected.offset(index));
+            assert(actual.length(index) == expected.length(index));
+        }
+    }
+
+    // 逐个比较令牌，包括负载（符号编号与数值）
+    void assertSameTokens(const std::vector<Token>& actual, const std::vector<Token>& expected) {
+        assert(actual.size() == expected.size());
+        for (std::size_t index = 0; index < expected.size(); ++index) {
+            assert(actual[index].type == expected[index].type);
+            assert(actual[index].offset == expected[index].offset);
+            assert(actual[index].length == expected[index].length);
+            assert(actual[index].hasPayload == expected[index].hasPayload);
+            assert(actual[index].payload == expected[index].payload);
+        }
+    }
+
+    // 串行分析抛出的异常，没有错误时为空
+    std::optional<LexerException> serialError(const std::string& input) {
+        try {
+            Lexer(input).tokenizeStream();
+        }
+        catch (const LexerException& ex) {
+            return ex;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<LexerException> parallelError(const std::string& input) {
+        try {
+            ParallelLexer(input, 4).tokenizeStream();
+        }
+        catch (const LexerException& ex) {
+            return ex;
+        }
+        return std::nullopt;
+    }
+
+} // namespace
+
+void testChunksInsideComments() {
+    std::cout << "测试切分点位于注释中..." << std::endl;
+
+    // 当前规则中只有注释模式可以跨行（没有字符串字面量），切分点落在注释中时按注释模式的推测结果拼接
+    std::string input = makeInput(40000);
+    Lexer lexer(input);
+    TokenStream expected = lexer.tokenizeStream();
+
+    ParallelLexer parallel(input, 4);
+    TokenStream tokens = parallel.tokenizeStream();
+    assert(parallel.getChunkCount() > 1);
+    assertSameStream(tokens, expected);
+
+    std::cout << "切分点位于注释中测试通过!" << std::endl;
+}
+
+void testSingleThread() {
+    std::cout << "测试单线程不切分..." << std::endl;
+
+    std::string input = makeInput(10000);
+    ParallelLexer parallel(input, 1);
+    TokenStream tokens = parallel.tokenizeStream();
+    assert(parallel.getChunkCount() == 1);
+    assertSameStream(tokens, Lexer(input).tokenizeStream());
+
+    std::cout << "单线程不切分测试通过!" << std::endl;
+}
+
+void testTokenizePayloads() {
+    std::cout << "测试令牌负载与串行分析一致..." << std::endl;
+
+    // 数字中既有放得进 32 位的，也有需要从文本转换的
+    std::string input = makeInput(20000) + "y = 4294967295 + 4294967296 + x3;\n";
+    Lexer lexer(input);
+    std::vector<Token> expected = lexer.tokenize();
+
+    ParallelLexer parallel(input, 4);
+    std::vector<Token> tokens = parallel.tokenize();
+    assert(parallel.getChunkCount() > 1);
+    assertSameTokens(tokens, expected);
+    assert(parallel.getSymbols()->size() == lexer.getSymbols()->size());
+
+    std::cout << "令牌负载与串行分析一致测试通过!" << std::endl;
+}
+
+void testErrorsMatchSerial() {
+    std::cout << "测试错误与串行分析一致..." << std::endl;
+
+    // 结尾的未闭合注释从前面的某一块开始
+    std::string unterminated = makeInput(20000) + "a /* never closed\n" + std::string(200000, 'x') + "\n";
+    std::optional<LexerException> expected = serialError(unterminated);
+    std::optional<LexerException> actual = parallelError(unterminated);
+    assert(expected && actual);
+    assert(std::string(actual->what()) == expected->what());
+    assert(actual->getOffset() == expected->getOffset());
+    assert(actual->getLine() == expected->getLine());
+    assert(actual->getColumn() == expected->getColumn());
+
+    // 后面某一块中孤立的注释结束符
+    std::string isolated = makeInput(20000) + "b */ c\n" + makeInput(2000);
+    expected = serialError(isolated);
+    actual = parallelError(isolated);
+    assert(expected && actual);
+    assert(std::string(actual->what()) == "Isolated comment end '*/' found");
+    assert(actual->getLine() == expected->getLine());
+    assert(actual->getColumn() == expected->getColumn());
+
+    std::cout << "错误与串行分析一致测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始并行词法分析器测试..." << std::endl;
+
+    try {
+        testChunksInsideComments();
+        testSingleThread();
+        testTokenizePayloads();
+        testErrorsMatchSerial();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
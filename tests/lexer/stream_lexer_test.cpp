@@ -0,0 +1,117 @@
+#include "Lexer.hpp"
+#include "StreamLexer.hpp"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+namespace {
+
+    const std::string PROGRAM =
+        "int main() {\n"
+        "    /* a comment ** spanning\n"
+        "       two lines */ int counter = 12345;\n"
+        "    while (counter >= 10) { counter = counter - 1; }\n"
+        "    identifier_that_is_much_longer_than_the_buffer_itself = 98765432109;\n"
+        "}\n";
+
+    // 与 Lexer 逐个比较令牌（类型、偏移、长度与令牌值）
+    void assertSameTokens(const std::string& input, std::size_t bufferSize) {
+        Lexer lexer(input);
+        std::istringstream stream(input);
+        StreamLexer streaming(stream, bufferSize);
+        while (true) {
+            Token expected = lexer.nextToken();
+            Token actual = streaming.nextToken();
+            assert(actual.type == expected.type);
+            assert(actual.offset == expected.offset);
+            assert(actual.length == expected.length);
+            if (expected.type == TokenType::EOF_TOKEN) {
+                break;
+            }
+            assert(streaming.text(actual) == lexer.text(expected));
+        }
+    }
+
+} // namespace
+
+void testSmallBuffers() {
+    std::cout << "测试小缓冲区..." << std::endl;
+
+    // 缓冲区小于令牌与注释结束符时，令牌和 "*/" 都会跨越填充边界
+    for (std::size_t bufferSize : { 1, 2, 3, 7, 16, 64, 4096 }) {
+        assertSameTokens(PROGRAM, bufferSize);
+    }
+
+    std::cout << "小缓冲区测试通过!" << std::endl;
+}
+
+void testLongCommentKeepsBufferSmall() {
+    std::cout << "测试长注释不扩大缓冲区..." << std::endl;
+
+    std::string input = "a /*" + std::string(100000, '*') + " text */ b";
+    std::istringstream stream(input);
+    StreamLexer streaming(stream, 16);
+    Token first = streaming.nextToken();
+    assert(streaming.text(first) == "a");
+    Token second = streaming.nextToken();
+    assert(streaming.text(second) == "b");
+    assert(second.offset == input.size() - 1);
+    assert(streaming.nextToken().type == TokenType::EOF_TOKEN);
+
+    // 跳过注释时只保留终结符长度减一个字节，缓冲区不随注释增长
+    assert(streaming.getBufferCapacity() == 16);
+
+    std::cout << "长注释不扩大缓冲区测试通过!" << std::endl;
+}
+
+void testUnterminatedComment() {
+    std::cout << "测试未闭合注释..." << std::endl;
+
+    // 进入注释的位置早已移出缓冲区，行列号仍与 Lexer 相同
+    std::string input = "x\n  y /* open\n" + std::string(1000, 'z') + "\n";
+    SourceLocation expected{ 0, 0 };
+    try {
+        Lexer(input).tokenize();
+        assert(false);
+    }
+    catch (const LexerException& ex) {
+        expected = SourceLocation{ ex.getLine(), ex.getColumn() };
+    }
+
+    std::istringstream stream(input);
+    StreamLexer streaming(stream, 8);
+    try {
+        while (streaming.nextToken().type != TokenType::EOF_TOKEN) {
+        }
+        assert(false);
+    }
+    catch (const LexerException& ex) {
+        assert(std::string(ex.what()) == "Unterminated comment");
+        assert(ex.getLine() == expected.line && ex.getColumn() == expected.column);
+        assert(ex.getLine() == 2 && ex.getColumn() == 7);
+    }
+
+    std::cout << "未闭合注释测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始流式词法分析器测试..." << std::endl;
+
+    try {
+        testSmallBuffers();
+        testLongCommentKeepsBufferSmall();
+        testUnterminatedComment();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
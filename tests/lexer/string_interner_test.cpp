@@ -0,0 +1,89 @@
+#include "Lexer.hpp"
+#include "StringInterner.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+void testSameIdForEqualStrings() {
+    std::cout << "测试相同字符串得到相同编号..." << std::endl;
+
+    StringInterner interner;
+    SymbolId first = interner.intern("counter");
+
+    // 内容相同、存放位置不同的字符串
+    std::string copy = "counter";
+    assert(interner.intern(copy) == first);
+    assert(interner.find("counter") == first);
+    assert(interner.name(first) == "counter");
+    assert(interner.name(first).data() != copy.data());
+
+    SymbolId other = interner.intern("count");
+    assert(other != first);
+    assert(interner.size() == 2);
+    assert(interner.find("missing") == NO_SYMBOL);
+
+    std::cout << "相同字符串得到相同编号测试通过!" << std::endl;
+}
+
+void testGrowthKeepsIds() {
+    std::cout << "测试扩容后编号与名称不变..." << std::endl;
+
+    // 超过初始槽数和内存池的一块，触发哈希表扩容与新的内存块
+    StringInterner interner;
+    std::vector<SymbolId> ids;
+    std::size_t count = StringInterner::INITIAL_CAPACITY * 40;
+    for (std::size_t index = 0; index < count; ++index) {
+        ids.push_back(interner.intern("name_" + std::to_string(index)));
+    }
+    interner.intern(std::string(StringInterner::ARENA_BLOCK_SIZE + 1, 'x'));
+
+    for (std::size_t index = 0; index < count; ++index) {
+        std::string name = "name_" + std::to_string(index);
+        assert(ids[index] == index);
+        assert(interner.intern(name) == ids[index]);
+        assert(interner.name(ids[index]) == name);
+    }
+    assert(interner.size() == count + 1);
+
+    std::cout << "扩容后编号与名称不变测试通过!" << std::endl;
+}
+
+void testLexerSymbols() {
+    std::cout << "测试词法分析器驻留标识符..." << std::endl;
+
+    std::string input = "alpha beta alpha if 42";
+    Lexer lexer(input);
+    std::vector<Token> tokens = lexer.tokenize();
+
+    // 同名标识符共享编号；关键字和数字不驻留
+    assert(tokens[0].symbol() != NO_SYMBOL);
+    assert(tokens[0].symbol() == tokens[2].symbol());
+    assert(tokens[0].symbol() != tokens[1].symbol());
+    assert(lexer.getSymbols()->name(tokens[1].symbol()) == "beta");
+    assert(tokens[3].type == TokenType::KEYWORD && tokens[3].symbol() == NO_SYMBOL);
+    assert(tokens[4].type == TokenType::NUMBER && tokens[4].symbol() == NO_SYMBOL);
+    assert(lexer.getSymbols()->size() == 2);
+
+    std::cout << "词法分析器驻留标识符测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始字符串驻留表测试..." << std::endl;
+
+    try {
+        testSameIdForEqualStrings();
+        testGrowthKeepsIds();
+        testLexerSymbols();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "Lexer.hpp"
+#include "TokenStream.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace Compiler;
+
+void testPushAndAccess() {
+    std::cout << "测试令牌流的追加与访问..." << std::endl;
+
+    std::string input = "ab 12 +";
+    TokenStream tokens(input);
+    tokens.push(TokenType::IDENTIFIER, 0, 2);
+    tokens.push(TokenType::NUMBER, 3, 2);
+    tokens.push(TokenType::SINGLEWORD, 6, 1);
+
+    assert(tokens.size() == 3);
+    assert(!tokens.empty());
+    assert(tokens.kind(1) == TokenType::NUMBER);
+    assert(tokens.offset(1) == 3);
+    assert(tokens.length(1) == 2);
+    assert(tokens.value(0) == "ab");
+    assert(tokens.value(2) == "+");
+
+    // 按值构造的令牌没有 payload
+    Token token = tokens[1];
+    assert(token.type == TokenType::NUMBER && token.offset == 3 && token.length == 2);
+    assert(!token.hasPayload);
+
+    // 迭代器依次给出同样的令牌
+    std::size_t index = 0;
+    for (Token each : tokens) {
+        assert(each.type == tokens.kind(index));
+        assert(each.offset == tokens.offset(index));
+        ++index;
+    }
+    assert(index == tokens.size());
+
+    std::cout << "令牌流的追加与访问测试通过!" << std::endl;
+}
+
+void testAppend() {
+    std::cout << "测试令牌流的拼接..." << std::endl;
+
+    std::string input = "a b c";
+    TokenStream first(input);
+    first.push(TokenType::IDENTIFIER, 0, 1);
+    TokenStream second(input);
+    second.push(TokenType::IDENTIFIER, 2, 1);
+    second.push(TokenType::IDENTIFIER, 4, 1);
+
+    first.append(second);
+    assert(first.size() == 3);
+    assert(first.value(1) == "b");
+    assert(first.value(2) == "c");
+
+    std::cout << "令牌流的拼接测试通过!" << std::endl;
+}
+
+void testMatchesTokenize() {
+    std::cout << "测试令牌流与 tokenize 一致..." << std::endl;
+
+    std::string input = "int main() {\n  /* comment */ return x1 >= 42;\n}\n";
+    Lexer vectorLexer(input);
+    std::vector<Token> expected = vectorLexer.tokenize();
+
+    Lexer streamLexer(input);
+    TokenStream tokens = streamLexer.tokenizeStream();
+    assert(tokens.input() == streamLexer.getInput());
+    assert(tokens.size() == expected.size());
+    for (std::size_t index = 0; index < expected.size(); ++index) {
+        assert(tokens.kind(index) == expected[index].type);
+        assert(tokens.offset(index) == expected[index].offset);
+        assert(tokens.length(index) == expected[index].length);
+    }
+
+    std::vector<Token> converted = tokens.toVector();
+    assert(converted.size() == expected.size());
+    assert(converted.back().offset == expected.back().offset);
+
+    // 三个数组：每个令牌一个字节的种类、一个偏移和一个长度
+    assert(tokens.memoryBytes() >= tokens.size() * (1 + sizeof(TokenOffset) + sizeof(std::uint32_t)));
+
+    std::cout << "令牌流与 tokenize 一致测试通过!" << std::endl;
+}
+
+int main() {
+    std::cout << "开始令牌流测试..." << std::endl;
+
+    try {
+        testPushAndAccess();
+        testAppend();
+        testMatchesTokenize();
+
+        std::cout << "所有测试通过!" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}